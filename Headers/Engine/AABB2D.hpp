@@ -0,0 +1,95 @@
+/*========================================================================
+An axis aligned box in 2D space, stored as its min and max corners. It is
+the bounds type used by the scene index and the culling code, and is kept
+as plain data so that it can be copied and packed into arrays cheaply.
+
+FromCenter builds the box the same way a Sprite is placed, from a center
+position and a full width and height.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef AABB2D_HPP
+#define AABB2D_HPP
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+
+namespace KillerEngine
+{
+	struct AABB2D
+	{
+		F32 minX;
+		F32 minY;
+		F32 maxX;
+		F32 maxY;
+
+		AABB2D(void) : minX(0.0f), minY(0.0f), maxX(0.0f), maxY(0.0f) {  }
+
+		AABB2D(F32 left, F32 bottom, F32 right, F32 top) : minX(left), minY(bottom), maxX(right), maxY(top) {  }
+
+		static AABB2D FromCenter(F32 x, F32 y, F32 w, F32 h)
+		{
+			return AABB2D(x - w / 2, y - h / 2, x + w / 2, y + h / 2);
+		}
+
+		F32 GetWidth(void) const { return maxX - minX; }
+
+		F32 GetHeight(void) const { return maxY - minY; }
+
+		F32 GetCenterX(void) const { return (minX + maxX) / 2; }
+
+		F32 GetCenterY(void) const { return (minY + maxY) / 2; }
+
+		bool Contains(F32 x, F32 y) const
+		{
+			return x >= minX && x <= maxX && y >= minY && y <= maxY;
+		}
+
+		bool Contains(const AABB2D& other) const
+		{
+			return other.minX >= minX && other.maxX <= maxX && other.minY >= minY && other.maxY <= maxY;
+		}
+
+		bool Overlaps(const AABB2D& other) const
+		{
+			return minX <= other.maxX && maxX >= other.minX && minY <= other.maxY && maxY >= other.minY;
+		}
+
+		//=====Squared distance from a point to the closest point in the box, 0 if inside=====
+		F32 SqrDistance(F32 x, F32 y) const
+		{
+			F32 dx = x < minX ? minX - x : (x > maxX ? x - maxX : 0.0f);
+			F32 dy = y < minY ? minY - y : (y > maxY ? y - maxY : 0.0f);
+
+			return dx * dx + dy * dy;
+		}
+
+		//=====Slab test. invX and invY are 1 / direction. Returns the entry distance in hit=====
+		bool RayHit(F32 originX, F32 originY, F32 invX, F32 invY, F32 maxDistance, F32& hit) const
+		{
+			F32 t1 = (minX - originX) * invX;
+			F32 t2 = (maxX - originX) * invX;
+			F32 t3 = (minY - originY) * invY;
+			F32 t4 = (maxY - originY) * invY;
+
+			F32 tMin = t1 < t2 ? t1 : t2;
+			F32 tMax = t1 < t2 ? t2 : t1;
+			F32 tyMin = t3 < t4 ? t3 : t4;
+			F32 tyMax = t3 < t4 ? t4 : t3;
+
+			if(tyMin > tMin) { tMin = tyMin; }
+			if(tyMax < tMax) { tMax = tyMax; }
+			if(tMin < 0.0f) { tMin = 0.0f; }
+
+			if(tMax < tMin || tMin > maxDistance) { return false; }
+
+			hit = tMin;
+			return true;
+		}
+	};
+}//End namespace
+
+#endif
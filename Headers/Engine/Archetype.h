@@ -0,0 +1,112 @@
+/*========================================================================
+An Archetype holds every entity that has exactly the same set of
+components. The entities are stored in fixed size chunks of memory. Inside
+of a chunk each component type has its own packed array, and the entity
+handles have one more, so a system that only needs two components walks
+two arrays from start to end and never touches the rest.
+
+A chunk holds as many rows as fit in CHUNK_BYTES. A row that is bigger
+than that gets a chunk of its own, made as big as the row needs.
+
+Only the last chunk is ever partly full. Removing a row moves the very
+last row of the archetype into the hole, and hands back the Entity that
+was moved so the EntityManager can update where it lives.
+
+Archetypes are created and owned by the EntityManager. Nothing here should
+be called while a system is walking the chunks.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef ARCHETYPE_H
+#define ARCHETYPE_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/Component.h>
+
+//=====STL includes=====
+#include <vector>
+
+namespace KillerEngine
+{
+	class Archetype
+	{
+	public:
+		static const U32 CHUNK_BYTES = 16 * 1024;
+
+		static const U32 NO_OFFSET = 0xFFFFFFFF;
+
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+		explicit Archetype(ComponentMask mask);
+
+		~Archetype(void);
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+		ComponentMask GetMask(void) const { return _mask; }
+
+		bool Matches(ComponentMask required) const { return (_mask & required) == required; }
+
+		bool Has(U32 componentID) const { return componentID < MAX_COMPONENT_TYPES && _offsets[componentID] != NO_OFFSET; }
+
+		U32 GetChunkCount(void) const { return (U32)_chunks.size(); }
+
+		U32 GetChunkCapacity(void) const { return _chunkCapacity; }
+
+		U32 GetChunkBytes(void) const { return _chunkBytes; }
+
+		U32 GetRowCount(U32 chunk) const { return _chunkCounts[chunk]; }
+
+		U32 GetEntityCount(void) const;
+
+		Entity* GetEntities(U32 chunk) { return reinterpret_cast<Entity*>(_chunks[chunk]); }
+
+		void* GetComponentArray(U32 chunk, U32 componentID)
+		{
+			return !Has(componentID) ? NULL : _chunks[chunk] + _offsets[componentID];
+		}
+
+		void* GetComponent(U32 chunk, U32 row, U32 componentID)
+		{
+			U8* base = static_cast<U8*>(GetComponentArray(chunk, componentID));
+			return base == NULL ? NULL : base + row * ComponentRegistry::Instance()->GetInfo(componentID).size;
+		}
+
+//==========================================================================================================================
+//
+//Archetype Functions
+//
+//==========================================================================================================================
+		void AddRow(Entity entity, U32& chunk, U32& row);
+
+		void AddRowFrom(Entity entity, Archetype& source, U32 sourceChunk, U32 sourceRow, U32& chunk, U32& row);
+
+		Entity RemoveRow(U32 chunk, U32 row);
+
+	private:
+		ComponentMask 	  _mask;
+		std::vector<U32>  _componentIDs;
+		U32 			  _offsets[MAX_COMPONENT_TYPES];
+		U32 			  _chunkCapacity;
+		U32 			  _chunkBytes;
+		std::vector<U8*>  _chunks;
+		std::vector<U32>  _chunkCounts;
+
+		void _ReserveRow(Entity entity, U32& chunk, U32& row);
+
+		Archetype(const Archetype&);
+		Archetype& operator=(const Archetype&);
+	};
+}//End namespace
+
+#endif
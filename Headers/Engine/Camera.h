@@ -3,6 +3,9 @@ This class will control the view port in OpenGL, and will allow for the use
 of the camera. It will controll the background color of a leve, and it will
 have the ability to move, and will set the projection type. 
 
+GetViewRect returns the part of the world the camera can see, which is
+what the Map culls against.
+
 For now, I will build it out to be a singleton. I can see that there are 
 issues with this design that will need to be looked into, but it will make
 things easier to program for now. This will be awesome
@@ -18,6 +21,8 @@ Written by Maxwell Miller
 //=====Killer includes=====
 #include <Engine/Atom.h>
 #include <Engine/WinProgram.h>
+#include <Engine/GLStateCache.h>
+#include <Engine/AABB2D.hpp>
 
 //=====OGL includes=====
 //=====OGL includes=====
@@ -43,18 +48,36 @@ namespace KillerEngine
 		{ 
 			_pos.AddScaledVector(pos, scale);
 			_translation.SetTranslation(pos); 
+			_offset = pos;
+			++_version;
 		}
 
 		void SetPosition(F32 x, F32 y, F32 scale) 
 		{ 
 			_pos.AddScaledVector(Vec2(x, y), scale);
 			_translation.SetTranslation(_pos); 
+			_offset = _pos;
+			++_version;
 		}
 
 		void SetColor(Col& col) { _background = col; }
 
+		//=====Only uploads the matrices to a shader that has not seen this version of them=====
 		void SetUp(GLuint shader);
 
+		//=====The same, with a translation saved from an earlier frame, see RenderThread=====
+		void SetUp(GLuint shader, const Matrix& translation, U32 version);
+
+		const Matrix& GetTranslation(void) const { return _translation; }
+
+		U32 GetVersion(void) const { return _version; }
+
+		//=====The projection covers 0 to the view size, and the world is moved by the translation=====
+		AABB2D GetViewRect(void) const
+		{
+			return AABB2D(-_offset.GetX(), -_offset.GetY(), _viewWidth - _offset.GetX(), _viewHeight - _offset.GetY());
+		}
+
 		//Will be implemented later
 		//void SetProjectionPerspective(void) { }
 	
@@ -69,6 +92,10 @@ namespace KillerEngine
 		Vec2   _pos;
 		Matrix _projection;
 		Matrix _translation;
+		Vec2   _offset;
+		F32    _viewWidth;
+		F32    _viewHeight;
+		U32    _version;
 
 	protected:
 //==========================================================================================================================
@@ -48,6 +48,7 @@ Written by Maxwell Miller
 //=====Killer1 Includes=====
 #include <Engine/Atom.h>
 #include <Engine/Sprite.h>
+#include <Engine/ShaderRegistry.h>
 #include <Engine/Texture.hpp>
 #include <Engine/TextureManager.h>
 #include <Engine/Font.h>
@@ -124,6 +125,12 @@ namespace KillerEngine
 
 		void v_InitShader(void);
 
+		//=====Starts the program for the current sprite path building, without waiting for it=====
+		static void RequestShaders(void);
+
+		//=====The program for the current sprite path, what v_GetShader returns=====
+		static GLuint GetProgram(void);
+
 
 	private:
 		U32 				_charID;
@@ -135,9 +142,14 @@ namespace KillerEngine
 		U32 				_yoffset;
 		U32 				_xadvance;
 		static GLuint 		 _shaderProgram;
+		static GLuint 		 _instancedProgram;
 		static const GLchar* _vertexShaderSource[];
 		static const GLchar* _geometryShaderSource[];
 		static const GLchar* _fragmentShaderSource[];
+		static const GLchar* _instancedVertexSource[];
+		static const GLchar* _instancedFragmentSource[];
+
+		static void _InitInstancedShader(void);
 	};
 }
 
@@ -0,0 +1,141 @@
+/*========================================================================
+Components are the plain data that the EntityManager stores for each
+entity. Any copyable type can be a component. The first time a type is
+used with ComponentID<T>() it is given a number, and a ComponentInfo is
+registered that knows its size, and how to construct, move and destroy it
+in raw memory. That is what lets an Archetype keep every component type in
+its own packed array without knowing the types at compile time.
+
+There is room for 64 component types, since a ComponentMask is a single
+U64 with one bit per type. A type past that is given INVALID_COMPONENT,
+its ComponentBit is 0, and the EntityManager will not add, get or remove
+it.
+
+The components that every 2D entity is likely to want are defined here,
+along with GameObject2DComponent which is used to host an existing
+GameObject2D inside of the EntityManager.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef COMPONENT_H
+#define COMPONENT_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/ErrorManager.h>
+#include <Engine/SlotMap.hpp>
+
+//=====STL includes=====
+#include <vector>
+#include <new>
+
+namespace KillerEngine
+{
+	//=====Forward declarations=====
+	class GameObject2D;
+
+	typedef U64 ComponentMask;
+
+	typedef SlotHandle Entity;
+
+	static const U32 MAX_COMPONENT_TYPES = 64;
+
+	static const U32 INVALID_COMPONENT = 0xFFFFFFFF;
+
+	struct ComponentInfo
+	{
+		U32  size;
+		U32  alignment;
+		void (*construct)(void* dest);
+		void (*moveConstruct)(void* dest, void* src);
+		void (*destroy)(void* dest);
+	};
+
+	class ComponentRegistry
+	{
+	public:
+		static ComponentRegistry* Instance(void);
+
+		U32 Register(const ComponentInfo& info);
+
+		const ComponentInfo& GetInfo(U32 id) const { return _infos[id]; }
+
+		U32 GetCount(void) const { return (U32)_infos.size(); }
+
+	protected:
+		ComponentRegistry(void) : _infos() {  }
+
+	private:
+		static ComponentRegistry*  _instance;
+		std::vector<ComponentInfo> _infos;
+	};
+
+//==========================================================================================================================
+//
+//Component Type Helpers
+//
+//==========================================================================================================================
+	template<typename T>
+	struct ComponentFunctions
+	{
+		static void Construct(void* dest) { new(dest) T(); }
+
+		static void MoveConstruct(void* dest, void* src) { new(dest) T(*static_cast<T*>(src)); }
+
+		static void Destroy(void* dest) { static_cast<T*>(dest)->~T(); }
+	};
+
+	template<typename T>
+	U32 ComponentID(void)
+	{
+		static const U32 id = ComponentRegistry::Instance()->Register(ComponentInfo
+		{
+			(U32)sizeof(T),
+			(U32)alignof(T),
+			&ComponentFunctions<T>::Construct,
+			&ComponentFunctions<T>::MoveConstruct,
+			&ComponentFunctions<T>::Destroy
+		});
+
+		return id;
+	}
+
+	template<typename T>
+	ComponentMask ComponentBit(void)
+	{
+		U32 id = ComponentID<T>();
+		return id == INVALID_COMPONENT ? 0 : ComponentMask(1) << id;
+	}
+
+//==========================================================================================================================
+//
+//Built in Components
+//
+//==========================================================================================================================
+	struct Position2D
+	{
+		Vec2 value;
+	};
+
+	struct Velocity2D
+	{
+		Vec2 value;
+	};
+
+	struct Acceleration2D
+	{
+		Vec2 value;
+	};
+
+	struct GameObject2DComponent
+	{
+		GameObject2D* object;
+
+		GameObject2DComponent(void) : object(NULL) {  }
+	};
+}//End namespace
+
+#endif
@@ -0,0 +1,148 @@
+/*========================================================================
+The EntityManager is the home of every entity and component in a Map. An
+entity is only a handle. Its components live in the Archetype that matches
+its set of component types, packed into chunks with every other entity
+that has the same set.
+
+Adding or removing a component moves the entity into a different
+archetype, so it is not something to do every frame. Component pointers
+returned by GetComponent are only good until the next structural change.
+None of the structural functions are safe to call while a SystemScheduler
+is running, queue them up and make them after the systems are done.
+
+Queries are made with a ComponentMask. ForEachChunk and GetMatchingChunks
+only visit archetypes that have every component in the mask, so empty and
+unrelated archetypes cost nothing.
+
+This lives alongside the GameObject2D map storage, it does not replace
+it. See GameObjectHostSystem for running existing GameObject2D classes
+from inside the EntityManager.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef ENTITY_MANAGER_H
+#define ENTITY_MANAGER_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/ErrorManager.h>
+#include <Engine/SlotMap.hpp>
+#include <Engine/Component.h>
+#include <Engine/Archetype.h>
+
+//=====STL includes=====
+#include <map>
+#include <vector>
+#include <functional>
+
+namespace KillerEngine
+{
+	struct ChunkRef
+	{
+		Archetype* archetype;
+		U32 	   chunk;
+
+		U32 Count(void) const { return archetype->GetRowCount(chunk); }
+
+		Entity* Entities(void) const { return archetype->GetEntities(chunk); }
+
+		template<typename T>
+		T* Get(void) const { return static_cast<T*>(archetype->GetComponentArray(chunk, ComponentID<T>())); }
+	};
+
+	class EntityManager
+	{
+	public:
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+		EntityManager(void);
+
+		~EntityManager(void);
+
+//==========================================================================================================================
+//
+//Entity Functions
+//
+//==========================================================================================================================
+		Entity CreateEntity(void);
+
+		void DestroyEntity(Entity entity);
+
+		bool IsAlive(Entity entity) const { return _records.Contains(entity); }
+
+		U32 GetEntityCount(void) const { return _records.Size(); }
+
+		ComponentMask GetMask(Entity entity);
+
+		template<typename T>
+		T* AddComponent(Entity entity, const T& value)
+		{
+			U32 id = ComponentID<T>();
+			T* component = static_cast<T*>(_AddComponent(entity, id));
+
+			if(component != NULL) { *component = value; }
+
+			return component;
+		}
+
+		template<typename T>
+		void RemoveComponent(Entity entity)
+		{
+			_RemoveComponent(entity, ComponentID<T>());
+		}
+
+		template<typename T>
+		T* GetComponent(Entity entity)
+		{
+			return static_cast<T*>(_GetComponent(entity, ComponentID<T>()));
+		}
+
+		template<typename T>
+		bool HasComponent(Entity entity)
+		{
+			return (GetMask(entity) & ComponentBit<T>()) != 0;
+		}
+
+//==========================================================================================================================
+//
+//Queries
+//
+//==========================================================================================================================
+		void GetMatchingChunks(ComponentMask required, std::vector<ChunkRef>& out);
+
+		void ForEachChunk(ComponentMask required, const std::function<void(ChunkRef& chunk)>& func);
+
+	private:
+		struct EntityRecord
+		{
+			Archetype* archetype;
+			U32 	   chunk;
+			U32 	   row;
+		};
+
+		SlotMap<EntityRecord> 				_records;
+		std::map<ComponentMask, Archetype*> _archetypes;
+		std::vector<Archetype*> 			_archetypeList;
+
+		Archetype* _GetArchetype(ComponentMask mask);
+
+		void _Migrate(Entity entity, ComponentMask newMask);
+
+		void* _AddComponent(Entity entity, U32 componentID);
+
+		void _RemoveComponent(Entity entity, U32 componentID);
+
+		void* _GetComponent(Entity entity, U32 componentID);
+
+		EntityManager(const EntityManager&);
+		EntityManager& operator=(const EntityManager&);
+	};
+}//End namespace
+
+#endif
@@ -0,0 +1,85 @@
+/*========================================================================
+An EntitySystem is the behavior half of the entity component setup. Each
+system says up front which components an entity must have for the system
+to care about it, which components it reads, and which it writes. The
+SystemScheduler uses the read and write sets to decide which systems can
+run at the same time.
+
+v_UpdateChunk is called once for every chunk that matches, and chunks can
+be handed to different threads, so a system must only touch the rows of
+the chunk it was given, and only the components it said it would. If a
+system has to touch something outside of its chunk, like the Renderer or
+a GameObject2D, mark it main thread only and it will be run on the thread
+that called SystemScheduler::Run.
+
+v_BeginUpdate is called once on the calling thread before any chunks, and
+is the place to read anything that should be the same for every chunk.
+It is given the time to step by, which is not always the frame time, so
+a system should use it instead of reading the Timer.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef ENTITY_SYSTEM_H
+#define ENTITY_SYSTEM_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/Component.h>
+#include <Engine/EntityManager.h>
+
+namespace KillerEngine
+{
+	class EntitySystem
+	{
+	public:
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+		EntitySystem(ComponentMask required, ComponentMask reads, ComponentMask writes, bool mainThreadOnly)
+			: _required(required), _reads(reads), _writes(writes), _mainThreadOnly(mainThreadOnly)
+		{  }
+
+		virtual ~EntitySystem(void) {  }
+
+//==========================================================================================================================
+//
+//Virtual Functions
+//
+//==========================================================================================================================
+		virtual void v_BeginUpdate(F32 delta) {  }
+
+		virtual void v_UpdateChunk(ChunkRef& chunk)=0;
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+		ComponentMask GetRequired(void) const { return _required; }
+
+		ComponentMask GetReads(void) const { return _reads; }
+
+		ComponentMask GetWrites(void) const { return _writes; }
+
+		bool GetMainThreadOnly(void) const { return _mainThreadOnly; }
+
+		bool ConflictsWith(const EntitySystem& other) const
+		{
+			return (_writes & (other.GetReads() | other.GetWrites())) != 0 ||
+				   (other.GetWrites() & _reads) != 0;
+		}
+
+	private:
+		ComponentMask _required;
+		ComponentMask _reads;
+		ComponentMask _writes;
+		bool 		  _mainThreadOnly;
+	};
+}//End namespace
+
+#endif
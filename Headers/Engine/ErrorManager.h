@@ -3,6 +3,10 @@ A singleton class that will display any errors that can happen during
 the initialization of any of the components of the engine. It will be
 flushed out later to include more details. 
 
+SetError may be called from any thread, such as a JobPool worker running
+a background map. DisplayErrors shows a copy of what was set, and should
+only be called from the main thread.
+
 This is not free to use, and cannot be used without the express permission
 of KillerWave.
 
@@ -16,6 +20,7 @@ Written by Maxwell Miller
 
 //=====STL includes=====
 #include <map>
+#include <mutex>
 using std::map;
 
 namespace KillerEngine 
@@ -72,12 +77,13 @@ protected:
 //Constructor
 //
 //==========================================================================================================================
-		ErrorManager(void): _numErrors(0) {  }
+		ErrorManager(void): _numErrors(0), _errorCodes(), _errorMessages(), _lock() {  }
 
 private:
 		U32       			 _numErrors;
 		map<U32, ErrorCode>  _errorCodes;
 		map<U32, string>     _errorMessages;
+		std::mutex 			 _lock;
 		static ErrorManager* _instance;
 	};//End class
 }//End namespace
@@ -0,0 +1,123 @@
+/*========================================================================
+The FileWatcher is a singleton that calls back when a file on disc has
+changed. It is used for hot reloading maps and other assets while the
+game is running.
+
+On Linux it uses inotify, watching the folder the file is in so that
+editors which save by writing a new file and renaming it are still seen.
+Everywhere else it compares the last write time and size of each file,
+at most every PollInterval seconds. The time is kept to the nanosecond,
+or as close as the file system gets, so two saves in the same second
+are still told apart.
+
+Nothing happens on its own. Poll must be called, once a frame is plenty,
+and the callbacks are run on the thread that called it. A file that is
+written more than once between polls only calls back once.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef FILE_WATCHER_H
+#define FILE_WATCHER_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/ErrorManager.h>
+
+//=====STL includes=====
+#include <map>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+
+//=====Platform includes=====
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+namespace KillerEngine
+{
+	class FileWatcher
+	{
+	public:
+		~FileWatcher(void);
+
+//==========================================================================================================================
+//
+//Singleton Functions
+//
+//==========================================================================================================================
+		static FileWatcher* Instance(void);
+
+//==========================================================================================================================
+//
+//FileWatcher Functions
+//
+//==========================================================================================================================
+		U32 Watch(string path, std::function<void(const string& path)> callback);
+
+		void Unwatch(U32 watchID);
+
+		void Poll(void);
+
+		void SetPollInterval(F32 seconds) { _pollInterval = seconds; }
+
+		F32 GetPollInterval(void) const { return _pollInterval; }
+
+		U32 GetWatchCount(void) const { return (U32)_watches.size(); }
+
+	protected:
+//==========================================================================================================================
+//
+//Constructor
+//
+//==========================================================================================================================
+		FileWatcher(void);
+
+	private:
+		//=====time is in nanoseconds, from whatever start the platform uses=====
+		struct FileStamp
+		{
+			S64 time;
+			S64 size;
+		};
+
+		struct WatchedFile
+		{
+			string 									path;
+			string 									folder;
+			string 									name;
+			FileStamp 								lastWrite;
+			S32 									handle;
+			std::function<void(const string& path)> callback;
+		};
+
+		static FileWatcher* 					 _instance;
+		std::map<U32, WatchedFile> 				 _watches;
+		std::vector<U32> 						 _changed;
+		U32 									 _nextID;
+		F32 									 _pollInterval;
+		std::chrono::steady_clock::time_point 	 _lastPoll;
+		S32 									 _notifyHandle;
+
+		static bool _GetStamp(const string& path, FileStamp& stamp);
+
+		void _PollNotify(void);
+
+		void _PollTimes(void);
+	};
+}//End namespace
+
+#endif
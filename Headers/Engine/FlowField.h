@@ -0,0 +1,80 @@
+/*========================================================================
+A FlowField answers "which way to the goal" for every tile of a grid at
+once, so any number of units heading to the same place can share one
+search. It is built with a single Dijkstra pass out from the goal, over
+the same 8 way, no corner cutting moves as GridSearch, and then each tile
+stores the step toward its cheapest neighbor.
+
+GetDirection returns that step as a GridPoint, with both parts 0 at the
+goal and on tiles that cannot reach it. GetCost is the path length to
+the goal, or a negative number if there is no path.
+
+The field remembers the layer version it was built against, so the
+PathfindingService knows when it has to be built again.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/TileCollisionLayer.h>
+#include <Engine/GridSearch.h>
+
+//=====STL includes=====
+#include <vector>
+
+namespace KillerEngine
+{
+	class FlowField
+	{
+	public:
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+		FlowField(void);
+
+//==========================================================================================================================
+//
+//FlowField Functions
+//
+//==========================================================================================================================
+		bool Build(const TileCollisionLayer& layer, U8 blockingFlags, GridPoint goal);
+
+		GridPoint GetDirection(S32 x, S32 y) const;
+
+		F32 GetCost(S32 x, S32 y) const;
+
+		bool IsReachable(S32 x, S32 y) const { return GetCost(x, y) >= 0.0f; }
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+		GridPoint GetGoal(void) const { return _goal; }
+
+		U32 GetVersion(void) const { return _version; }
+
+		U32 GetWidth(void) const { return (U32)_width; }
+
+		U32 GetHeight(void) const { return (U32)_height; }
+
+	private:
+		S32 			 _width;
+		S32 			 _height;
+		GridPoint 		 _goal;
+		U32 			 _version;
+		std::vector<F32> _costs;
+		//=====Index into the direction table, 8 means stay=====
+		std::vector<U8>  _directions;
+	};
+}//End namespace
+
+#endif
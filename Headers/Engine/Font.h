@@ -2,6 +2,21 @@
 The Font class is used to open a .fnt file, extract the needed character
 data, and then save that for text processing later on.
 
+Both kinds of file BMFont writes can be read, the text one and the binary
+one, which starts with BMF and is much faster to load. Which one a file is
+is worked out from its first bytes, not its name. The text file is read
+into memory once and parsed in a single pass.
+
+The glyphs are kept in one flat array. Any codepoint below _FLAT_LIMIT is
+found with a single index into a table, the rest, which only fonts with
+large Unicode ranges have, are found through a hash map. Kerning pairs are
+kept sorted, and GetKerning finds one with a binary search.
+
+GetStats returns how many glyphs and kerning pairs the last InitFont read,
+how many of the glyphs needed the hash map, how many bytes it read and how
+long it took, in milliseconds. Render_Tests loads a 5000 glyph font from
+both kinds of file and prints these.
+
 CreateCharacter is a CharSprite Factory. This may be important to know.
 
 This is not free to use, and cannot be used without the express permission
@@ -14,6 +29,7 @@ Written by Maxwell Miller
 
 //=====Engine includes=====
 #include <Engine/Atom.h>
+#include <Engine/ErrorManager.h>
 #include <Engine/Texture.hpp>
 #include <Engine/CharSprite.h>
 #include <Engine/TextureManager.h>
@@ -25,6 +41,10 @@ Written by Maxwell Miller
 #include <vector>
 #include <map>
 #include <list>
+#include <unordered_map>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 
 namespace KillerEngine
 {
@@ -35,11 +55,28 @@ namespace KillerEngine
 		U32 y;
 		U32 width;
 		U32 height;
-		U32 xoffset;
-		U32 yoffset;
+		S32 xoffset;
+		S32 yoffset;
 		U32 xadvance;
 	};
 
+	struct KerningPair
+	{
+		U32 first;
+		U32 second;
+		S32 amount;
+	};
+
+	struct FontStats
+	{
+		U32 glyphs;
+		U32 hashedGlyphs;
+		U32 kernings;
+		U32 bytes;
+		F64 loadTime;
+		bool binary;
+	};
+
 	//Forward declare CharSprite
 	class CharSprite;
 
@@ -50,7 +87,7 @@ namespace KillerEngine
 //
 //Constructors
 //
-//==========================================================================================================================		
+//==========================================================================================================================
 		Font(void);
 
 		Font(U32 tID);
@@ -64,7 +101,9 @@ namespace KillerEngine
 
 		CharacterData* GetDataForCharacter(char c);
 
-		std::map<U32, CharacterData*> GetDataMap(void) { return _fontCharData; }
+		CharacterData* GetDataForCodepoint(U32 codepoint);
+
+		S32 GetKerning(U32 first, U32 second) const;
 
 		CharSprite* CreateCharacter(char character);
 
@@ -76,23 +115,26 @@ namespace KillerEngine
 
 		Font& operator=(Font* font)
 		{
-			_textureID = font->GetTextureID();
-			_fontFile = font->GetFile();
-			_fontName = font->GetName();
-			_fontCharData = font->GetDataMap();
+			*this = *font;
 
 			return *this;
 		}
 
-		Font& operator=(Font& font)
+		Font& operator=(const Font& font)
 		{
-			_textureID = font.GetTextureID();
-			_fontFile = font.GetFile();
-			_fontName = font.GetName();
-			_fontCharData = font.GetDataMap();
+			_textureID = font._textureID;
+			_fontFile = font._fontFile;
+			_fontName = font._fontName;
+			_lineHeight = font._lineHeight;
+			_base = font._base;
+			_glyphs = font._glyphs;
+			_flatIndex = font._flatIndex;
+			_hashIndex = font._hashIndex;
+			_kernings = font._kernings;
+			_stats = font._stats;
 
 			return *this;
-		}		
+		}
 
 //==========================================================================================================================
 //
@@ -111,17 +153,39 @@ namespace KillerEngine
 
 		U32 GetTextureID(void)			  { return  _textureID; }
 
+		U32 GetLineHeight(void) const 	  { return _lineHeight; }
+
+		U32 GetBase(void) const 		  { return _base; }
+
+		U32 GetGlyphCount(void) const 	  { return (U32)_glyphs.size(); }
+
+		const FontStats& GetStats(void) const { return _stats; }
+
 	private:
-		U32 					 	 _textureID;
-		string  					 _fontFile;
-		string  					 _fontName;
-		U32     					 _headerSize = 26;
-		std::map<U32, CharacterData*> _fontCharData;
-
-		void _AddNewCharacterData(string id,      string x, 		string y,
-							  	  string width,   string height,   string xoffset,
-							  	  string yoffset, string xadvance);
+		static const U32 _FLAT_LIMIT = 2048;
+		static const U32 _NO_GLYPH = 0xFFFFFFFF;
+
+		U32 					 	 	_textureID;
+		string  					 	_fontFile;
+		string  					 	_fontName;
+		U32 						 	_lineHeight;
+		U32 						 	_base;
+		std::vector<CharacterData> 	 	_glyphs;
+		std::vector<U32> 			 	_flatIndex;
+		std::unordered_map<U32, U32> 	_hashIndex;
+		std::vector<KerningPair> 	 	_kernings;
+		FontStats 					 	_stats;
+
+		void _Clear(void);
+
+		void _ParseText(const char* text, const char* end);
+
+		bool _ParseBinary(const U8* data, const U8* end);
+
+		void _AddGlyph(const CharacterData& glyph);
+
+		void _SortKernings(void);
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,135 @@
+/*========================================================================
+The RenderBackend that draws with OpenGL. This is the one the Renderer
+uses unless it is given something else.
+
+Batches are copied into a StreamBuffer and drawn from there. Nothing is
+allocated on the GPU after v_Init. The size of a region can be changed
+with SetStreamRegionSize before the backend is first used. A batch too
+big for one region is split into as many reservations as it takes, and
+each piece is drawn with the same shader, texture and blend, so only the
+attribute offsets change between them. v_GetBatchCapacity is how many
+sprites fit in a region.
+
+Instanced batches draw a four vertex unit quad once per sprite. The quad
+is made in v_Init and fed to attribute 5, the sprite attributes step once
+per instance for those draws and once per vertex for everything else.
+
+SetTimingEnabled(true) wraps each frame in a GL_TIME_ELAPSED query. The
+result is read a few frames later so the CPU never waits on the GPU, and
+GetGPUFrameTime and GetAverageGPUFrameTime return milliseconds. This is
+how the point and instanced paths are compared on a given driver, the
+SpritePath_Benchmark program does it for 100000 SqrSprites.
+
+SetView gives the backend a camera translation to use instead of asking
+the Camera, which is how the RenderThread draws a frame with the camera
+as it was when the frame was recorded. NULL goes back to the Camera.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef GL_RENDER_BACKEND_H
+#define GL_RENDER_BACKEND_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/RenderBackend.h>
+#include <Engine/TextureManager.h>
+#include <Engine/Camera.h>
+#include <Engine/StreamBuffer.h>
+#include <Engine/GLStateCache.h>
+
+
+//=====OGL includes=====
+#include <GL/gl.h>
+
+namespace KillerEngine
+{
+	class GLRenderBackend : public RenderBackend
+	{
+	public:
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+		GLRenderBackend(void);
+
+		~GLRenderBackend(void);
+
+//==========================================================================================================================
+//
+//Virtual Functions
+//
+//==========================================================================================================================
+		void v_Init(void);
+
+		void v_UseShader(GLuint shader);
+
+		void v_BindTexture(U32 textureID);
+
+		void v_DrawBatch(const RenderBatch& batch);
+
+		void v_DrawStatic(GLuint vertexArray, U32 count, bool blend, bool instanced);
+
+		void v_BindDefaultVertexArray(void) { glBindVertexArray(_vertexArrayObject); }
+
+		void v_BeginFrame(void);
+
+		void v_EndFrame(void);
+
+		U32 v_GetBatchCapacity(void) const { return _regionSize / sizeof(SpriteVertex); }
+
+		void v_Finish(void) { glFinish(); }
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+		void SetStreamRegionSize(U32 bytes) { _regionSize = bytes; }
+
+		StreamBuffer& GetStreamBuffer(void) { return _stream; }
+
+		void SetTimingEnabled(bool state) { _timingEnabled = state; }
+
+		bool GetTimingEnabled(void) const { return _timingEnabled; }
+
+		F32 GetGPUFrameTime(void) const { return _lastGPUTime; }
+
+		F32 GetAverageGPUFrameTime(void) const { return _timedFrames == 0 ? 0.0f : (F32)(_totalGPUTime / _timedFrames); }
+
+		U32 GetTimedFrameCount(void) const { return _timedFrames; }
+
+		void ResetTiming(void);
+
+		void SetView(const Matrix* translation, U32 version) { _view = translation; _viewVersion = version; }
+
+	private:
+		static const U32 _QUERY_COUNT = 4;
+
+		GLuint 		 _vertexArrayObject;
+		GLuint 		 _quadBuffer;
+		StreamBuffer _stream;
+		U32 		 _regionSize;
+		bool   		 _initialized;
+		GLuint 		 _queries[_QUERY_COUNT];
+		bool 		 _queryPending[_QUERY_COUNT];
+		U32 		 _queryIndex;
+		bool 		 _queryOpen;
+		bool 		 _timingEnabled;
+		F32 		 _lastGPUTime;
+		F64 		 _totalGPUTime;
+		U32 		 _timedFrames;
+		const Matrix* _view;
+		U32 		 _viewVersion;
+
+		void _SetInstanced(GLuint vertexArray, bool state);
+
+		void _ReadQueries(void);
+
+	};
+}//End namespace
+
+#endif
@@ -0,0 +1,153 @@
+/*========================================================================
+The GLStateCache sits in front of the few pieces of GL state the engine
+changes every frame, the bound program, the texture on unit 0 and the
+camera matrices, and only calls GL when something really changed.
+
+Uniform locations are looked up once per program and name, and kept.
+CacheProgram looks up the ones every sprite shader has right after the
+program is linked, anything else is looked up the first time it is used.
+
+UniformMatrix4 takes a version along with the data. The matrix is only
+uploaded when the version is not the one the program was last given, so
+the Camera passes its own version, which only changes when it moves, and
+switching between shaders costs nothing while it stands still.
+
+Anything that binds a program or a 2D texture must go through here, or
+call Invalidate after it is done, or the cache will skip a bind that was
+needed. ForgetProgram must be called before a program is deleted, as GL
+is free to hand the same name out again.
+
+SetVertexAttribute enables or disables one attribute of a vertex array,
+which must be the one bound. Which attributes are on is kept for each
+vertex array, as it belongs to the array and not to the context, and
+ForgetVertexArray must be called before one is deleted.
+
+GetCounters returns how many of each call were made and how many were
+skipped since the last ResetCounters.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef GL_STATE_CACHE_H
+#define GL_STATE_CACHE_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+
+//=====OGL includes=====
+#include <GL/gl.h>
+
+//=====STL includes=====
+#include <vector>
+#include <cstring>
+
+namespace KillerEngine
+{
+	struct GLStateCounters
+	{
+		U32 programBinds;
+		U32 programBindsElided;
+		U32 textureBinds;
+		U32 textureBindsElided;
+		U32 uniformUploads;
+		U32 uniformUploadsElided;
+		U32 locationLookups;
+		U32 locationHits;
+		U32 attributeChanges;
+		U32 attributeChangesElided;
+	};
+
+	class GLStateCache
+	{
+	public:
+//==========================================================================================================================
+//
+//Singleton Functions
+//
+//==========================================================================================================================
+		static GLStateCache* Instance(void);
+
+//==========================================================================================================================
+//
+//State Functions
+//
+//==========================================================================================================================
+		void UseProgram(GLuint program);
+
+		void BindTexture(GLuint texture);
+
+		GLint GetUniformLocation(GLuint program, const GLchar* name);
+
+		void UniformMatrix4(GLuint program, const GLchar* name, const F32* data, U32 version);
+
+		void CacheProgram(GLuint program);
+
+		void ForgetProgram(GLuint program);
+
+		void SetVertexAttribute(GLuint vertexArray, GLuint index, bool enabled);
+
+		void ForgetVertexArray(GLuint vertexArray);
+
+		void Invalidate(void);
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+		GLuint GetProgram(void) const { return _program; }
+
+		GLuint GetTexture(void) const { return _texture; }
+
+		const GLStateCounters& GetCounters(void) const { return _counters; }
+
+		void ResetCounters(void) { _counters = GLStateCounters(); }
+
+	protected:
+//==========================================================================================================================
+//
+//Constructor
+//
+//==========================================================================================================================
+		GLStateCache(void);
+
+	private:
+		struct CachedUniform
+		{
+			const GLchar* name;
+			GLint 		  location;
+			U32 		  version;
+		};
+
+		struct CachedProgram
+		{
+			GLuint 					   program;
+			std::vector<CachedUniform> uniforms;
+		};
+
+		//=====One bit per attribute, an attribute is only trusted once its bit is in known=====
+		struct CachedVertexArray
+		{
+			GLuint vertexArray;
+			U32    enabled;
+			U32    known;
+		};
+
+		static GLStateCache* 	   _instance;
+		std::vector<CachedProgram> _programs;
+		std::vector<CachedVertexArray> _vertexArrays;
+		GLuint 					   _program;
+		GLuint 					   _texture;
+		bool 					   _programKnown;
+		bool 					   _textureKnown;
+		GLStateCounters 		   _counters;
+
+		CachedProgram* _FindProgram(GLuint program);
+
+		CachedUniform* _FindUniform(GLuint program, const GLchar* name);
+	};
+}//End namespace
+
+#endif
@@ -34,6 +34,9 @@ Written by Maxwell Miller
 #include <Engine/Texture.hpp>
 #include <Engine/ErrorManager.h>
 
+//=====STL includes=====
+#include <atomic>
+
 namespace KillerEngine 
 {
 	
@@ -48,7 +51,7 @@ namespace KillerEngine
 		GameObject2D(void);
 
 
-		//~GameObject(void);
+		virtual ~GameObject2D(void) {  }
 
 		//void v_ShutDown(void);		
 
@@ -74,8 +77,8 @@ namespace KillerEngine
 
 		void SetID(void) 
 		{
-			_ID = _nextID;
-			++_nextID;
+			//=====Background maps make objects on the JobPool, so two may ask at once=====
+			_ID = _nextID.fetch_add(1, std::memory_order_relaxed);
 
 			//This is here to make sure that by this point the user has 
 			//added a sprite to the game object.
@@ -164,8 +167,22 @@ namespace KillerEngine
 			_active = false; 
 		}
 
+//=====Static=====
+//A static object never moves or changes how it looks. When it is added
+//to a Map it is drawn from the Map's StaticLayerCache instead of having
+//v_Render called every frame. Set this before adding the object.
+		const bool GetStatic(void)
+		{
+			return _static;
+		}
+
+		void SetStatic(bool state)
+		{
+			_static = state;
+		}
+
 //=====Sprite=====
-		const Sprite* GetSprite(void) 
+		Sprite* GetSprite(void) 
 		{ 
 			return _sprite; 
 		}
@@ -275,9 +292,10 @@ namespace KillerEngine
 
 
 	private:	
-		static U32 	_nextID;
+		static std::atomic<U32> _nextID;
 		U32 		_ID;
 		bool 	 	_active;
+		bool 		_static;
 		Sprite*  	_sprite;
 		Vec2     	_position;
 		Vec2	 	_velocity;
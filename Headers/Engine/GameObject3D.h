@@ -32,6 +32,9 @@ Written by Maxwell Miller
 #include <Engine/Atom.h>
 #include <Engine/ErrorManager.h>
 
+//=====STL includes=====
+#include <atomic>
+
 namespace KillerEngine
 {
 	class GameObject3D
@@ -70,8 +73,7 @@ namespace KillerEngine
 
 		void SetID(void)
 		{
-			_ID = _nextID;
-			++_nextID;
+			_ID = _nextID.fetch_add(1, std::memory_order_relaxed);
 		}
 
 //==========================================================================================================================
@@ -131,7 +133,7 @@ namespace KillerEngine
 //
 //==========================================================================================================================
 	private:
-		static U32 _nextID;
+		static std::atomic<U32> _nextID;
 		U32		   _ID;
 		bool	   _active;
 		Vec3	   _position;
@@ -0,0 +1,62 @@
+/*========================================================================
+The GameObjectHostSystem lets an existing GameObject2D subclass live in
+the EntityManager without being rewritten. Host() makes an entity with a
+GameObject2DComponent that points at the object, and a Position2D that is
+kept in sync with the object's position after every update, so other
+systems and queries can see where hosted objects are.
+
+Since a GameObject2D can do anything in its v_Update, this system says it
+reads and writes every component, and is main thread only. It will always
+run in a stage of its own, after the systems that were added before it.
+
+Render calls v_Render on every hosted object, and should be called from
+the Map's v_Render.
+
+The EntityManager does not own the hosted objects. Remove the entity
+before deleting the object.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef GAME_OBJECT_HOST_SYSTEM_H
+#define GAME_OBJECT_HOST_SYSTEM_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/GameObject2D.h>
+#include <Engine/EntitySystem.h>
+#include <Engine/EntityManager.h>
+
+namespace KillerEngine
+{
+	class GameObjectHostSystem : public EntitySystem
+	{
+	public:
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+		GameObjectHostSystem(void);
+
+//==========================================================================================================================
+//
+//Virtual Functions
+//
+//==========================================================================================================================
+		void v_UpdateChunk(ChunkRef& chunk);
+
+//==========================================================================================================================
+//
+//GameObjectHostSystem Functions
+//
+//==========================================================================================================================
+		static Entity Host(EntityManager& entities, GameObject2D* obj);
+
+		void Render(EntityManager& entities);
+	};
+}//End namespace
+
+#endif
@@ -0,0 +1,118 @@
+/*========================================================================
+GridSearch finds paths over the tiles of a TileCollisionLayer. It holds
+all of the scratch memory for a search in flat arrays the size of the
+grid, and a binary heap for the open list, so nothing is allocated while
+searching once the arrays are sized. The arrays are stamped with a search
+number instead of being cleared, so starting a search is free.
+
+Movement is 8 way. A diagonal step is only allowed when both of the
+straight steps next to it are open, so paths never cut corners. A tile is
+blocked if it has any of the blocking flags, TC_SOLID by default.
+
+FindPath is plain A*. FindPathJPS is jump point search, which only puts
+the tiles where a path can turn on the open list. It finds the same
+length path as A* and is much faster on open, uniform cost grids. Both
+return every tile of the path, start and goal included.
+
+A GridSearch is not thread safe. The PathfindingService gives each worker
+its own.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef GRID_SEARCH_H
+#define GRID_SEARCH_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/TileCollisionLayer.h>
+
+//=====STL includes=====
+#include <vector>
+#include <algorithm>
+
+namespace KillerEngine
+{
+	struct GridPoint
+	{
+		S32 x;
+		S32 y;
+
+		GridPoint(void) : x(0), y(0) {  }
+
+		GridPoint(S32 xPos, S32 yPos) : x(xPos), y(yPos) {  }
+
+		bool operator==(const GridPoint& p) const { return x == p.x && y == p.y; }
+
+		bool operator!=(const GridPoint& p) const { return !(*this == p); }
+	};
+
+	class GridSearch
+	{
+	public:
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+		GridSearch(void);
+
+//==========================================================================================================================
+//
+//GridSearch Functions
+//
+//==========================================================================================================================
+		void SetGrid(const TileCollisionLayer* layer, U8 blockingFlags);
+
+		bool FindPath(GridPoint start, GridPoint goal, std::vector<GridPoint>& out);
+
+		bool FindPathJPS(GridPoint start, GridPoint goal, std::vector<GridPoint>& out);
+
+		bool IsWalkable(S32 x, S32 y) const
+		{
+			return x >= 0 && y >= 0 && x < _width && y < _height && !_layer->Test((U32)x, (U32)y, _blocking);
+		}
+
+		U32 GetExpandedCount(void) const { return _expanded; }
+
+	private:
+		struct HeapEntry
+		{
+			F32 f;
+			S32 cell;
+
+			bool operator>(const HeapEntry& e) const { return f > e.f; }
+		};
+
+		const TileCollisionLayer* _layer;
+		U8 						  _blocking;
+		S32 					  _width;
+		S32 					  _height;
+		U32 					  _search;
+		U32 					  _expanded;
+		GridPoint 				  _goal;
+		std::vector<F32> 		  _g;
+		std::vector<S32> 		  _parent;
+		std::vector<U32> 		  _seen;
+		std::vector<U32> 		  _closed;
+		std::vector<HeapEntry> 	  _open;
+
+		bool _Begin(GridPoint start, GridPoint goal);
+
+		void _Push(S32 cell, F32 g, S32 parent);
+
+		S32 _PopOpen(void);
+
+		F32 _Heuristic(S32 x, S32 y) const;
+
+		bool _Jump(S32 x, S32 y, S32 dx, S32 dy, GridPoint& jumpPoint) const;
+
+		bool _JumpStraight(S32 x, S32 y, S32 dx, S32 dy, GridPoint& jumpPoint) const;
+
+		void _BuildPath(S32 goalCell, std::vector<GridPoint>& out) const;
+	};
+}//End namespace
+
+#endif
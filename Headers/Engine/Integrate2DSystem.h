@@ -0,0 +1,47 @@
+/*========================================================================
+A system that moves every entity with a Position2D, Velocity2D and an
+Acceleration2D, by the time given to v_BeginUpdate. It is the entity
+version of the integration done by Particle2D, without damping or forces.
+
+It writes Position2D and Velocity2D, and only reads Acceleration2D, so it
+can share a stage with any system that does not touch those two.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef INTEGRATE_2D_SYSTEM_H
+#define INTEGRATE_2D_SYSTEM_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/EntitySystem.h>
+
+namespace KillerEngine
+{
+	class Integrate2DSystem : public EntitySystem
+	{
+	public:
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+		Integrate2DSystem(void);
+
+//==========================================================================================================================
+//
+//Virtual Functions
+//
+//==========================================================================================================================
+		void v_BeginUpdate(F32 delta);
+
+		void v_UpdateChunk(ChunkRef& chunk);
+
+	private:
+		F32 _deltaTime;
+	};
+}//End namespace
+
+#endif
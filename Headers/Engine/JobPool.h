@@ -0,0 +1,130 @@
+/*========================================================================
+The JobPool is a singleton that owns a fixed set of worker threads, and a
+queue of jobs for them to run. It is used anywhere in the engine that work
+can be split up and run at the same time, such as running systems that do
+not touch the same data, or answering a large batch of queries.
+
+Jobs are grouped with a JobGroup. Submit adds a job to a group, and Wait
+blocks until every job in that group has finished. The thread that calls
+Wait does not sleep while there is work in the queue, it runs jobs itself
+so that a Wait from inside a job can never dead lock the pool.
+
+ParallelFor is a helper that splits a range into pieces of at least grain
+items, runs each piece as a job, and waits for them all.
+
+Submit can also be given a pointer to a job, which is run without being
+copied, so a job that is handed out every frame can be made once and kept.
+It must live until Wait returns. The queue keeps its memory once it has
+grown, so submitting the same number of jobs every frame does not touch
+the heap.
+
+Init should be called once at start up. If it is never called, the pool
+starts itself with one less worker than the number of hardware threads the
+first time it is used. With zero workers every job runs on the thread that
+submitted it, which is handy for debugging.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef JOB_POOL_H
+#define JOB_POOL_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+
+//=====STL includes=====
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+namespace KillerEngine
+{
+	class JobGroup
+	{
+	public:
+		JobGroup(void) : _pending(0) {  }
+
+		bool Done(void) const { return _pending.load(std::memory_order_acquire) == 0; }
+
+	private:
+		friend class JobPool;
+		std::atomic<U32> _pending;
+
+		JobGroup(const JobGroup&);
+		JobGroup& operator=(const JobGroup&);
+	};
+
+	class JobPool
+	{
+	public:
+		~JobPool(void);
+
+//==========================================================================================================================
+//
+//Singleton Functions
+//
+//==========================================================================================================================
+		static JobPool* Instance(void);
+
+		void Init(U32 workerCount);
+
+		void ShutDown(void);
+
+//==========================================================================================================================
+//
+//JobPool Functions
+//
+//==========================================================================================================================
+		void Submit(JobGroup& group, std::function<void(void)> job);
+
+		void Submit(JobGroup& group, const std::function<void(void)>* job);
+
+		void Wait(JobGroup& group);
+
+		void ParallelFor(U32 count, U32 grain, const std::function<void(U32 begin, U32 end)>& job);
+
+		U32 GetWorkerCount(void) const { return (U32)_workers.size(); }
+
+	protected:
+//==========================================================================================================================
+//
+//Constructor
+//
+//==========================================================================================================================
+		JobPool(void);
+
+	private:
+		//=====shared is used instead of work when it is set=====
+		struct Job
+		{
+			std::function<void(void)> 		 work;
+			const std::function<void(void)>* shared;
+			JobGroup* 						 group;
+		};
+
+		static JobPool* 		 _instance;
+		std::vector<std::thread> _workers;
+		std::vector<Job> 		 _queue;
+		U32 					 _queueHead;
+		std::mutex 				 _queueLock;
+		std::condition_variable  _queueSignal;
+		std::condition_variable  _doneSignal;
+		bool 					 _running;
+		bool 					 _initialized;
+
+		void _WorkerLoop(void);
+
+		bool _RunOne(std::unique_lock<std::mutex>& lock);
+
+		void _Push(JobGroup& group, std::function<void(void)>&& job, const std::function<void(void)>* shared);
+
+		bool _QueueEmpty(void) const { return _queueHead == _queue.size(); }
+	};
+}//End namespace
+
+#endif
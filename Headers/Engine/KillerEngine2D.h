@@ -8,6 +8,11 @@ A lot of the functions that will be here will not be required to use in
 order to use the engine. They will be present as helper classes, not
 intended for required use. 
 
+SetThreadedRender(true) starts the RenderThread, so Render only records
+the frame and the GL calls and buffer swap happen on another thread while
+the next Update runs. See RenderThread for what the game may not do while
+it is on. End stops it.
+
 This is not free to use, and cannot be used without the express permission
 of KillerWave.
 
@@ -26,6 +31,10 @@ Written by Maxwell Miller
 #include <Engine/Timer.h>
 #include <Engine/MapManager.h>
 #include <Engine/TextureManager.h>
+#include <Engine/SqrSprite.h>
+#include <Engine/CharSprite.h>
+#include <Engine/TriSprite.h>
+#include <Engine/RenderThread.h>
 
 //======Math includes=====
 //#include <Engine/RandomGen.h>
@@ -48,7 +57,7 @@ namespace KillerEngine
 
 		bool Running(void) { return MapManager::Instance()->GetRunning(); }
 
-		void End(void) { MapManager::Instance()->SetRunning(false); }
+		void End(void);
 
 		void LoadTexture(const string path, const U32 id, const S32 width, const S32 height) 
 		{ 
@@ -62,6 +71,10 @@ namespace KillerEngine
 		void Update(void);
 
 		void Render(void);
+
+		void SetThreadedRender(bool state);
+
+		bool GetThreadedRender(void) const { return RenderThread::Instance()->IsRunning(); }
 //==========================================================================================================================
 //
 //Singleton functions
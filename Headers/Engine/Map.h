@@ -17,10 +17,24 @@ Written by Maxwell Miller
 #include <Engine/GameObject3D.h>
 #include <Engine/Renderer.h>
 #include <Engine/TextureManager.h>
+#include <Engine/TextureAtlas.h>
 #include <Engine/EnvironmentObject.h>
+#include <Engine/SlotMap.hpp>
+#include <Engine/MapCommandBuffer.h>
+#include <Engine/EntityManager.h>
+#include <Engine/SystemScheduler.h>
+#include <Engine/StaticLayerCache.h>
+#include <Engine/QuadTree.h>
+#include <Engine/TileCollisionLayer.h>
+#include <Engine/PathfindingService.h>
+#include <Engine/FileWatcher.h>
+#include <Engine/Camera.h>
+#include <Engine/ViewCuller.h>
 
 //=====STL includes=====
 #include <map>
+#include <vector>
+#include <unordered_map>
 #include <fstream>
 #include <algorithm>
 
@@ -32,6 +46,14 @@ Written by Maxwell Miller
 
 namespace KillerEngine 
 {
+	struct MapCullStats
+	{
+		U32 chunksDrawn;
+		U32 chunksCulled;
+		U32 objectsVisible;
+		U32 objectsCulled;
+	};
+
 	class Map
 	{
 	protected:
@@ -53,6 +75,7 @@ namespace KillerEngine
 			int height;
 			string texturePath;
 			ObjectType type;
+			U8 collision;
 			int textureID;
 			int posX;
 		};
@@ -75,7 +98,10 @@ namespace KillerEngine
 //==========================================================================================================================		
 		Map(void);
 
-		~Map(void) {  }
+		~Map(void) 
+		{ 
+			EnableHotReload(false); 
+		}
 
 //==========================================================================================================================
 //
@@ -110,31 +136,264 @@ namespace KillerEngine
 			return NULL;
 		}
 
+		//=====Called for objects made by v_CreateObject when a reload takes their tile away=====
+		virtual void v_DestroyObject(GameObject2D* obj)
+		{
+			delete obj;
+		}
+
 //==========================================================================================================================
 //
 //Accessors
 //
 //==========================================================================================================================
-		void AddObjectToMap(GameObject2D* obj);
+		SlotHandle AddObjectToMap(GameObject2D* obj);
 
-		void AddObjectToMap(GameObject3D* obj);
+		SlotHandle AddObjectToMap(GameObject3D* obj);
 		
 		void Remove2DObjectFromMap(U32 id);
 
+		void Remove2DObjectFromMap(SlotHandle handle);
+
 		void Remove3DObjectFromMap(U32 id);
 
-		void RenderObjects(void) {
-			for(auto i = _2DWorldObjects.begin(); i!=_2DWorldObjects.end(); ++i) 
+		void Remove3DObjectFromMap(SlotHandle handle);
+
+		GameObject2D* Get2DObject(U32 id);
+
+		GameObject2D* Get2DObject(SlotHandle handle);
+
+		GameObject3D* Get3DObject(U32 id);
+
+		GameObject3D* Get3DObject(SlotHandle handle);
+
+		SlotHandle Get2DHandle(U32 id) const;
+
+		SlotHandle Get3DHandle(U32 id) const;
+
+		U32 Get2DObjectCount(void) const { return _2DWorldObjects.Size(); }
+
+		U32 Get3DObjectCount(void) const { return _3DWorldObjects.Size(); }
+
+//==========================================================================================================================
+//
+//Deferred Changes
+//
+//These queue a change instead of making it right away. They are safe to call from inside v_Update, and from more than one
+//thread at a time. The changes are applied in the order they were queued when FlushCommands is called. The MapManager calls
+//FlushCommands for every map once per frame, after the update, which is the sync point.
+//
+//==========================================================================================================================
+		void DeferAddObjectToMap(GameObject2D* obj);
+
+		void DeferAddObjectToMap(GameObject3D* obj);
+
+		void DeferRemove2DObjectFromMap(U32 id);
+
+		void DeferRemove3DObjectFromMap(U32 id);
+
+		void DeferSet2DObjectActive(U32 id, bool active);
+
+		void DeferSet3DObjectActive(U32 id, bool active);
+
+		void FlushCommands(void);
+
+		void ApplyCommand(const MapCommand& command);
+
+		void UpdateObjects(void) 
+		{
+			for(U32 i = 0; i < _2DWorldObjects.Size(); ++i)
 			{
-				i->second->v_Render();
+				_2DWorldObjects[i]->v_Update();
 			}
 
-			for(auto i = _3DWorldObjects.begin(); i!=_3DWorldObjects.end(); ++i)
+			for(U32 i = 0; i < _3DWorldObjects.Size(); ++i)
 			{
-				i->second->v_Render();
+				_3DWorldObjects[i]->v_Update();
+			}
+		}
+
+		void RenderObjects(void) 
+		{
+			U32 count = _2DWorldObjects.Size();
+
+			if(_culling)
+			{
+				_CullObjects(Camera::Instance()->GetViewRect());
+				count = (U32)_visible2D.size();
+			}
+			else
+			{
+				_staticLayer.Render();
+			}
+
+			if(_parallelRender)
+			{
+				Renderer::Instance()->RecordParallel(count, _renderGrain, [this](U32 begin, U32 end) { _Render2DObjects(begin, end); });
+			}
+			else
+			{
+				_Render2DObjects(0, count);
+			}
+
+			for(U32 i = 0; i < _3DWorldObjects.Size(); ++i)
+			{
+				_3DWorldObjects[i]->v_Render();
 			}
 		}
 		
+//==========================================================================================================================
+//
+//Entities
+//
+//Each Map has its own EntityManager and SystemScheduler. UpdateEntities runs every system that has been added, stepping by
+//GetTickDelta, and should be called from v_Update. The Map does not own the systems.
+//
+//==========================================================================================================================
+		EntityManager& GetEntityManager(void) { return _entities; }
+
+		SystemScheduler& GetSystemScheduler(void) { return _systems; }
+
+		void AddSystem(EntitySystem* system) { _systems.AddSystem(system); }
+
+		void UpdateEntities(void) { _systems.Run(_entities, _tickDelta); }
+
+//==========================================================================================================================
+//
+//Simulation
+//
+//The MapManager can keep maps that are not active running in the background, each one as its own job on the JobPool. A
+//background map is only updated once every tick divisor frames, so a far away zone can tick at a quarter of the rate of
+//the active one. GetTickDelta is the time that has passed since the last time this map was updated, and is what v_Update
+//should step by instead of the frame time when the divisor is more than 1. The active map is updated every frame.
+//
+//A background v_Update runs at the same time as other maps, so it must only touch its own map, use the Defer functions to
+//reach anything else, and must not call the Renderer. It may make new GameObjects, as their IDs are handed out atomically,
+//and may call ErrorManager::SetError, which takes a lock. Nothing else global is safe to use from one.
+//
+//==========================================================================================================================
+		void SetBackgroundSimulation(bool state) { _backgroundSimulation = state; }
+
+		bool GetBackgroundSimulation(void) const { return _backgroundSimulation; }
+
+		void SetTickDivisor(U32 divisor) { _tickDivisor = divisor == 0 ? 1 : divisor; }
+
+		U32 GetTickDivisor(void) const { return _tickDivisor; }
+
+		F32 GetTickDelta(void) const { return _tickDelta; }
+
+		bool AdvanceTick(F32 delta, U32 divisor);
+
+//==========================================================================================================================
+//
+//Static Layer
+//
+//2D objects that are static when they are added are drawn from the StaticLayerCache. Call UpdateStaticObject after changing
+//one so that its chunk is recorded again.
+//
+//==========================================================================================================================
+		StaticLayerCache& GetStaticLayer(void) { return _staticLayer; }
+
+		void UpdateStaticObject(U32 id);
+
+//==========================================================================================================================
+//
+//Scene Index
+//
+//Every 2D object in the map is kept in a loose QuadTree by its bounds, for region, ray and nearest queries. The index is not
+//updated when an object moves on its own. Call UpdateSceneIndex for an object that has moved, or RefreshSceneIndex once a
+//frame to bring every object that is not static up to date.
+//
+//==========================================================================================================================
+		const QuadTree& GetSceneIndex(void) const { return _sceneIndex; }
+
+		void UpdateSceneIndex(U32 id);
+
+		void RefreshSceneIndex(void);
+
+//==========================================================================================================================
+//
+//Tile Collision
+//
+//The layer is the size of the TMX map, with cell 0, 0 the bottom left tile. Tiles are placed one tile in from the world
+//origin, and the layer's origin is set to match, so WorldToColumn and WorldToRow line up with the tile objects.
+//
+//==========================================================================================================================
+		TileCollisionLayer& GetCollisionLayer(void) { return _collisionLayer; }
+
+		PathfindingService& GetPathfinding(void) { return _pathfinding; }
+
+//==========================================================================================================================
+//
+//Hot Reload
+//
+//ReloadTMX parses the .tmx file again and only applies what is different from what is loaded. Tiles whose tile, type,
+//collision or size did not change keep their objects, and the state of those objects. Textures are only loaded again
+//if their image changed. A new map or tile size replaces every tile. Returns how many tiles were changed.
+//
+//EnableHotReload uses the FileWatcher to call ReloadTMX every time the file this map was imported from is saved.
+//
+//==========================================================================================================================
+		U32 ReloadTMX(string tmxFilePath = "");
+
+		void EnableHotReload(bool state);
+
+		bool GetHotReload(void) const { return _reloadWatch != 0; }
+
+//==========================================================================================================================
+//
+//Texture Atlas
+//
+//When this is on, which it is by default, Importer2D puts every tile image into the TextureAtlas instead of loading each one
+//as its own texture, so the whole tile set draws in a batch or two. It has to be set before the map is imported.
+//
+//==========================================================================================================================
+		void SetUseAtlas(bool state) { _useAtlas = state; }
+
+		bool GetUseAtlas(void) const { return _useAtlas; }
+
+//==========================================================================================================================
+//
+//Parallel Render
+//
+//With this on, RenderObjects hands the 2D objects to Renderer::RecordParallel in pieces of the render grain, so their v_Render
+//calls run on the JobPool. The frame draws the same as it does with it off. Only turn it on when every 2D object's v_Render
+//does nothing but submit its sprite, see Renderer::RecordParallel. The pieces only run on the JobPool with the Renderer's
+//queue turned on, which is off by default. 3D objects are always rendered on the calling thread.
+//
+//==========================================================================================================================
+		void SetParallelRender(bool state) { _parallelRender = state; }
+
+		bool GetParallelRender(void) const { return _parallelRender; }
+
+		void SetRenderGrain(U32 grain) { _renderGrain = grain == 0 ? 1 : grain; }
+
+		U32 GetRenderGrain(void) const { return _renderGrain; }
+
+//==========================================================================================================================
+//
+//Culling
+//
+//With culling on, RenderObjects only renders what overlaps the Camera's view rect. Static chunks are skipped by their
+//bounds. Every other 2D object has its bounds tested four at a time by the ViewCuller, as they can move every frame. With
+//SetCullWithSceneIndex the scene index is asked instead, which is faster on large maps, but only right if the index is kept
+//up to date, see Scene Index. Those objects are then rendered in ID order. An object is culled by its width and height, so
+//anything that draws outside of those, such as RenderText, should be left static or culling left off. 3D objects are not
+//culled, there is no 3D camera yet.
+//
+//GetCullStats returns what the last RenderObjects drew and skipped.
+//
+//==========================================================================================================================
+		void SetCulling(bool state) { _culling = state; }
+
+		bool GetCulling(void) const { return _culling; }
+
+		void SetCullWithSceneIndex(bool state) { _cullWithSceneIndex = state; }
+
+		bool GetCullWithSceneIndex(void) const { return _cullWithSceneIndex; }
+
+		const MapCullStats& GetCullStats(void) const { return _cullStats; }
+
 		void SetBackgroundColor(Col& c) { _bgColor = c; }
 		
 		void ActivateBackgroundColor(void) { Renderer::Instance()->SetBackgroundColor(_bgColor); }
@@ -143,11 +402,24 @@ namespace KillerEngine
 		
 		S32  GetMapHeight(void) const { return _mapHeight; }
 		
-		void SetMapWidth(S32 w)  { _mapWidth = w; }
+		void SetMapWidth(S32 w)  
+		{ 
+			_mapWidth = w; 
+			_ResizeSceneIndex();
+		}
 		
-		void SetMapHeight(S32 h) { _mapHeight = h; }
+		void SetMapHeight(S32 h) 
+		{ 
+			_mapHeight = h; 
+			_ResizeSceneIndex();
+		}
 		
-		void SetMapDimensions(S32 w, S32 h) { _mapWidth  = w; _mapHeight = h; }
+		void SetMapDimensions(S32 w, S32 h) 
+		{ 
+			_mapWidth  = w; 
+			_mapHeight = h; 
+			_ResizeSceneIndex();
+		}
 		
 		void SetTopBorder(S32 top) { _mapTopBorder = top; }
 
@@ -182,6 +454,8 @@ namespace KillerEngine
 
 		virtual ObjectType v_StringToTileData(string s);
 
+		virtual U8 v_StringToCollision(string s);
+
 	private:
 		S32 _mapWidth;
 		S32 _mapHeight;
@@ -191,11 +465,67 @@ namespace KillerEngine
 		S32 _mapLeftBorder;
 		Col _bgColor;
 		U32 _ID;
-		std::map<U32, GameObject2D*> _2DWorldObjects;
-		std::map<U32, GameObject3D*> _3DWorldObjects;
+		SlotMap<GameObject2D*> _2DWorldObjects;
+		SlotMap<GameObject3D*> _3DWorldObjects;
+		//=====Description=====
+		//Lookup from a GameObject ID to its handle in the slot map. IDs are
+		//shared by every map and never reused, so only the objects in this
+		//map are kept, and an entry is erased when its object is removed.
+		std::unordered_map<U32, SlotHandle> _2DHandles;
+		std::unordered_map<U32, SlotHandle> _3DHandles;
 		std::map<U32, TileData> _2DTileData;
+		MapCommandBuffer		_commands;
+		std::vector<MapCommand> _flushedCommands;
+		EntityManager			_entities;
+		SystemScheduler			_systems;
+		StaticLayerCache		_staticLayer;
+		QuadTree				_sceneIndex;
+		TileCollisionLayer		_collisionLayer;
+		PathfindingService		_pathfinding;
+		string 					_tmxPath;
+		MapData 				_mapData;
+		//=====Tile id, and the ID of the object made for it, for every cell of the layout=====
+		std::vector<S32> 		_layout;
+		std::vector<U32> 		_layoutObjects;
+		U32 					_reloadWatch;
+		bool 					_useAtlas;
+		bool 					_backgroundSimulation;
+		U32 					_tickDivisor;
+		U32 					_tickFrames;
+		F32 					_tickAccumulator;
+		F32 					_tickDelta;
+		bool 					_parallelRender;
+		U32 					_renderGrain;
+		bool 					_culling;
+		bool 					_cullWithSceneIndex;
+		ViewCuller 				_culler;
+		std::vector<GameObject2D*> _cullCandidates;
+		std::vector<U32> 		_cullResults;
+		std::vector<GameObject2D*> _visible2D;
+		MapCullStats 			_cullStats;
 
 		void _AddTile(TileData data);
+
+		void _Render2DObjects(U32 begin, U32 end);
+
+		void _CullObjects(const AABB2D& view);
+
+		bool _ParseTMX(string tmxFilePath, MapData& mapData, std::map<U32, TileData>& tiles, std::vector<S32>& layout);
+
+		void _TileCell(U32 index, U32& x, U32& y) const;
+
+		void _PlaceTile(U32 index);
+
+		void _RemoveTile(U32 index);
+
+		void _ResizeSceneIndex(void);
+
+		AABB2D _ObjectBounds(GameObject2D* obj) 
+		{ 
+			return AABB2D::FromCenter(obj->GetPosition().GetX(), obj->GetPosition().GetY(), obj->GetWidth(), obj->GetHeight()); 
+		}
+
+		void _PushCommand(MapCommandType type, U32 objectID, GameObject2D* obj2D, GameObject3D* obj3D);
 	};
 }//End namespace
 
@@ -0,0 +1,101 @@
+/*========================================================================
+A per-frame queue of structural changes to a Map. Anything that wants to
+add, remove, activate or move an object while the objects are being
+updated pushes a command here instead of changing the Map directly. The
+commands are applied all at once when the owner calls Flush(), which is
+the sync point for the frame. Nothing in the Map containers changes while
+the update is running, so updates can run on more than one thread.
+
+Push() is lock free and safe to call from any number of threads at once.
+Commands are kept in an intrusive stack that is pushed with a single
+compare and swap. The nodes come from a pool that is handed out with an
+atomic counter, and if the pool runs out for a frame the extra nodes are
+allocated on their own and the pool is grown to fit at the next Flush().
+
+Flush() must only be called when no other thread is pushing. It applies
+the commands in the same order they were pushed.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef MAP_COMMAND_BUFFER_H
+#define MAP_COMMAND_BUFFER_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+
+//=====STL includes=====
+#include <vector>
+#include <atomic>
+
+namespace KillerEngine
+{
+	//=====Forward declarations=====
+	class GameObject2D;
+	class GameObject3D;
+
+	enum MapCommandType
+	{
+		MC_ADD_2D,
+		MC_ADD_3D,
+		MC_REMOVE_2D,
+		MC_REMOVE_3D,
+		MC_ACTIVATE_2D,
+		MC_DEACTIVATE_2D,
+		MC_ACTIVATE_3D,
+		MC_DEACTIVATE_3D,
+		MC_MOVE_2D,
+		MC_MOVE_3D
+	};
+
+	struct MapCommand
+	{
+		MapCommandType type;
+		U32 		   mapID;
+		U32 		   targetMapID;
+		U32 		   objectID;
+		GameObject2D*  obj2D;
+		GameObject3D*  obj3D;
+		MapCommand*    next;
+	};
+
+	class MapCommandBuffer
+	{
+	public:
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+		MapCommandBuffer(void);
+
+		explicit MapCommandBuffer(U32 capacity);
+
+		~MapCommandBuffer(void);
+
+//==========================================================================================================================
+//
+//MapCommandBuffer Functions
+//
+//==========================================================================================================================
+		void Push(const MapCommand& command);
+
+		void Flush(std::vector<MapCommand>& out);
+
+		bool Empty(void) const { return _head.load(std::memory_order_acquire) == NULL; }
+
+		U32 GetCapacity(void) const { return (U32)_pool.size(); }
+
+	private:
+		std::vector<MapCommand>  _pool;
+		std::atomic<U32> 		 _poolNext;
+		std::atomic<MapCommand*> _head;
+
+		MapCommandBuffer(const MapCommandBuffer&);
+		MapCommandBuffer& operator=(const MapCommandBuffer&);
+	};
+}//End namespace
+
+#endif
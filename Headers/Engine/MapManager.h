@@ -21,9 +21,15 @@ Written by Maxwell Miller
 #include <Engine/Map.h>
 #include <Engine/GameObject2D.h>
 #include <Engine/ErrorManager.h>
+#include <Engine/MapCommandBuffer.h>
+#include <Engine/JobPool.h>
+#include <Engine/Timer.h>
 
 //=====STL includes=====
 #include <map>
+#include <vector>
+
+namespace KM = KillerMath;
 
 namespace KillerEngine 
 {
@@ -60,10 +66,42 @@ namespace KillerEngine
 
 		void Remove3DObjectFromMap(U32 worldID, U32 ojbId);
 
+//==========================================================================================================================
+//
+//Deferred Changes
+//
+//Queued versions of the functions above, plus moving an object from one map to another. They are lock free and can be 
+//called from any thread during the update. Everything queued is applied by FlushCommands, which Update calls once all the
+//maps have been updated.
+//
+//==========================================================================================================================
+		void DeferAddObjectToMap(U32 id, GameObject2D* obj);
+
+		void DeferAddObjectToMap(U32 id, GameObject3D* obj);
+
+		void DeferRemove2DObjectFromMap(U32 worldID, U32 objID);
+
+		void DeferRemove3DObjectFromMap(U32 worldID, U32 objID);
+
+		void DeferSet2DObjectActive(U32 worldID, U32 objID, bool active);
+
+		void DeferSet3DObjectActive(U32 worldID, U32 objID, bool active);
+
+		void DeferMove2DObject(U32 fromWorldID, U32 toWorldID, U32 objID);
+
+		void DeferMove3DObject(U32 fromWorldID, U32 toWorldID, U32 objID);
+
+		void FlushCommands(void);
+
 //==========================================================================================================================
 //
 //Integrators
 //
+//Update runs the active map on the calling thread every frame. Every other map that has background simulation turned on is
+//updated as its own job on the JobPool, once every tick divisor frames, while the active map runs. Once every map is done
+//the deferred commands are flushed, and then the path requests of every map that was updated are answered. Only the active
+//map is ever rendered.
+//
 //==========================================================================================================================
 
 		void Update(void);
@@ -71,7 +109,7 @@ namespace KillerEngine
 		void Render(void);
 
 	protected:
-		MapManager(void) : _running(true) {  }
+		MapManager(void) : _activeMap(NULL), _activeMapID(0), _running(true) {  }
 
 	private:
 		std::map<U32, Map*>    _worlds;
@@ -79,6 +117,13 @@ namespace KillerEngine
 		U32 				   _activeMapID;
 		bool				   _running;			
 		static MapManager*     _instance;
+		MapCommandBuffer	   _commands;
+		std::vector<MapCommand> _flushedCommands;
+		std::vector<Map*>	   _tickedMaps;
+
+		void _PushCommand(MapCommandType type, U32 worldID, U32 targetWorldID, U32 objID, GameObject2D* obj2D, GameObject3D* obj3D);
+
+		void _MoveObject(const MapCommand& command);
 
 	};
 
@@ -0,0 +1,116 @@
+/*========================================================================
+The ParticleBuffer2D holds a lot of small square sprites that are not
+GameObjects, such as sparks or smoke, one array per field instead of one
+object per particle. A particle system updates the arrays in place with
+GetX, GetY, GetSize, GetColors and GetFrames, and hands the whole buffer
+to Renderer::AddParticles once a frame.
+
+	x, y	the center, in world space. Every particle shares one z,
+			set with SetDepth.
+	size	the full width and height.
+	color	packed the same way as SpriteVertex, see PackColor.
+	frame	an index into the buffer's table of texture rects. Frames
+			are added with AddFrame, and frame 0 is the whole texture
+			until one is added.
+
+Pack writes particles into SpriteVertex in one pass. Sizes are turned
+into half floats four at a time with SSE2, which gives the same result as
+SpriteVertex::FloatToHalf, and the rest is copied. A frame index that is
+not in the table is drawn with frame 0.
+
+Remove moves the last particle into the hole, so the order is not kept.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef PARTICLE_BUFFER_2D_H
+#define PARTICLE_BUFFER_2D_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/SpriteVertex.hpp>
+
+//=====STL includes=====
+#include <vector>
+#include <cstring>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define KILLER_PARTICLE_SSE
+#include <emmintrin.h>
+#endif
+
+namespace KillerEngine
+{
+	class ParticleBuffer2D
+	{
+	public:
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+		ParticleBuffer2D(void);
+
+//==========================================================================================================================
+//
+//ParticleBuffer2D Functions
+//
+//==========================================================================================================================
+		U32 Add(F32 x, F32 y, F32 size, const Col& color, U16 frame = 0);
+
+		void Remove(U32 index);
+
+		void Clear(void);
+
+		void Reserve(U32 count);
+
+		//=====Returns the index to give to a particle=====
+		U16 AddFrame(F32 bottom, F32 top, F32 left, F32 right);
+
+		void ClearFrames(void);
+
+		void Pack(SpriteVertex* vertices, U32 first, U32 count) const;
+
+		static U32 PackColor(const Col& color)
+		{
+			return SpriteVertex::PackUnorm8(color.GetRed()) | (SpriteVertex::PackUnorm8(color.GetGreen()) << 8) |
+				   (SpriteVertex::PackUnorm8(color.GetBlue()) << 16) | (SpriteVertex::PackUnorm8(color.GetAlpha()) << 24);
+		}
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+		U32 GetCount(void) const { return (U32)_x.size(); }
+
+		U32 GetFrameCount(void) const { return (U32)_frames.size() / 4; }
+
+		void SetDepth(F32 z) { _z = z; }
+
+		F32 GetDepth(void) const { return _z; }
+
+		F32* GetX(void) { return _x.empty() ? NULL : &_x[0]; }
+
+		F32* GetY(void) { return _y.empty() ? NULL : &_y[0]; }
+
+		F32* GetSize(void) { return _size.empty() ? NULL : &_size[0]; }
+
+		U32* GetColors(void) { return _color.empty() ? NULL : &_color[0]; }
+
+		U16* GetFrames(void) { return _frame.empty() ? NULL : &_frame[0]; }
+
+	private:
+		std::vector<F32> _x;
+		std::vector<F32> _y;
+		std::vector<F32> _size;
+		std::vector<U32> _color;
+		std::vector<U16> _frame;
+		std::vector<U16> _frames;
+		F32 			 _z;
+	};
+}//End namespace
+
+#endif
@@ -0,0 +1,181 @@
+/*========================================================================
+The PathfindingService is where units ask for paths over a Map's tile
+grid. Each Map owns one, pointed at its TileCollisionLayer.
+
+RequestPath queues a request and hands back a ticket. Requests are worked
+on in ProcessRequests, which the MapManager calls once a frame. It splits
+the queue over the JobPool, each worker with its own GridSearch, and stops
+starting new requests once the time budget for the frame is used up. What
+is left over waits for the next frame. Poll GetStatus with the ticket, and
+collect the path with TakePath once it is done. RequestPath, TakePath and
+ProcessRequests should all be called from the game thread.
+
+Finished paths are cached by the region the start is in and the goal
+tile. A later request from the same region to the same goal only has to
+search from its start to the nearest point on the cached path, which is
+very short, and then follows the cached path the rest of the way. Paths
+found that way are not always the shortest, but they are close, and when
+hundreds of units head to the same place that is what happens most.
+
+Flow fields are cached by goal. GetFlowField builds one on the calling
+thread the first time it is asked for.
+
+Every cache is thrown away when the collision layer's version changes.
+
+A start or goal that is off the grid is never searched. RequestPath
+hands back a ticket that is already PS_NOT_FOUND, FindPathNow returns
+false and GetFlowField returns NULL.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef PATHFINDING_SERVICE_H
+#define PATHFINDING_SERVICE_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/ErrorManager.h>
+#include <Engine/TileCollisionLayer.h>
+#include <Engine/GridSearch.h>
+#include <Engine/FlowField.h>
+#include <Engine/JobPool.h>
+
+//=====STL includes=====
+#include <map>
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+namespace KillerEngine
+{
+	enum PathAlgorithm
+	{
+		PA_ASTAR,
+		PA_JPS
+	};
+
+	enum PathStatus
+	{
+		PS_NONE,
+		PS_PENDING,
+		PS_FOUND,
+		PS_NOT_FOUND
+	};
+
+	class PathfindingService
+	{
+	public:
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+		PathfindingService(void);
+
+		~PathfindingService(void);
+
+//==========================================================================================================================
+//
+//PathfindingService Functions
+//
+//==========================================================================================================================
+		void SetGrid(const TileCollisionLayer* layer);
+
+		U32 RequestPath(GridPoint start, GridPoint goal, PathAlgorithm algorithm = PA_JPS);
+
+		void CancelRequest(U32 ticket);
+
+		PathStatus GetStatus(U32 ticket) const;
+
+		bool TakePath(U32 ticket, std::vector<GridPoint>& out);
+
+		void ProcessRequests(void);
+
+		bool FindPathNow(GridPoint start, GridPoint goal, PathAlgorithm algorithm, std::vector<GridPoint>& out);
+
+		const FlowField* GetFlowField(GridPoint goal);
+
+		void ClearCache(void);
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+		void SetBlockingFlags(U8 flags) { _blocking = flags; ClearCache(); }
+
+		U8 GetBlockingFlags(void) const { return _blocking; }
+
+		void SetTimeBudget(F32 milliseconds) { _budget = milliseconds; }
+
+		F32 GetTimeBudget(void) const { return _budget; }
+
+		void SetRegionSize(U32 tiles) { _regionSize = tiles == 0 ? 1 : tiles; ClearCache(); }
+
+		U32 GetRegionSize(void) const { return _regionSize; }
+
+		U32 GetPendingCount(void) const { return (U32)_pending.size(); }
+
+		U32 GetCacheHits(void) const { return _cacheHits.load(); }
+
+		U32 GetCacheMisses(void) const { return _cacheMisses.load(); }
+
+	private:
+		struct PathRequest
+		{
+			U32 		  ticket;
+			GridPoint 	  start;
+			GridPoint 	  goal;
+			PathAlgorithm algorithm;
+		};
+
+		struct PathResult
+		{
+			PathStatus 			   status;
+			std::vector<GridPoint> path;
+		};
+
+		struct WorkItem
+		{
+			PathRequest 		   request;
+			bool 				   done;
+			bool 				   found;
+			std::vector<GridPoint> path;
+		};
+
+		const TileCollisionLayer* 		  _layer;
+		U8 								  _blocking;
+		F32 							  _budget;
+		U32 							  _regionSize;
+		U32 							  _nextTicket;
+		U32 							  _cacheVersion;
+		std::deque<PathRequest> 		  _pending;
+		std::map<U32, PathResult> 		  _results;
+		std::vector<WorkItem> 			  _working;
+		std::vector<GridSearch*> 		  _searches;
+		std::map<U64, std::vector<GridPoint>> _pathCache;
+		std::map<U32, FlowField*> 		  _flowFields;
+		std::mutex 						  _cacheLock;
+		std::atomic<U32> 				  _cacheHits;
+		std::atomic<U32> 				  _cacheMisses;
+
+		bool _Solve(GridSearch& search, const PathRequest& request, std::vector<GridPoint>& out);
+
+		void _CheckVersion(void);
+
+		U64 _CacheKey(GridPoint start, GridPoint goal) const;
+
+		bool _InGrid(GridPoint point) const;
+
+		GridSearch* _GetSearch(U32 index);
+
+		PathfindingService(const PathfindingService&);
+		PathfindingService& operator=(const PathfindingService&);
+	};
+}//End namespace
+
+#endif
@@ -0,0 +1,170 @@
+/*========================================================================
+A loose quadtree over 2D bounds, used by the Map as a scene index so that
+region queries do not have to walk every object. It is built for a lot of
+items that rarely move, like tiles and environment objects, and for the
+kinds of questions editors, AI perception and camera culling ask.
+
+Loose means every node's bounds are twice the size of its cell. An item
+goes into the deepest node whose cell holds the item's center and whose
+half size is at least as big as the item. Finding that node is a short
+walk down from the root, and an item never has to be split across nodes.
+Nodes are only created when something is put into them, and every node
+keeps a count of the items under it so empty branches are skipped.
+
+Items are identified by a U32, which for the Map is the GameObject ID.
+Items outside of the world bounds are kept in the root, which is always
+checked, so they are still found, just not quickly.
+
+Queries are read only, and can be made from more than one thread as long
+as nothing is being inserted, removed or moved at the same time.
+QueryBatch runs a list of queries spread across the JobPool.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef QUAD_TREE_H
+#define QUAD_TREE_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/ErrorManager.h>
+#include <Engine/AABB2D.hpp>
+#include <Engine/JobPool.h>
+
+//=====STL includes=====
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <cmath>
+
+namespace KillerEngine
+{
+	enum QuadTreeQueryType
+	{
+		QT_POINT,
+		QT_RECT,
+		QT_RAY,
+		QT_NEAREST
+	};
+
+	struct QuadTreeHit
+	{
+		U32 id;
+		F32 distance;
+	};
+
+	struct QuadTreeQuery
+	{
+		QuadTreeQueryType  type;
+		AABB2D 			   rect;
+		Vec2 			   point;
+		Vec2 			   direction;
+		F32 			   maxDistance;
+		U32 			   count;
+		//=====Filled in by QueryBatch. Ray and nearest results are closest first=====
+		std::vector<U32>   results;
+
+		QuadTreeQuery(void) : type(QT_POINT), rect(), point(), direction(), maxDistance(0.0f), count(0), results() {  }
+	};
+
+	class QuadTree
+	{
+	public:
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+		QuadTree(void);
+
+		QuadTree(const AABB2D& worldBounds, U32 maxDepth);
+
+//==========================================================================================================================
+//
+//QuadTree Functions
+//
+//==========================================================================================================================
+		void SetWorldBounds(const AABB2D& worldBounds);
+
+		void SetMaxDepth(U32 depth);
+
+		void Insert(U32 id, const AABB2D& bounds);
+
+		void Remove(U32 id);
+
+		void Move(U32 id, const AABB2D& bounds);
+
+		bool Contains(U32 id) const { return id < _itemIndex.size() && _itemIndex[id] != NO_INDEX; }
+
+		void Clear(void);
+
+		U32 GetItemCount(void) const { return (U32)_items.size(); }
+
+		U32 GetNodeCount(void) const { return (U32)_nodes.size(); }
+
+//==========================================================================================================================
+//
+//Queries
+//
+//==========================================================================================================================
+		void QueryPoint(F32 x, F32 y, std::vector<U32>& out) const;
+
+		void QueryRect(const AABB2D& rect, std::vector<U32>& out) const;
+
+		void QueryRay(const Vec2& origin, const Vec2& direction, F32 maxDistance, std::vector<QuadTreeHit>& out) const;
+
+		void QueryNearest(F32 x, F32 y, U32 count, std::vector<QuadTreeHit>& out) const;
+
+		void QueryBatch(std::vector<QuadTreeQuery>& queries) const;
+
+	private:
+		static const S32 NO_INDEX = -1;
+
+		struct Node
+		{
+			F32 centerX;
+			F32 centerY;
+			F32 halfSize;
+			S32 parent;
+			S32 firstChild;
+			S32 firstItem;
+			U32 total;
+			U32 depth;
+		};
+
+		struct Item
+		{
+			AABB2D bounds;
+			U32    id;
+			S32    node;
+			S32    prev;
+			S32    next;
+		};
+
+		AABB2D 			  _worldBounds;
+		U32 			  _maxDepth;
+		std::vector<Node> _nodes;
+		std::vector<Item> _items;
+		std::vector<S32>  _itemIndex;
+
+		void _ResetRoot(void);
+
+		S32 _FindNode(const AABB2D& bounds);
+
+		void _Link(S32 item, S32 node);
+
+		void _Unlink(S32 item);
+
+		void _SplitNode(S32 node);
+
+		AABB2D _LooseBounds(const Node& node) const
+		{
+			F32 size = node.halfSize * 2;
+			return AABB2D(node.centerX - size, node.centerY - size, node.centerX + size, node.centerY + size);
+		}
+	};
+}//End namespace
+
+#endif
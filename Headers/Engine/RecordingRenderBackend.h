@@ -0,0 +1,113 @@
+/*========================================================================
+A RenderBackend that never calls OpenGL. Every batch the Renderer flushes
+is copied into a RecordedBatch along with the shader and texture that were
+bound for it, and every switch is counted. Give one to Renderer::SetBackend
+before anything is drawn to run the renderer with no window.
+
+SetKeepData(false) keeps only the counters and the shader, texture and
+size of each batch, which is what you want when profiling submission and
+do not care about the vertex data.
+
+SaveToFile writes what has been recorded as plain text, one line per
+batch, then one line per sprite when the data was kept, so that two runs
+can be compared with a diff.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef RECORDING_RENDER_BACKEND_H
+#define RECORDING_RENDER_BACKEND_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/RenderBackend.h>
+#include <Engine/ErrorManager.h>
+
+//=====STL includes=====
+#include <vector>
+#include <fstream>
+
+namespace KillerEngine
+{
+	struct RecordedBatch
+	{
+		GLuint 			 shader;
+		U32 			 textureID;
+		U32 			 count;
+		bool 			 isStatic;
+		GLuint 			 vertexArray;
+		bool 					  textured;
+		bool 					  instanced;
+		std::vector<SpriteVertex> vertices;
+	};
+
+	struct RenderCounters
+	{
+		U32 batches;
+		U32 staticDraws;
+		U32 sprites;
+		U32 shaderSwitches;
+		U32 textureSwitches;
+		U32 frames;
+	};
+
+	class RecordingRenderBackend : public RenderBackend
+	{
+	public:
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+		RecordingRenderBackend(void);
+
+		~RecordingRenderBackend(void) {  }
+
+//==========================================================================================================================
+//
+//Virtual Functions
+//
+//==========================================================================================================================
+		void v_UseShader(GLuint shader);
+
+		void v_BindTexture(U32 textureID);
+
+		void v_DrawBatch(const RenderBatch& batch);
+
+		void v_DrawStatic(GLuint vertexArray, U32 count, bool blend, bool instanced);
+
+		void v_EndFrame(void) { ++_counters.frames; }
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+		void SetKeepData(bool state) { _keepData = state; }
+
+		bool GetKeepData(void) const { return _keepData; }
+
+		const std::vector<RecordedBatch>& GetBatches(void) const { return _batches; }
+
+		U32 GetBatchCount(void) const { return (U32)_batches.size(); }
+
+		const RenderCounters& GetCounters(void) const { return _counters; }
+
+		void Reset(void);
+
+		bool SaveToFile(string path) const;
+
+	private:
+		std::vector<RecordedBatch> _batches;
+		RenderCounters 			   _counters;
+		GLuint 					   _shader;
+		U32 					   _textureID;
+		bool 					   _keepData;
+
+		RecordedBatch& _NewBatch(U32 count, bool isStatic, GLuint vertexArray);
+	};
+}//End namespace
+
+#endif
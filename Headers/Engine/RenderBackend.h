@@ -0,0 +1,91 @@
+/*========================================================================
+A RenderBackend is what the Renderer hands its work to once it has been
+batched. The Renderer decides when a batch is flushed and when the shader
+or texture changes, the backend decides what that means.
+
+GLRenderBackend is the normal one, and makes the OpenGL calls. The
+RecordingRenderBackend makes no GL calls at all, it keeps a copy of every
+batch so that the batching can be tested and profiled on a machine with
+no GPU or window.
+
+The vertices in a RenderBatch belong to the Renderer, and are only good
+until the call returns. textured is set when any sprite in the batch was
+given a texture, and means the batch is drawn with blending. instanced
+is set when the shader for the batch builds its quads from a unit quad
+and one instance per sprite, instead of expanding points in a geometry
+shader. See Renderer::SetSpritePath.
+
+v_BeginFrame and v_EndFrame are called around everything the Renderer
+draws in a frame, for backends that want to time or count frames.
+
+v_GetBatchCapacity is the most sprites the backend would like in one
+batch, worked out from its buffers. 0 means it has no limit of its own,
+and the Renderer sizes its batch as if for a GLRenderBackend. v_Finish
+waits until everything submitted so far has been drawn, and is only used
+to time things.
+
+v_IsDeferred is true for a backend that only records the frame, to be 
+drawn on another thread, such as the RenderThread. While one is in use
+nothing else may make GL calls on the thread that is submitting.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef RENDER_BACKEND_H
+#define RENDER_BACKEND_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/SpriteVertex.hpp>
+
+//=====OGL includes=====
+#include <GL/gl.h>
+
+namespace KillerEngine
+{
+	struct RenderBatch
+	{
+		const SpriteVertex* vertices;
+		U32 				count;
+		bool 				textured;
+		bool 				instanced;
+	};
+
+	class RenderBackend
+	{
+	public:
+		virtual ~RenderBackend(void) {  }
+
+//==========================================================================================================================
+//
+//Virtual Functions
+//
+//==========================================================================================================================
+		//=====Called once when the backend is given to the Renderer=====
+		virtual void v_Init(void) {  }
+
+		virtual void v_UseShader(GLuint shader)=0;
+
+		virtual void v_BindTexture(U32 textureID)=0;
+
+		virtual void v_DrawBatch(const RenderBatch& batch)=0;
+
+		virtual void v_DrawStatic(GLuint vertexArray, U32 count, bool blend, bool instanced)=0;
+
+		virtual void v_BindDefaultVertexArray(void) {  }
+
+		virtual void v_BeginFrame(void) {  }
+
+		virtual void v_EndFrame(void) {  }
+
+		virtual bool v_IsDeferred(void) const { return false; }
+
+		virtual U32 v_GetBatchCapacity(void) const { return 0; }
+
+		virtual void v_Finish(void) {  }
+	};
+}//End namespace
+
+#endif
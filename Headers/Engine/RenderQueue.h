@@ -0,0 +1,124 @@
+/*========================================================================
+The RenderQueue holds every sprite submitted to the Renderer during a
+frame, so that they can be drawn sorted by material instead of in the
+order they were given. It is only used once Renderer::SetQueueEnabled
+has turned it on.
+
+Each sprite gets a 64 bit sort key, from the top bit down:
+
+	layer		8 bits	drawn from low to high
+	shader		12 bits
+	texture		16 bits
+	depth		28 bits	position z, drawn from low to high
+
+Sort is an LSD radix sort on the keys, 8 bits a pass, that skips any pass
+where every key has the same byte. It is stable, so sprites with the same
+key are drawn in the order they were added. After sorting, every sprite
+that shares a shader and texture inside of a layer sits next to the
+others, and the Renderer draws each run as one batch.
+
+Draw order is only kept between layers. Sprites in one layer that must
+be drawn over others in it with a different texture need their own layer,
+or a larger z.
+
+Shader IDs above 4095 and texture IDs above 65535 still draw correctly,
+as the real IDs are kept with each sprite, but they share key space with
+smaller IDs and may split into extra batches.
+
+The arrays never shrink, and Clear only resets the count, so once the
+queue has held a frame it can hold the next one of the same size without
+touching the heap. Add writes straight into the next slot and doubles
+every array together when it runs out. Reserve grows them ahead of time,
+and GetGrowthCount counts every time they grew, for finding frames that
+still grow them. It only counts the queue's own arrays, not every trip
+to the heap.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/SpriteVertex.hpp>
+
+//=====STL includes=====
+#include <vector>
+#include <cstring>
+#include <utility>
+
+namespace KillerEngine
+{
+	struct QueuedSprite
+	{
+		SpriteVertex vertex;
+		GLuint 		 shader;
+		U32 		 textureID;
+		bool 		 textured;
+	};
+
+	class RenderQueue
+	{
+	public:
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+		RenderQueue(void);
+
+//==========================================================================================================================
+//
+//RenderQueue Functions
+//
+//==========================================================================================================================
+		void Add(U8 layer, GLuint shader, U32 textureID, bool textured, const SpriteVertex& vertex);
+
+		void AddRange(U8 layer, GLuint shader, U32 textureID, bool textured, const SpriteVertex* vertices, U32 count);
+
+		void Sort(void);
+
+		void Clear(void);
+
+		void Reserve(U32 count);
+
+		//=====Adds every sprite in other after the ones already here, in its current order, keeping their keys=====
+		void Append(const RenderQueue& other);
+
+		static U64 MakeKey(U8 layer, GLuint shader, U32 textureID, F32 depth);
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+		U32 Size(void) const { return _count; }
+
+		bool Empty(void) const { return _count == 0; }
+
+		U32 GetCapacity(void) const { return (U32)_items.size(); }
+
+		U32 GetGrowthCount(void) const { return _growths; }
+
+		//=====In sorted order once Sort has been called=====
+		const QueuedSprite& Get(U32 index) const { return _items[_order[index]]; }
+
+		U64 GetKey(U32 index) const { return _keys[index]; }
+
+	private:
+		std::vector<QueuedSprite> _items;
+		std::vector<U64> 		  _keys;
+		std::vector<U32> 		  _order;
+		std::vector<U64> 		  _keysTemp;
+		std::vector<U32> 		  _orderTemp;
+		U32 					  _count;
+		U32 					  _growths;
+
+		void _Grow(U32 capacity);
+	};
+}//End namespace
+
+#endif
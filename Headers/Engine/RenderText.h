@@ -6,6 +6,14 @@ track of all the character data and the texture for the font.
 It is considered a GameObject2D, and when adding it to the work it should
 be treated as any other GameObject2D.
 
+The layout is only worked out when the text, font or scale changes. Each
+character is kept as a small GlyphQuad, where it sits from the origin of
+the text and where it is on the font texture, and the whole run is packed
+into SpriteVertex's and handed to the Renderer in one AddToBatch. Moving
+the text or changing its color only packs the vertices again, and setting
+the same text again does nothing, so text that does not change costs no
+heap allocations from one frame to the next.
+
 This is not free to use, and cannot be used without the express permission
 of KillerWave.
 
@@ -19,6 +27,7 @@ Written by Maxwell Miller
 #include <Engine/GameObject2D.h>
 #include <Engine/Font.h>
 #include <Engine/CharSprite.h>
+#include <Engine/Renderer.h>
 
 //=====STL includes=====
 #include <vector>
@@ -65,13 +74,13 @@ namespace KillerEngine
 
 		void SetTextColor(Col& col);
 
-		void SetWidthScaleFactor(F32 w) { _widthScaleFactor = w; }
+		void SetWidthScaleFactor(F32 w) { _widthScaleFactor = w; _layoutDirty = true; }
 
-		void SetHeightScaleFactor(F32 h) { _heightScaleFactor = h; }
+		void SetHeightScaleFactor(F32 h) { _heightScaleFactor = h; _layoutDirty = true; }
 
-		void SetScaleFactors(const F32 w, const F32 h) { _widthScaleFactor = w; _heightScaleFactor = h; }
+		void SetScaleFactors(const F32 w, const F32 h) { _widthScaleFactor = w; _heightScaleFactor = h; _layoutDirty = true; }
 
-		void SetFont(Font& font) { _font = font; }
+		void SetFont(Font& font) { _font = font; _layoutDirty = true; }
 
 		F32 GetTotalWidth(void) { return _totalWidth; }
 
@@ -79,15 +88,39 @@ namespace KillerEngine
 
 		Vec2& GetCenter(void) { return _center; }
 
+		U32 GetGlyphCount(void) const { return (U32)_glyphs.size(); }
+
 	private:
-		string _text;
-		Font   _font;
-		std::vector<CharSprite*> _spriteList;
-		F32 _widthScaleFactor;
-		F32 _heightScaleFactor;
-		F32 _totalWidth;
-		F32 _totalHeight;
-		Vec2 _center;	
+		struct GlyphQuad
+		{
+			F32 x;
+			F32 y;
+			F32 halfWidth;
+			F32 halfHeight;
+			F32 bottom;
+			F32 top;
+			F32 left;
+			F32 right;
+		};
+
+		string 					  _text;
+		Font   					  _font;
+		std::vector<GlyphQuad> 	  _glyphs;
+		std::vector<SpriteVertex> _vertices;
+		U32 					  _textureID;
+		Vec2 					  _origin;
+		Col 					  _color;
+		F32 					  _widthScaleFactor;
+		F32 					  _heightScaleFactor;
+		F32 					  _totalWidth;
+		F32 					  _totalHeight;
+		Vec2 					  _center;
+		bool 					  _layoutDirty;
+		bool 					  _verticesDirty;
+
+		void _Layout(void);
+
+		void _PackVertices(void);
 	};
 }
 
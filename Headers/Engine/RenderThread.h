@@ -0,0 +1,209 @@
+/*========================================================================
+The RenderThread moves the GL calls off the thread that runs the game.
+Once Start is called it becomes the Renderer's backend, and everything
+the Renderer would have drawn in a frame is written into a snapshot
+instead: the shader and texture changes, a copy of every batch, the
+Camera translation and the background colour as they were when the frame
+began. EndFrame hands the snapshot to a thread of its own, which holds
+the GL context, draws it with a GLRenderBackend and swaps the buffers,
+while the game goes on to update the next frame.
+
+There are two or three snapshots, set with SetBufferCount before Start.
+SetMaxFramesAhead is how many finished frames may wait to be drawn before
+the game is made to wait for the render thread, 1 keeps the input lag to
+a single frame. SetDropLateFrames(true) never makes the game wait, the
+oldest frame that has not been drawn yet is thrown away instead, so what
+is drawn is always the newest frame. This needs three buffers to do any
+good.
+
+GetStats returns how many frames were submitted, drawn and dropped since
+Start, and how long, in milliseconds, each side spent waiting on the
+other. A game that is waiting a lot on the render thread is GPU bound.
+
+While the thread is running the game must not make any GL calls of its
+own. Load every texture, font and map before Start, and Stop before
+destroying a map or loading something new. The StaticLayerCache notices
+the Renderer is deferred and hands its vertices to the Renderer each
+frame instead of drawing its own buffers. Stop draws every frame that
+is waiting and gives the context back to the calling thread. A frame
+that was only part written is drawn there with the normal backend, and
+the rest of it is drawn after it as usual.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef RENDER_THREAD_H
+#define RENDER_THREAD_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/RenderBackend.h>
+#include <Engine/GLRenderBackend.h>
+#include <Engine/Renderer.h>
+#include <Engine/Camera.h>
+#include <Engine/WinProgram.h>
+#include <Engine/GLStateCache.h>
+#include <Engine/ShaderRegistry.h>
+#include <Engine/ErrorManager.h>
+
+//=====STL includes=====
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+namespace KillerEngine
+{
+	struct RenderThreadStats
+	{
+		U32 framesSubmitted;
+		U32 framesDrawn;
+		U32 framesDropped;
+		F64 simWaitMs;
+		F64 renderWaitMs;
+	};
+
+	class RenderThread : public RenderBackend
+	{
+	public:
+		~RenderThread(void);
+
+//==========================================================================================================================
+//
+//Singleton Functions
+//
+//==========================================================================================================================
+		static RenderThread* Instance(void);
+
+		void Start(void);
+
+		void Stop(void);
+
+		bool IsRunning(void) const { return _running; }
+
+//==========================================================================================================================
+//
+//Virtual Functions
+//
+//==========================================================================================================================
+		void v_UseShader(GLuint shader);
+
+		void v_BindTexture(U32 textureID);
+
+		void v_DrawBatch(const RenderBatch& batch);
+
+		void v_DrawStatic(GLuint vertexArray, U32 count, bool blend, bool instanced);
+
+		void v_BindDefaultVertexArray(void);
+
+		void v_BeginFrame(void);
+
+		void v_EndFrame(void);
+
+		bool v_IsDeferred(void) const { return true; }
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+		void SetBufferCount(U32 count);
+
+		U32 GetBufferCount(void) const { return _bufferCount; }
+
+		void SetMaxFramesAhead(U32 frames) { _maxFramesAhead = frames == 0 ? 1 : frames; }
+
+		U32 GetMaxFramesAhead(void) const { return _maxFramesAhead; }
+
+		void SetDropLateFrames(bool state) { _dropLateFrames = state; }
+
+		bool GetDropLateFrames(void) const { return _dropLateFrames; }
+
+		RenderThreadStats GetStats(void);
+
+		void ResetStats(void);
+
+	protected:
+//==========================================================================================================================
+//
+//Constructor
+//
+//==========================================================================================================================
+		RenderThread(void);
+
+	private:
+		static const U32 _MAX_BUFFERS = 3;
+
+		enum CommandType
+		{
+			RC_USE_SHADER,
+			RC_BIND_TEXTURE,
+			RC_DRAW_BATCH,
+			RC_DRAW_STATIC,
+			RC_BIND_DEFAULT
+		};
+
+		enum SnapshotState
+		{
+			SS_FREE,
+			SS_WRITING,
+			SS_READY,
+			SS_DRAWING
+		};
+
+		//=====first is into the snapshot's vertices for a batch, and the vertex array for a static draw=====
+		struct RenderCommand
+		{
+			CommandType type;
+			GLuint 		id;
+			U32 		first;
+			U32 		count;
+			bool 		textured;
+			bool 		instanced;
+		};
+
+		struct RenderSnapshot
+		{
+			std::vector<RenderCommand> commands;
+			std::vector<SpriteVertex>  vertices;
+			Matrix 					   view;
+			U32 					   viewVersion;
+			GLfloat 				   clearColor[4];
+			SnapshotState 			   state;
+		};
+
+		static RenderThread* 	 _instance;
+		RenderSnapshot 			 _snapshots[_MAX_BUFFERS];
+		U32 					 _bufferCount;
+		U32 					 _maxFramesAhead;
+		bool 					 _dropLateFrames;
+		std::deque<U32> 		 _ready;
+		S32 					 _writing;
+		GLuint 					 _lastShader;
+		U32 					 _lastTexture;
+		std::thread 			 _thread;
+		std::mutex 				 _lock;
+		std::condition_variable  _signal;
+		bool 					 _running;
+		bool 					 _stopping;
+		RenderThreadStats 		 _stats;
+
+		RenderSnapshot& _GetSnapshot(void);
+
+		void _Acquire(void);
+
+		void _Publish(void);
+
+		void _AddCommand(CommandType type, GLuint id, U32 first, U32 count, bool textured, bool instanced);
+
+		void _ThreadLoop(void);
+
+		void _Replay(RenderBackend& backend, const RenderSnapshot& snapshot);
+	};
+}//End namespace
+
+#endif
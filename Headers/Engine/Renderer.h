@@ -11,8 +11,60 @@ AddTri()
 AddSqr()
 AddHex()
 
-These take the position of a cell, then create F32 Vecs, storing them in an std::vector, which is 
-passed to OGL during the Draw().  
+These take the position of a cell, then pack it into a SpriteVertex, stored in an array that is 
+made once at the size of a batch, which is passed to OGL during the Draw().  
+
+Sprites are drawn in the order they are added, with a flush every time the shader or texture 
+changes. SetQueueEnabled(true) puts them into a RenderQueue for the frame instead, and Draw sorts 
+them by layer, shader and texture, so every sprite that can share a batch does. Sorted sprites in
+one layer are no longer drawn in the order they were added, so with blending a character can end 
+up under the tiles it stands on. A game that turns the queue on must use SetLayer to keep one group
+of sprites drawn over another, such as tiles, then objects, then text. The layer is applied to 
+everything added after it is set.
+
+The GL calls themselves are made by a RenderBackend. The Renderer uses a GLRenderBackend unless 
+SetBackend is given another one, such as a RecordingRenderBackend to run with no GPU. The backend
+is not owned by the Renderer, and is set up the first time it is used, so the Renderer makes no
+GL calls of its own.
+
+SetSpritePath picks how square and character sprites are turned into quads. SP_POINTS sends one 
+point per sprite and expands it in a geometry shader, SP_INSTANCED draws a unit quad once per 
+sprite with the sprite data stepped per instance, which is much faster on drivers that are slow 
+with geometry shaders. Set it once at init, before any sprites are made, so only the programs for 
+that path are compiled. A sprite that has an instanced program registers it with 
+RegisterInstancedShader, which is how the Renderer knows how to draw a batch. TriSprite has no
+instanced program yet and always uses points.
+
+BeginFrame and EndFrame go around everything drawn in a frame, so the backend can time it. EndFrame
+also grows the RenderQueue to the most it held in the frame, plus an eighth, so the next frame is 
+built without touching the heap. GetFrameStats returns the counts for the last finished frame. 
+bufferGrowths is how many times the queue and the command lists grew in it, and should be 0 once a 
+game has settled. It is not a count of every trip to the heap, only of the Renderer's own arrays.
+
+AddParticles draws a whole ParticleBuffer2D. The particles are packed straight into the batch 
+array, as many batches as it takes, with no call per particle. Like DrawStatic, everything already
+submitted is drawn first and the particles do not go through the queue, so they are drawn over what
+came before them and under what comes after, whatever the layer. It may not be called from inside
+RecordParallel.
+
+The most sprites in one batch is worked out from the backend, as many as fit in one region of the
+GLRenderBackend's StreamBuffer, which is tens of thousands. SetMaxBatchSize overrides it, and 0 
+goes back to working it out. Set it at init, as changing it draws whatever is waiting first. 
+CalibrateBatchSize draws a test frame of sprites with every power of two batch size from 256 up to
+that limit, waits on the GPU after each, and keeps the fastest. The sprites are zero sized, so 
+nothing shows on screen. GetCalibrationResults has the time, in milliseconds, for every size tried.
+It must be run on the thread with the GL context, between frames, and not while the RenderThread 
+is running.
+
+RecordParallel lets sprites be submitted from the JobPool. The range is split into grain sized 
+pieces, and anything submitted while a piece runs goes into a command list for that piece instead
+of the frame's RenderQueue. The lists are added to the queue in order once every piece is done, so
+the frame sorts and draws exactly as if it had been submitted on one thread. The same job, made 
+once with the Renderer, is given to each worker and takes pieces until none are left, so nothing is
+built per frame. Only AddToBatch may be called from inside a piece. SetLayer, SetShader, SetTexture,
+Draw and anything else that changes the Renderer must stay on the calling thread, and every sprite 
+shader must already be compiled, as there is no GL context on the workers. With the queue turned 
+off, which is the default, the range is run on the calling thread.
 
 This is not free to use, and cannot be used without the express permission
 of KillerWave. 
@@ -30,6 +82,11 @@ Written by Maxwell Miller
 #include <Engine/Texture.hpp>
 #include <Engine/ErrorManager.h>
 #include <Engine/Camera.h>
+#include <Engine/RenderBackend.h>
+#include <Engine/GLRenderBackend.h>
+#include <Engine/RenderQueue.h>
+#include <Engine/JobPool.h>
+#include <Engine/ParticleBuffer2D.h>
 
 //=====OGL includes=====
 #include <GL/gl.h>
@@ -42,6 +99,9 @@ Written by Maxwell Miller
 
 //=====STL Includes=====
 #include <vector>
+#include <functional>
+#include <atomic>
+#include <chrono>
 
 namespace KillerEngine 
 {
@@ -49,6 +109,26 @@ namespace KillerEngine
 	//=====Foreward delcaration=====
 	class Sprite;
 
+	enum SpritePath
+	{
+		SP_POINTS = 0,
+		SP_INSTANCED
+	};
+
+	struct RenderFrameStats
+	{
+		U32 sprites;
+		U32 batches;
+		U32 highWater;
+		U32 bufferGrowths;
+	};
+
+	struct BatchSizeResult
+	{
+		U32 batchSize;
+		F64 frameTime;
+	};
+
 	class Renderer 
 	{
 	public:
@@ -81,11 +161,56 @@ namespace KillerEngine
 		
 		void AddToBatch(const GLuint shader, Vec2& pos, F32 w, F32 h, Col& c, U32 textureID, Vec2& origin, Vec2& limit);
 
-		void AddToBatch(std::vector<F32> v, std::vector<F32> c);
+		//=====Vertices that are already packed, all with one shader and texture, such as a line of text=====
+		void AddToBatch(const GLuint shader, U32 textureID, const SpriteVertex* vertices, U32 count);
 
-		void AddTextureToBatch(std::vector<F32> v, std::vector<F32> uv);
-		
 		void Draw(void);
+
+		void SetLayer(U8 layer) { _layer = layer; }
+
+		U8 GetLayer(void) const { return _layer; }
+
+		void SetQueueEnabled(bool state);
+
+		bool GetQueueEnabled(void) const { return _queueEnabled; }
+
+		void SetShader(const GLuint shader);
+
+		void SetTexture(U32 textureID);
+
+		void DrawStatic(const GLuint shader, U32 textureID, GLuint vertexArray, U32 count);
+
+		void AddParticles(const GLuint shader, U32 textureID, const ParticleBuffer2D& particles);
+
+		void BindDefaultVertexArray(void) { _GetBackend()->v_BindDefaultVertexArray(); }
+
+		void SetBackend(RenderBackend* backend);
+
+		RenderBackend* GetBackend(void) { return _backend; }
+
+		void SetSpritePath(SpritePath path);
+
+		SpritePath GetSpritePath(void) const { return _spritePath; }
+
+		void RegisterInstancedShader(GLuint shader);
+
+		bool IsInstancedShader(GLuint shader) const;
+
+		void BeginFrame(void) { _GetBackend()->v_BeginFrame(); }
+
+		void EndFrame(void);
+
+		const RenderFrameStats& GetFrameStats(void) const { return _lastFrameStats; }
+
+		void RecordParallel(U32 count, U32 grain, const std::function<void(U32 begin, U32 end)>& record);
+
+		void SetMaxBatchSize(U32 sprites);
+
+		U32 GetMaxBatchSize(void) const { return _maxBatchSize; }
+
+		U32 CalibrateBatchSize(GLuint shader, U32 sprites, U32 frames);
+
+		const std::vector<BatchSizeResult>& GetCalibrationResults(void) const { return _calibrationResults; }
 		
 	protected:
 //==========================================================================================================================
@@ -98,17 +223,38 @@ namespace KillerEngine
 	private:
 		static Renderer* 	 _instance;
 		U32 				 _maxBatchSize;
+		U32 				 _batchSizeOverride;
+		std::vector<BatchSizeResult> _calibrationResults;
 		U32 				 _currentBatchSize;
-		std::vector<F32> 	 _vertices;
-		std::vector<F32> 	 _colors;
-		std::vector<F32> 	 _dimensions;
-		std::vector<F32> 	 _bottomTop;
-		std::vector<F32>     _leftRight;	
+		std::vector<SpriteVertex> _batch;
+		SpriteVertex* 		 _batchData;
+		bool 				 _batchTextured;
+		RenderQueue 		 _queue;
+		bool 				 _queueEnabled;
+		U8 					 _layer;
+		RenderFrameStats 	 _frameStats;
+		RenderFrameStats 	 _lastFrameStats;
+		U32 				 _frameGrowthBase;
+		std::vector<RenderQueue> _commandLists;
+		U32 				 _commandListGrowths;
+		static thread_local RenderQueue* _threadCommandList;
+		std::function<void(void)> _recordJob;
+		const std::function<void(U32, U32)>* _record;
+		U32 				 _recordCount;
+		U32 				 _recordGrain;
+		U32 				 _recordPieces;
+		std::atomic<U32> 	 _nextRecordPiece;
 		GLuint				 _renderingProgramColor;
 		GLuint   			 _renderingProgramTexture;
-		GLuint   			 _vertexArrayObject;
+		GLRenderBackend 	 _glBackend;
+		RenderBackend* 		 _backend;
+		bool 				 _backendReady;
+		SpritePath 			 _spritePath;
+		std::vector<GLuint>  _instancedShaders;
+		bool 				 _currentInstanced;
 		
 		GLuint 				 _currentShader;
+		U32 				 _currentTextureID;
 		static const GLchar* _vertexShaderSourceColor[];
 		static const GLchar* _vertexShaderSourceTexture[];
 		static const GLchar* _fragmentShaderSourceColor[];
@@ -120,6 +266,35 @@ namespace KillerEngine
 //
 //==========================================================================================================================
 		void _SetOrthoProjection(void);
+
+		U32 _GetGrowthCount(void) const;
+
+		void _RecordPieces(void);
+
+		void _Submit(GLuint shader, U32 textureID, bool textured, const SpriteVertex& vertex);
+
+		void _DrawQueue(void);
+
+		void _DrawBatch(void);
+
+		void _AddSprite(const SpriteVertex& vertex, bool textured);
+
+		U32 _GetBackendBatchSize(void);
+
+		void _ResizeBatch(U32 sprites);
+
+		SpriteVertex _Pack(Vec2& pos, F32 w, F32 h, Col& c, F32 bottom, F32 top, F32 left, F32 right);
+
+		RenderBackend* _GetBackend(void)
+		{
+			if(!_backendReady)
+			{
+				_backend->v_Init();
+				_backendReady = true;
+			}
+
+			return _backend;
+		}
 	};
 
 }//End namespace
@@ -0,0 +1,153 @@
+/*========================================================================
+The ShaderRegistry is where every sprite program is built. A program is
+known by a hash of its sources, so asking for the same sources twice, from
+any class, gives back the same program.
+
+Request starts a program building and returns without waiting for it.
+The shaders for every request are compiled and linked back to back, and
+the driver is free to do that on its own threads. When the driver has
+GL_KHR_parallel_shader_compile it is told to use as many as it likes, and
+IsReady can be used to check on a program without stalling. Finish waits
+for one program and checks it, GetProgram is Request and Finish together.
+KillerEngine2D::Init requests every sprite program, so they are built
+while the game loads instead of on the first frame each one is drawn.
+
+SetCacheDirectory turns on the program binary cache. Every program that
+links is saved there with glGetProgramBinary, under its hash, along with
+the vendor, renderer and version strings of the driver that made it. The
+next time it is requested the binary is loaded instead of compiled, as
+long as the driver strings are the same and the driver takes it. Anything
+else is compiled from source and saved again. The directory must exist.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef SHADER_REGISTRY_H
+#define SHADER_REGISTRY_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/ErrorManager.h>
+#include <Engine/GLStateCache.h>
+
+//=====OGL includes=====
+#include <GL/gl.h>
+
+//=====STL includes=====
+#include <map>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+
+//=====Not in the gl3w headers=====
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+namespace KillerEngine
+{
+	struct ShaderRegistryStats
+	{
+		U32 programs;
+		U32 duplicates;
+		U32 compiled;
+		U32 binaryLoads;
+		U32 binaryRejects;
+		U32 binarySaves;
+	};
+
+	class ShaderRegistry
+	{
+	public:
+//==========================================================================================================================
+//
+//Singleton Functions
+//
+//==========================================================================================================================
+		static ShaderRegistry* Instance(void);
+
+		void ShutDown(void);
+
+//==========================================================================================================================
+//
+//ShaderRegistry Functions
+//
+//==========================================================================================================================
+		//=====geometry can be NULL. The sources are kept, and must outlive the registry=====
+		U64 Request(const GLchar* vertex, const GLchar* geometry, const GLchar* fragment, string name);
+
+		GLuint Finish(U64 key);
+
+		void FinishAll(void);
+
+		bool IsReady(U64 key);
+
+		GLuint GetProgram(const GLchar* vertex, const GLchar* geometry, const GLchar* fragment, string name);
+
+		static U64 HashSources(const GLchar* vertex, const GLchar* geometry, const GLchar* fragment);
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+		void SetCacheDirectory(string path);
+
+		string GetCacheDirectory(void) const { return _cacheDirectory; }
+
+		const ShaderRegistryStats& GetStats(void) const { return _stats; }
+
+	protected:
+//==========================================================================================================================
+//
+//Constructor
+//
+//==========================================================================================================================
+		ShaderRegistry(void);
+
+	private:
+		struct ShaderEntry
+		{
+			string 		  name;
+			const GLchar* vertex;
+			const GLchar* geometry;
+			const GLchar* fragment;
+			GLuint 		  program;
+			GLuint 		  shaders[3];
+			bool 		  fromBinary;
+			bool 		  finished;
+		};
+
+		typedef void (APIENTRY *MaxCompilerThreadsProc)(GLuint count);
+
+		static ShaderRegistry* 		_instance;
+		std::map<U64, ShaderEntry> _entries;
+		string 						_cacheDirectory;
+		string 						_driver;
+		bool 						_parallelChecked;
+		bool 						_parallelCompile;
+		ShaderRegistryStats 		_stats;
+
+		void _CheckParallel(void);
+
+		void _Compile(ShaderEntry& entry);
+
+		GLuint _CompileStage(GLenum stage, const GLchar* source);
+
+		bool _LoadBinary(U64 key, ShaderEntry& entry);
+
+		void _SaveBinary(U64 key, const ShaderEntry& entry);
+
+		string _GetDriver(void);
+
+		string _GetCachePath(U64 key) const;
+
+		void _ReportLinkError(const ShaderEntry& entry);
+	};
+}//End namespace
+
+#endif
@@ -0,0 +1,75 @@
+/*========================================================================
+The SkylinePacker places rectangles into a fixed size page, as low as they
+will go. It only keeps the top edge of what has been placed, the skyline,
+as a list of flat segments, so a rect is never put under an overhang. That
+wastes a little space next to MaxRects, but it is far simpler and fast
+enough to run at load time.
+
+Rects pack tightest when they are inserted tallest first.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef SKYLINE_PACKER_H
+#define SKYLINE_PACKER_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+
+//=====STL includes=====
+#include <vector>
+
+namespace KillerEngine
+{
+	class SkylinePacker
+	{
+	public:
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+		SkylinePacker(void);
+
+		SkylinePacker(U32 width, U32 height);
+
+//==========================================================================================================================
+//
+//SkylinePacker Functions
+//
+//==========================================================================================================================
+		void Init(U32 width, U32 height);
+
+		bool Insert(U32 width, U32 height, U32& x, U32& y);
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+		U32 GetWidth(void) const { return _width; }
+
+		U32 GetHeight(void) const { return _height; }
+
+		U64 GetUsedArea(void) const { return _usedArea; }
+
+	private:
+		struct Segment
+		{
+			S32 x;
+			S32 y;
+			S32 width;
+		};
+
+		U32 				 _width;
+		U32 				 _height;
+		U64 				 _usedArea;
+		std::vector<Segment> _skyline;
+
+		S32 _Fit(U32 index, U32 width, U32 height) const;
+	};
+}//End namespace
+
+#endif
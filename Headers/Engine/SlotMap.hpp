@@ -0,0 +1,196 @@
+/*========================================================================
+A slot map is a container that keeps all of its values packed together in
+one contiguous array, so that iterating over everything in it is a straight
+walk through memory, while still handing out stable handles that can be
+used to find a value again later.
+
+Add and Remove are both O(1). Removing a value moves the last value in the
+dense array into the hole that was left, so the order of the values is not
+kept. Do not rely on the order of iteration.
+
+Each SlotHandle holds an index into the slot table and a generation. Every
+time a slot is freed its generation is increased, so a handle that was given
+out before the value was removed will no longer match the slot, and Get()
+will return NULL instead of a different value that reused the slot. A
+generation of 0 is never used, so a default SlotHandle is always invalid.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef SLOT_MAP_HPP
+#define SLOT_MAP_HPP
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+
+//=====STL includes=====
+#include <vector>
+
+namespace KillerEngine
+{
+	struct SlotHandle
+	{
+		U32 index;
+		U32 generation;
+
+		SlotHandle(void) : index(0), generation(0) {  }
+
+		SlotHandle(U32 i, U32 g) : index(i), generation(g) {  }
+
+		bool IsValid(void) const { return generation != 0; }
+
+		bool operator==(const SlotHandle& h) const { return index == h.index && generation == h.generation; }
+
+		bool operator!=(const SlotHandle& h) const { return !(*this == h); }
+	};
+
+	template<typename T>
+	class SlotMap
+	{
+	private:
+		struct Slot
+		{
+			//=====Description=====
+			//While the slot is in use this is the index of the value in
+			//the dense array. While it is free it is the next free slot.
+			U32 denseIndex;
+			U32 generation;
+		};
+
+		static const U32 _endOfFreeList = 0xFFFFFFFF;
+
+		std::vector<T>    _dense;
+		std::vector<U32>  _denseToSlot;
+		std::vector<Slot> _slots;
+		U32 			  _freeHead;
+
+	public:
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+		SlotMap(void) : _dense(), _denseToSlot(), _slots(), _freeHead(_endOfFreeList) {  }
+
+//==========================================================================================================================
+//
+//SlotMap Functions
+//
+//==========================================================================================================================
+		SlotHandle Add(const T& value)
+		{
+			U32 slotIndex;
+
+			if(_freeHead != _endOfFreeList)
+			{
+				slotIndex = _freeHead;
+				_freeHead = _slots[slotIndex].denseIndex;
+			}
+			else
+			{
+				slotIndex = (U32)_slots.size();
+
+				Slot slot;
+				slot.denseIndex = 0;
+				slot.generation = 1;
+				_slots.push_back(slot);
+			}
+
+			_slots[slotIndex].denseIndex = (U32)_dense.size();
+			_dense.push_back(value);
+			_denseToSlot.push_back(slotIndex);
+
+			return SlotHandle(slotIndex, _slots[slotIndex].generation);
+		}
+
+		bool Remove(SlotHandle handle)
+		{
+			if(!Contains(handle)) { return false; }
+
+			U32 hole = _slots[handle.index].denseIndex;
+			U32 last = (U32)_dense.size() - 1;
+
+			//=====Move the last value into the hole=====
+			if(hole != last)
+			{
+				_dense[hole] = _dense[last];
+				_denseToSlot[hole] = _denseToSlot[last];
+				_slots[_denseToSlot[hole]].denseIndex = hole;
+			}
+
+			_dense.pop_back();
+			_denseToSlot.pop_back();
+
+			//=====Retire the slot=====
+			Slot& slot = _slots[handle.index];
+			++slot.generation;
+			if(slot.generation == 0) { slot.generation = 1; }
+
+			slot.denseIndex = _freeHead;
+			_freeHead = handle.index;
+
+			return true;
+		}
+
+		bool Contains(SlotHandle handle) const
+		{
+			return handle.generation != 0 &&
+				   handle.index < _slots.size() &&
+				   _slots[handle.index].generation == handle.generation;
+		}
+
+		T* Get(SlotHandle handle)
+		{
+			if(!Contains(handle)) { return NULL; }
+
+			return &_dense[_slots[handle.index].denseIndex];
+		}
+
+		void Clear(void)
+		{
+			while(!_dense.empty())
+			{
+				Remove(GetHandleAt((U32)_dense.size() - 1));
+			}
+		}
+
+		void Reserve(U32 size)
+		{
+			_dense.reserve(size);
+			_denseToSlot.reserve(size);
+			_slots.reserve(size);
+		}
+
+//==========================================================================================================================
+//
+//Dense Accessors
+//
+//These are here for iterating over every value. The index is an index into the dense array, not a handle, and it is only
+//valid until the next Add or Remove.
+//
+//==========================================================================================================================
+		U32 Size(void) const { return (U32)_dense.size(); }
+
+		bool Empty(void) const { return _dense.empty(); }
+
+		T& operator[](U32 denseIndex) { return _dense[denseIndex]; }
+
+		const T& operator[](U32 denseIndex) const { return _dense[denseIndex]; }
+
+		SlotHandle GetHandleAt(U32 denseIndex) const
+		{
+			U32 slotIndex = _denseToSlot[denseIndex];
+			return SlotHandle(slotIndex, _slots[slotIndex].generation);
+		}
+
+		T* Data(void) { return _dense.empty() ? NULL : &_dense[0]; }
+
+		typename std::vector<T>::iterator begin(void) { return _dense.begin(); }
+
+		typename std::vector<T>::iterator end(void) { return _dense.end(); }
+	};
+}//End namespace
+
+#endif
@@ -28,6 +28,7 @@ Written by Maxwell Miller
 #include <Engine/Texture.hpp>
 #include <Engine/Renderer.h>
 #include <Engine/ErrorManager.h>
+#include <Engine/TextureAtlas.h>
 
 //=====OGL includes=====
 #include <GL/gl.h>
@@ -117,11 +118,19 @@ namespace KillerEngine
 //==========================================================================================================================
 		virtual void v_RenderSprite(void)=0;
 		
+		//=====If the texture is in the TextureAtlas, its page and rect on the page are used instead=====
 		virtual void SetTexture(U32 tID, const F32 top, const F32 bottom, const F32 right, const F32 left)
 		{
+			F32 atlasTop = top;
+			F32 atlasBottom = bottom;
+			F32 atlasRight = right;
+			F32 atlasLeft = left;
+
+			TextureAtlas::Instance()->Remap(tID, atlasBottom, atlasTop, atlasLeft, atlasRight);
+
 			textureID = tID;
-			_bottomTop = Vec2(bottom, top);
-			_leftRight  = Vec2(left, right);
+			_bottomTop = Vec2(atlasBottom, atlasTop);
+			_leftRight  = Vec2(atlasLeft, atlasRight);
 		}
 
 		virtual GLuint v_GetShader(void)=0;
@@ -0,0 +1,189 @@
+/*========================================================================
+The vertex the sprite shaders read, one per sprite, packed down to 28
+bytes from the 56 it takes as plain floats.
+
+	position	3 floats, w is always 1 in the shader
+	color		4 unsigned bytes, normalized
+	halfSize	2 half floats
+	uvs			4 unsigned shorts, normalized. The first two are the
+				bottom and top of the texture rect, the last two the
+				left and right. Attribute 3 reads the first pair and
+				attribute 4 the second, so the shaders did not change.
+
+Pack builds a whole vertex at once so the Renderer can write each sprite
+with a single store. SetAttributes points attributes 0 to 4 at an array
+of SpriteVertex in the bound GL_ARRAY_BUFFER, starting at offset bytes.
+SetDivisor sets how often those attributes step. 0 is once per vertex,
+for the point path, 1 is once per instance, for the instanced quads.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef SPRITE_VERTEX_HPP
+#define SPRITE_VERTEX_HPP
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+
+//=====STL includes=====
+#include <cstring>
+#include <cstddef>
+
+namespace KillerEngine
+{
+	struct SpriteVertex
+	{
+		F32 position[3];
+		U32 color;
+		U16 halfSize[2];
+		U16 uvs[4];
+
+//==========================================================================================================================
+//
+//Packing
+//
+//==========================================================================================================================
+		static SpriteVertex Pack(F32 x, F32 y, F32 z, F32 r, F32 g, F32 b, F32 a, F32 halfWidth, F32 halfHeight, 
+								 F32 bottom, F32 top, F32 left, F32 right)
+		{
+			SpriteVertex vertex;
+			vertex.position[0] = x;
+			vertex.position[1] = y;
+			vertex.position[2] = z;
+			vertex.color = PackUnorm8(r) | (PackUnorm8(g) << 8) | (PackUnorm8(b) << 16) | (PackUnorm8(a) << 24);
+			vertex.halfSize[0] = FloatToHalf(halfWidth);
+			vertex.halfSize[1] = FloatToHalf(halfHeight);
+			vertex.uvs[0] = PackUnorm16(bottom);
+			vertex.uvs[1] = PackUnorm16(top);
+			vertex.uvs[2] = PackUnorm16(left);
+			vertex.uvs[3] = PackUnorm16(right);
+
+			return vertex;
+		}
+
+		static U32 PackUnorm8(F32 value)
+		{
+			if(value <= 0.0f) { return 0; }
+			if(value >= 1.0f) { return 255; }
+
+			return (U32)(value * 255.0f + 0.5f);
+		}
+
+		static U16 PackUnorm16(F32 value)
+		{
+			if(value <= 0.0f) { return 0; }
+			if(value >= 1.0f) { return 65535; }
+
+			return (U16)(value * 65535.0f + 0.5f);
+		}
+
+		//=====Rounds to the nearest half, ties to even. Too large becomes infinity=====
+		static U16 FloatToHalf(F32 value)
+		{
+			U32 bits;
+			memcpy(&bits, &value, sizeof(bits));
+
+			U32 sign = (bits >> 16) & 0x8000;
+			U32 rawExponent = (bits >> 23) & 0xFF;
+			U32 mantissa = bits & 0x007FFFFF;
+			S32 exponent = (S32)rawExponent - 127 + 15;
+
+			if(rawExponent == 0xFF) { return (U16)(sign | 0x7C00 | (mantissa != 0 ? 0x200 : 0)); }
+
+			if(exponent >= 31) { return (U16)(sign | 0x7C00); }
+
+			if(exponent <= 0)
+			{
+				if(exponent < -10) { return (U16)sign; }
+
+				mantissa |= 0x00800000;
+				U32 shift = (U32)(14 - exponent);
+				U32 half = mantissa >> shift;
+				U32 rest = mantissa & ((1u << shift) - 1);
+				U32 halfway = 1u << (shift - 1);
+
+				if(rest > halfway || (rest == halfway && (half & 1))) { ++half; }
+
+				return (U16)(sign | half);
+			}
+
+			U32 half = sign | ((U32)exponent << 10) | (mantissa >> 13);
+			U32 rest = mantissa & 0x1FFF;
+
+			//=====A carry out of the mantissa moves up the exponent, which is what we want=====
+			if(rest > 0x1000 || (rest == 0x1000 && (half & 1))) { ++half; }
+
+			return (U16)half;
+		}
+
+		static F32 HalfToFloat(U16 half)
+		{
+			U32 sign = ((U32)half & 0x8000) << 16;
+			U32 exponent = (half >> 10) & 0x1F;
+			U32 mantissa = half & 0x3FF;
+			U32 bits;
+
+			if(exponent == 0)
+			{
+				F32 value = (F32)mantissa / 1024.0f / 16384.0f;
+				return sign != 0 ? -value : value;
+			}
+			else if(exponent == 31)
+			{
+				bits = sign | 0x7F800000 | (mantissa << 13);
+			}
+			else
+			{
+				bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+			}
+
+			F32 value;
+			memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+//==========================================================================================================================
+//
+//Unpacking
+//
+//==========================================================================================================================
+		F32 GetColor(U32 channel) const { return (F32)((color >> (channel * 8)) & 0xFF) / 255.0f; }
+
+		F32 GetHalfSize(U32 axis) const { return HalfToFloat(halfSize[axis]); }
+
+		F32 GetUV(U32 index) const { return (F32)uvs[index] / 65535.0f; }
+
+//==========================================================================================================================
+//
+//Layout
+//
+//==========================================================================================================================
+		static void SetAttributes(size_t offset)
+		{
+			GLsizei stride = sizeof(SpriteVertex);
+
+			glEnableVertexAttribArray(0);
+			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (const void*)(offset + offsetof(SpriteVertex, position)));
+			glEnableVertexAttribArray(1);
+			glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (const void*)(offset + offsetof(SpriteVertex, color)));
+			glEnableVertexAttribArray(2);
+			glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride, (const void*)(offset + offsetof(SpriteVertex, halfSize)));
+			glEnableVertexAttribArray(3);
+			glVertexAttribPointer(3, 2, GL_UNSIGNED_SHORT, GL_TRUE, stride, (const void*)(offset + offsetof(SpriteVertex, uvs)));
+			glEnableVertexAttribArray(4);
+			glVertexAttribPointer(4, 2, GL_UNSIGNED_SHORT, GL_TRUE, stride, (const void*)(offset + offsetof(SpriteVertex, uvs) + sizeof(U16) * 2));
+		}
+
+		static void SetDivisor(GLuint divisor)
+		{
+			for(GLuint i = 0; i < 5; ++i)
+			{
+				glVertexAttribDivisor(i, divisor);
+			}
+		}
+	};
+}//End namespace
+
+#endif
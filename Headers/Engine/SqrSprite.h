@@ -49,6 +49,7 @@ Written by Maxwell Miller
 //=====Engine Includes=====
 #include <Engine/Atom.h>
 #include <Engine/Sprite.h>
+#include <Engine/ShaderRegistry.h>
 #include <Engine/Texture.hpp>
 #include <Engine/TextureManager.h>
 
@@ -77,11 +78,19 @@ namespace KillerEngine
 
 		void v_InitShader(void);
 
+		//=====Starts the program for the current sprite path building, without waiting for it=====
+		static void RequestShaders(void);
+
 	private:
 		static GLuint _shaderProgram;
+		static GLuint _instancedProgram;
 		static const GLchar* _vertexShaderSource[];
 		static const GLchar* _geometryShaderSource[];
 		static const GLchar* _fragmentShaderSource[];
+		static const GLchar* _instancedVertexSource[];
+		static const GLchar* _instancedFragmentSource[];
+
+		void _InitInstancedShader(void);
 	};
 }
 
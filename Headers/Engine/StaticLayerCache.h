@@ -0,0 +1,166 @@
+/*========================================================================
+The StaticLayerCache holds the vertex data for GameObject2Ds that never
+move, like background tiles and EnvironmentObjects, so that they do not
+have to go through Renderer::AddToBatch every frame.
+
+Static objects are sorted into square chunks of the world by position.
+Each chunk keeps one GPU buffer for every shader and texture pair in it,
+recorded once and left on the GPU. Rendering the cache is one draw call
+per buffer. A chunk is only recorded again when an object is added to it,
+removed from it, or marked dirty.
+
+The vertex data is the same as what the Renderer builds for a batch, one
+SpriteVertex per sprite, so the same sprite shaders are used for both.
+
+Render can be given a view rectangle, and then only the chunks whose
+bounds overlap it are drawn. A chunk's bounds cover every object in it,
+and are worked out when it is recorded. GetCulledCount is how many chunks
+the last Render skipped.
+
+While the Renderer has a deferred backend, such as the RenderThread, the
+cache makes no GL calls. Each chunk keeps its packed vertices and hands
+them to Renderer::AddToBatch instead, so they are sorted and batched with
+everything else that frame.
+
+The cache does not own the objects. If a static object is changed after
+it is added, call MarkDirty so its chunk is recorded again. A chunk is
+erased, along with its buffers, once its last object is removed.
+
+Objects are packed from their Sprite's position, size, colour, UVs and
+shader, and their own v_Render is never called. A static object must not
+override v_Render to draw anything more, or anything different. An
+object that does has to stay out of the cache and be rendered each frame.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef STATIC_LAYER_CACHE_H
+#define STATIC_LAYER_CACHE_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/ErrorManager.h>
+#include <Engine/GameObject2D.h>
+#include <Engine/Sprite.h>
+#include <Engine/Renderer.h>
+#include <Engine/SpriteVertex.hpp>
+#include <Engine/AABB2D.hpp>
+
+//=====STL includes=====
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+//=====OGL includes=====
+#include <GL/gl.h>
+
+namespace KillerEngine
+{
+	class StaticLayerCache
+	{
+	public:
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+		StaticLayerCache(void);
+
+		~StaticLayerCache(void);
+
+//==========================================================================================================================
+//
+//StaticLayerCache Functions
+//
+//==========================================================================================================================
+		void Add(GameObject2D* obj);
+
+		void Remove(GameObject2D* obj);
+
+		bool Contains(U32 id) const { return _objectChunks.find(id) != _objectChunks.end(); }
+
+		void MarkDirty(GameObject2D* obj);
+
+		void MarkAllDirty(void);
+
+		void Clear(void);
+
+		void Render(void);
+
+		void Render(const AABB2D& view);
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+		void SetChunkSize(F32 size);
+
+		F32 GetChunkSize(void) const { return _chunkSize; }
+
+		U32 GetChunkCount(void) const { return (U32)_chunks.size(); }
+
+		U32 GetObjectCount(void) const { return (U32)_objectChunks.size(); }
+
+		U32 GetDrawCount(void) const { return _drawCount; }
+
+		U32 GetRebuildCount(void) const { return _rebuildCount; }
+
+		U32 GetCulledCount(void) const { return _culledCount; }
+
+	private:
+		struct StaticBatch
+		{
+			GLuint shader;
+			U32    textureID;
+			GLuint vertexArray;
+			GLuint buffer;
+			U32    first;
+			U32    count;
+			U32    capacity;
+		};
+
+		struct StaticChunk
+		{
+			std::vector<GameObject2D*> objects;
+			std::vector<StaticBatch>   batches;
+			std::vector<SpriteVertex>  vertices;
+			AABB2D 					   bounds;
+			bool 					   dirty;
+		};
+
+		F32 							_chunkSize;
+		std::map<U64, StaticChunk> 		_chunks;
+		std::map<U32, U64> 				_objectChunks;
+		std::vector<GameObject2D*> 		_sorted;
+		U32 							_drawCount;
+		U32 							_rebuildCount;
+		U32 							_culledCount;
+		bool 							_deferred;
+
+		void _Render(const AABB2D* view);
+
+		U64 _ChunkKey(GameObject2D* obj) const;
+
+		AABB2D _Bounds(GameObject2D* obj) const
+		{
+			return AABB2D::FromCenter(obj->GetPosition().GetX(), obj->GetPosition().GetY(), obj->GetWidth(), obj->GetHeight());
+		}
+
+		void _Rebuild(StaticChunk& chunk, bool upload);
+
+		bool _EraseIfEmpty(std::map<U64, StaticChunk>::iterator chunk, bool deferred);
+
+		void _CreateBatch(StaticBatch& batch);
+
+		void _DeleteBatch(StaticBatch& batch);
+
+		StaticLayerCache(const StaticLayerCache&);
+		StaticLayerCache& operator=(const StaticLayerCache&);
+	};
+}//End namespace
+
+#endif
@@ -0,0 +1,115 @@
+/*========================================================================
+The StreamBuffer is a ring of GPU memory for vertex data that is written
+once and drawn once, like the Renderer's batches. It is made once and
+never grows, so nothing is allocated by the driver while a frame is drawn.
+
+The buffer is split into regions, three by default. Writes move through
+a region, and when one is full a fence is placed behind it and writing
+moves on to the next. Before a region is written again its fence is
+waited on, so the GPU is never reading what is being written. With three
+regions the wait almost never blocks.
+
+If glBufferStorage is there, the buffer is mapped once, persistent and
+coherent, and Reserve hands back a pointer straight into it. If it is not,
+each Reserve maps just the range it needs with glMapBufferRange, and the
+whole buffer is orphaned instead of fenced when the ring wraps. Either
+way, call Commit once the data is written and before it is drawn.
+
+A single Reserve can not be larger than a region.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef STREAM_BUFFER_H
+#define STREAM_BUFFER_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/ErrorManager.h>
+
+//=====STL includes=====
+#include <vector>
+
+//=====OGL includes=====
+#include <GL/gl.h>
+
+namespace KillerEngine
+{
+	struct StreamBufferStats
+	{
+		U64 bytesWritten;
+		U32 reserves;
+		U32 regionSwitches;
+		U32 fenceWaits;
+		U32 orphans;
+	};
+
+	class StreamBuffer
+	{
+	public:
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+		StreamBuffer(void);
+
+		~StreamBuffer(void);
+
+//==========================================================================================================================
+//
+//StreamBuffer Functions
+//
+//==========================================================================================================================
+		bool Init(GLenum target, U32 regionSize, U32 regionCount = 3);
+
+		void ShutDown(void);
+
+		void* Reserve(U32 bytes, U32& offset);
+
+		void Commit(void);
+
+		void Bind(void) { glBindBuffer(_target, _buffer); }
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+		//=====Only used by the next Init=====
+		void SetAllowPersistent(bool state) { _allowPersistent = state; }
+
+		bool GetPersistent(void) const { return _persistent; }
+
+		GLuint GetBuffer(void) const { return _buffer; }
+
+		U32 GetRegionSize(void) const { return _regionSize; }
+
+		U32 GetRegionCount(void) const { return (U32)_fences.size(); }
+
+		const StreamBufferStats& GetStats(void) const { return _stats; }
+
+		void ResetStats(void);
+
+	private:
+		GLenum 				_target;
+		GLuint 				_buffer;
+		U8* 				_mapped;
+		U32 				_regionSize;
+		U32 				_region;
+		U32 				_cursor;
+		bool 				_persistent;
+		bool 				_allowPersistent;
+		bool 				_rangeMapped;
+		std::vector<GLsync> _fences;
+		StreamBufferStats 	_stats;
+
+		void _NextRegion(void);
+
+		void _WaitForRegion(U32 region);
+	};
+}//End namespace
+
+#endif
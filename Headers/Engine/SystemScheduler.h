@@ -0,0 +1,73 @@
+/*========================================================================
+The SystemScheduler runs a list of EntitySystems over an EntityManager,
+using the JobPool to spread the work over every core.
+
+Systems are put into stages. A system goes into the first stage that comes
+after every earlier system it conflicts with, so two systems that both
+write Position2D always run in the order they were added, while a system
+that only touches Velocity2D can run alongside either of them. Inside of a
+stage every matching chunk of every system is its own job.
+
+Main thread only systems still go into a stage by the same rule, but their
+chunks run on the thread that called Run, while the workers handle the
+rest of the stage.
+
+Run is given the time to step by, which is handed to every system's
+v_BeginUpdate. A Map passes its tick delta, so a background map that is
+only updated every few frames still moves at the right speed.
+
+The stages are only rebuilt when a system is added or removed.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef SYSTEM_SCHEDULER_H
+#define SYSTEM_SCHEDULER_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/EntityManager.h>
+#include <Engine/EntitySystem.h>
+#include <Engine/JobPool.h>
+
+//=====STL includes=====
+#include <vector>
+
+namespace KillerEngine
+{
+	class SystemScheduler
+	{
+	public:
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+		SystemScheduler(void);
+
+//==========================================================================================================================
+//
+//SystemScheduler Functions
+//
+//==========================================================================================================================
+		void AddSystem(EntitySystem* system);
+
+		void RemoveSystem(EntitySystem* system);
+
+		void Run(EntityManager& entities, F32 delta);
+
+		U32 GetStageCount(void);
+
+	private:
+		std::vector<EntitySystem*> 				_systems;
+		std::vector<std::vector<EntitySystem*>> _stages;
+		std::vector<ChunkRef> 					_chunks;
+		bool 									_dirty;
+
+		void _BuildStages(void);
+	};
+}//End namespace
+
+#endif
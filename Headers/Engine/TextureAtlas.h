@@ -0,0 +1,183 @@
+/*========================================================================
+The TextureAtlas packs many small images into a few large textures, called
+pages, so that sprites using different images can still be drawn in one
+batch.
+
+Images are added by the texture ID they would have been loaded with in
+the TextureManager. Build loads every image that was added since the last
+Build on the JobPool, packs them tallest first into the pages with a
+SkylinePacker, and uploads each page that changed. Pages that already
+exist keep their images where they are, so sprites made before the Build
+stay correct. An image that is larger than a page, or can not be loaded,
+is left out, and should be loaded on its own.
+
+Sprite::SetTexture asks the atlas to Remap every texture it is given. If
+the ID is in the atlas, the sprite is given the page instead, and its UVs
+are moved into the image's rect on the page. Nothing else has to know the
+atlas is there.
+
+Each image has padding pixels around it, filled by stretching its edge
+out, so filtering near the edge does not pick up its neighbours. The
+padding is also what keeps a UV of exactly 0, 0 off of every page, which
+the sprite shaders treat as having no texture. Pages are uploaded clamped,
+with linear filtering and no mipmaps, as a smaller mip level would blend
+every image into its neighbours once they are closer than the padding.
+
+That also means an image on a page can not repeat. An image that is drawn
+with UVs past 0 or 1 is added with repeats set, which leaves it out of
+the atlas, so it is loaded on its own like any other image the atlas
+does not take.
+
+SaveBake writes the pages as .tga files next to a small text file listing
+every rect, and LoadBake reads them back, so the packing can be done once
+offline. Build(false) packs without touching OpenGL, for a bake tool that
+has no window. Images added after a LoadBake go on new pages.
+
+Page textures are given IDs counting up from the first page ID, which is
+set high so that they do not clash with the IDs from a .tmx file.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/ErrorManager.h>
+#include <Engine/TextureManager.h>
+#include <Engine/SkylinePacker.h>
+#include <Engine/JobPool.h>
+
+//=====STL includes=====
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+//=====SOIL includes=====
+#include <SOIL/SOIL.h>
+
+namespace KillerEngine
+{
+	struct AtlasRegion
+	{
+		U32 page;
+		U32 x;
+		U32 y;
+		U32 width;
+		U32 height;
+		F32 u0;
+		F32 v0;
+		F32 u1;
+		F32 v1;
+	};
+
+	class TextureAtlas
+	{
+	public:
+		~TextureAtlas(void) {  }
+
+//==========================================================================================================================
+//
+//Singleton Functions
+//
+//==========================================================================================================================
+		static TextureAtlas* Instance(void);
+
+//==========================================================================================================================
+//
+//TextureAtlas Functions
+//
+//==========================================================================================================================
+		void AddImage(U32 textureID, string path, bool repeats = false);
+
+		bool Build(bool upload = true);
+
+		bool Remap(U32& textureID, F32& bottom, F32& top, F32& left, F32& right) const;
+
+		bool UpdateImage(U32 textureID, string path);
+
+		void Remove(U32 textureID);
+
+		bool SaveBake(string path) const;
+
+		bool LoadBake(string path, bool upload = true);
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+		bool Contains(U32 textureID) const { return _regions.find(textureID) != _regions.end(); }
+
+		const AtlasRegion* GetRegion(U32 textureID) const;
+
+		U32 GetPageTextureID(U32 page) const { return _firstPageID + page; }
+
+		U32 GetPageCount(void) const { return (U32)_pages.size(); }
+
+		U32 GetRegionCount(void) const { return (U32)_regions.size(); }
+
+		const std::vector<U8>& GetPagePixels(U32 page) const { return _pages[page].pixels; }
+
+		//=====Only used for pages made after they are set=====
+		void SetPageSize(U32 size) { _pageSize = size; }
+
+		U32 GetPageSize(void) const { return _pageSize; }
+
+		void SetPadding(U32 padding) { _padding = padding == 0 ? 1 : padding; }
+
+		U32 GetPadding(void) const { return _padding; }
+
+		void SetFirstPageID(U32 id) { _firstPageID = id; }
+
+	protected:
+//==========================================================================================================================
+//
+//Constructor
+//
+//==========================================================================================================================
+		TextureAtlas(void);
+
+	private:
+		struct AtlasPage
+		{
+			U32 		    width;
+			U32 		    height;
+			SkylinePacker   packer;
+			std::vector<U8> pixels;
+			bool 		    dirty;
+		};
+
+		struct PendingImage
+		{
+			U32    textureID;
+			string path;
+			U8*    pixels;
+			S32    width;
+			S32    height;
+		};
+
+		static TextureAtlas* 	   _instance;
+		std::map<U32, AtlasRegion> _regions;
+		std::vector<AtlasPage> 	   _pages;
+		std::vector<PendingImage>  _pending;
+		U32 					   _pageSize;
+		U32 					   _padding;
+		U32 					   _firstPageID;
+
+		bool _Place(PendingImage& image, AtlasRegion& region);
+
+		void _Blit(const AtlasRegion& region, const U8* pixels);
+
+		void _SetUVs(AtlasRegion& region);
+
+		void _Upload(void);
+	};
+}//End namespace
+
+#endif
@@ -7,6 +7,11 @@ the DevIL library. See http://openil.sourceforge.net/about.php for details.
 SOIL is the library used to actually load the images from the hard drive 
 and use the image data to create the OGL texture.  
 
+Textures repeat and are mipmapped. LoadTextureFromMemory can be given
+TS_CLAMPED instead, for a texture such as an atlas page, which is clamped
+to its edge and has no mipmaps. Smaller mip levels would blend each image
+on the page with its neighbours once they are smaller than its padding.
+
 This is not free to use, and cannot be used without the express permission
 of KillerWave.
 
@@ -19,6 +24,7 @@ Written by Maxwell Miller
 #include <Engine/Atom.h>
 #include <Engine/ErrorManager.h>
 #include <Engine/Texture.hpp>
+#include <Engine/GLStateCache.h>
 
 //=====STL includes=====
 #include <map>
@@ -35,12 +41,18 @@ using std::map;
 
 namespace KillerEngine 
 {
+	enum TextureSampling
+	{
+		TS_REPEAT_MIPMAPPED = 0,
+		TS_CLAMPED
+	};
 
 	class TextureManager
 	{
 	private:
 		static TextureManager* _instance;
 		U32 			   	   _currentTextureID;
+		GLuint 				   _currentGLTexture;
 		map<U32, Texture>      _loadedTextures;
 
 	public:
@@ -68,6 +80,12 @@ namespace KillerEngine
 //
 //==========================================================================================================================
 		void LoadTexture(string path, U32 id, S32 width, S32 height);
+
+		void ReloadTexture(string path, U32 id, S32 width, S32 height);
+
+		void LoadTextureFromMemory(U32 id, const U8* pixels, S32 width, S32 height, TextureSampling sampling = TS_REPEAT_MIPMAPPED);
+
+		bool IsLoaded(U32 id) { return _loadedTextures.find(id) != _loadedTextures.end(); }
 		
 		Texture& GetTexture(U32 id) { return _loadedTextures.find(id)->second; }
 
@@ -78,7 +96,7 @@ namespace KillerEngine
 //Constructors
 //
 //==========================================================================================================================		
-		TextureManager(void): _currentTextureID(0) {  }
+		TextureManager(void): _currentTextureID(0), _currentGLTexture(0) {  }
 		~TextureManager(void) {  }
 
 	};
@@ -0,0 +1,152 @@
+/*========================================================================
+The TileCollisionLayer is a packed grid of collision flags for the tiles
+of a Map, so that character controllers can ask about tiles without
+looking at any GameObject2D.
+
+Each flag has its own bit plane, one bit per tile, with every row packed
+into 64 bit words. Asking about a single tile is a shift and a mask.
+Asking about a span of a row, or a rectangle of rows, checks 64 tiles at
+a time, only masking the words at the ends of the span.
+
+Tiles are addressed by column and row, with row 0 at the bottom, the same
+way world positions go. The world functions change a position into a
+tile using the origin and the tile size. Anything outside of the grid is
+empty. Rectangles are half open, so a box that only touches the edge of a
+tile does not hit it.
+
+The layer is built by Map::Importer2D from the Collision property of each
+tile in the TMX tile set. See the importer for the format.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef TILE_COLLISION_LAYER_H
+#define TILE_COLLISION_LAYER_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/ErrorManager.h>
+#include <Engine/AABB2D.hpp>
+
+//=====STL includes=====
+#include <vector>
+#include <bitset>
+#include <cmath>
+
+namespace KillerEngine
+{
+	enum TileCollisionFlag
+	{
+		TC_NONE 	= 0,
+		TC_SOLID 	= 1,
+		TC_ONE_WAY 	= 2,
+		TC_HAZARD 	= 4,
+		TC_ALL 		= 7
+	};
+
+	class TileCollisionLayer
+	{
+	public:
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+		TileCollisionLayer(void);
+
+//==========================================================================================================================
+//
+//TileCollisionLayer Functions
+//
+//==========================================================================================================================
+		void Init(U32 width, U32 height, F32 tileWidth, F32 tileHeight);
+
+		void Clear(void);
+
+		void SetTile(U32 x, U32 y, U8 flags);
+
+		U8 GetTile(U32 x, U32 y) const;
+
+		bool Test(U32 x, U32 y, U8 flags) const
+		{
+			if(x >= _width || y >= _height) { return false; }
+
+			U32 word = y * _wordsPerRow + (x >> 6);
+			U64 bit = U64(1) << (x & 63);
+
+			return ((flags & TC_SOLID) && (_planes[0][word] & bit)) ||
+				   ((flags & TC_ONE_WAY) && (_planes[1][word] & bit)) ||
+				   ((flags & TC_HAZARD) && (_planes[2][word] & bit));
+		}
+
+		bool IsSolid(U32 x, U32 y) const { return Test(x, y, TC_SOLID); }
+
+		bool AnyInSpan(U8 flags, U32 y, S32 x0, S32 x1) const;
+
+		bool AnyInRect(U8 flags, S32 x0, S32 y0, S32 x1, S32 y1) const;
+
+		U32 CountInSpan(U8 flags, U32 y, S32 x0, S32 x1) const;
+
+//==========================================================================================================================
+//
+//World Space Queries
+//
+//==========================================================================================================================
+		bool TestPoint(F32 x, F32 y, U8 flags) const;
+
+		bool Overlaps(const AABB2D& rect, U8 flags) const;
+
+		bool ProbeGround(F32 left, F32 right, F32 footY, F32 maxDistance, F32& groundY) const;
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+		void SetOrigin(F32 x, F32 y) { _originX = x; _originY = y; }
+
+		U32 GetWidth(void) const { return _width; }
+
+		U32 GetHeight(void) const { return _height; }
+
+		F32 GetTileWidth(void) const { return _tileWidth; }
+
+		F32 GetTileHeight(void) const { return _tileHeight; }
+
+		//=====Goes up every time a tile changes, so caches built from the layer know when they are stale=====
+		U32 GetVersion(void) const { return _version; }
+
+		S32 WorldToColumn(F32 x) const { return (S32)std::floor((x - _originX) / _tileWidth); }
+
+		S32 WorldToRow(F32 y) const { return (S32)std::floor((y - _originY) / _tileHeight); }
+
+	private:
+		U32 			 _width;
+		U32 			 _height;
+		U32 			 _wordsPerRow;
+		F32 			 _tileWidth;
+		F32 			 _tileHeight;
+		F32 			 _originX;
+		F32 			 _originY;
+		U32 			 _version;
+		//=====Solid, one way, hazard=====
+		std::vector<U64> _planes[3];
+
+		bool _ClampSpan(S32& x0, S32& x1) const;
+
+		U64 _RowWord(U8 flags, U32 word) const
+		{
+			U64 bits = 0;
+
+			if(flags & TC_SOLID) { bits |= _planes[0][word]; }
+			if(flags & TC_ONE_WAY) { bits |= _planes[1][word]; }
+			if(flags & TC_HAZARD) { bits |= _planes[2][word]; }
+
+			return bits;
+		}
+	};
+}//End namespace
+
+#endif
@@ -13,6 +13,7 @@ Written by Maxwell Miller
 //=====Killer1 Includes=====
 #include <Engine/Atom.h>
 #include <Engine/Sprite.h>
+#include <Engine/ShaderRegistry.h>
 #include <Engine/Renderer.h>
 
 namespace KillerEngine
@@ -40,6 +41,9 @@ namespace KillerEngine
 
 		void v_InitShader(void);
 
+		//=====Starts the program for the current sprite path building, without waiting for it=====
+		static void RequestShaders(void);
+
 	private:
 		static GLuint _shaderProgram;
 		static const GLchar* _vertexShaderSource[];
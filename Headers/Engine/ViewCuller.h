@@ -0,0 +1,71 @@
+/*========================================================================
+The ViewCuller finds which of a list of bounds can be seen through a view
+rectangle, such as the one the Camera returns from GetViewRect.
+
+The bounds are kept one side to an array, so the four sides of four boxes
+are each loaded with a single SSE load and tested against the view in a
+few instructions. Anything left over at the end, or everything on a build
+with no SSE, is tested one box at a time. Both give the same answer as
+AABB2D::Overlaps.
+
+It is used for things that move every frame, which is where a spatial
+index would have to be rebuilt to be any use. Clear it, Add every box,
+then Cull. The index of each box is the order it was added in.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+#ifndef VIEW_CULLER_H
+#define VIEW_CULLER_H
+
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/AABB2D.hpp>
+
+//=====STL includes=====
+#include <vector>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE__)
+#define KILLER_CULL_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace KillerEngine
+{
+	class ViewCuller
+	{
+	public:
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+		ViewCuller(void);
+
+//==========================================================================================================================
+//
+//ViewCuller Functions
+//
+//==========================================================================================================================
+		void Clear(void);
+
+		void Reserve(U32 count);
+
+		void Add(const AABB2D& bounds);
+
+		//=====Appends the index of every box that overlaps view, in order, and returns how many=====
+		U32 Cull(const AABB2D& view, std::vector<U32>& visible) const;
+
+		U32 GetCount(void) const { return (U32)_minX.size(); }
+
+	private:
+		std::vector<F32> _minX;
+		std::vector<F32> _minY;
+		std::vector<F32> _maxX;
+		std::vector<F32> _maxY;
+	};
+}//End namespace
+
+#endif
@@ -109,6 +109,13 @@ public:
 		
 		void BufferSwap(void);
 
+		void BufferSwap(const GLfloat* clearColor);
+
+		//=====The GL context can only be current on one thread at a time=====
+		void MakeContextCurrent(bool state);
+
+		const GLfloat* GetBackgroundColor(void) const { return _bgColor; }
+
 		void SetBackgroundColor(Col& c) 
 		{
 			_bgColor[0] = c.GetRed();
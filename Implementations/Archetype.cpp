@@ -0,0 +1,156 @@
+#include <Engine/Archetype.h>
+
+namespace KillerEngine
+{
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+	Archetype::Archetype(ComponentMask mask) : _mask(mask), _componentIDs(), _chunkCapacity(0), _chunkBytes(CHUNK_BYTES), _chunks(), _chunkCounts()
+	{
+		U32 rowSize = sizeof(Entity);
+
+		for(U32 i = 0; i < MAX_COMPONENT_TYPES; ++i)
+		{
+			_offsets[i] = NO_OFFSET;
+
+			if(_mask & (ComponentMask(1) << i))
+			{
+				_componentIDs.push_back(i);
+				rowSize += ComponentRegistry::Instance()->GetInfo(i).size;
+			}
+		}
+
+		//=====Leave room to align every array to 16 bytes=====
+		U32 usable = CHUNK_BYTES - 16 * (U32)(_componentIDs.size() + 1);
+		_chunkCapacity = usable / rowSize;
+		if(_chunkCapacity == 0) { _chunkCapacity = 1; }
+
+		//=====Entities first, then one array per component=====
+		U32 offset = _chunkCapacity * sizeof(Entity);
+
+		for(U32 i = 0; i < _componentIDs.size(); ++i)
+		{
+			const ComponentInfo& info = ComponentRegistry::Instance()->GetInfo(_componentIDs[i]);
+
+			offset = (offset + 15) & ~15u;
+			_offsets[_componentIDs[i]] = offset;
+			offset += _chunkCapacity * info.size;
+		}
+
+		//=====Only when a single row does not fit=====
+		if(offset > _chunkBytes) { _chunkBytes = offset; }
+	}
+
+	Archetype::~Archetype(void)
+	{
+		for(U32 c = 0; c < _chunks.size(); ++c)
+		{
+			for(U32 r = 0; r < _chunkCounts[c]; ++r)
+			{
+				for(U32 i = 0; i < _componentIDs.size(); ++i)
+				{
+					ComponentRegistry::Instance()->GetInfo(_componentIDs[i]).destroy(GetComponent(c, r, _componentIDs[i]));
+				}
+			}
+
+			delete[] _chunks[c];
+		}
+	}
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+	U32 Archetype::GetEntityCount(void) const
+	{
+		if(_chunks.empty()) { return 0; }
+
+		return (U32)(_chunks.size() - 1) * _chunkCapacity + _chunkCounts.back();
+	}
+
+//==========================================================================================================================
+//
+//Archetype Functions
+//
+//==========================================================================================================================
+	void Archetype::AddRow(Entity entity, U32& chunk, U32& row)
+	{
+		_ReserveRow(entity, chunk, row);
+
+		for(U32 i = 0; i < _componentIDs.size(); ++i)
+		{
+			ComponentRegistry::Instance()->GetInfo(_componentIDs[i]).construct(GetComponent(chunk, row, _componentIDs[i]));
+		}
+	}
+
+	void Archetype::AddRowFrom(Entity entity, Archetype& source, U32 sourceChunk, U32 sourceRow, U32& chunk, U32& row)
+	{
+		_ReserveRow(entity, chunk, row);
+
+		for(U32 i = 0; i < _componentIDs.size(); ++i)
+		{
+			U32 id = _componentIDs[i];
+			const ComponentInfo& info = ComponentRegistry::Instance()->GetInfo(id);
+
+			if(source.Has(id)) { info.moveConstruct(GetComponent(chunk, row, id), source.GetComponent(sourceChunk, sourceRow, id)); }
+			else { info.construct(GetComponent(chunk, row, id)); }
+		}
+	}
+
+	Entity Archetype::RemoveRow(U32 chunk, U32 row)
+	{
+		U32 lastChunk = (U32)_chunks.size() - 1;
+		U32 lastRow = _chunkCounts[lastChunk] - 1;
+
+		for(U32 i = 0; i < _componentIDs.size(); ++i)
+		{
+			ComponentRegistry::Instance()->GetInfo(_componentIDs[i]).destroy(GetComponent(chunk, row, _componentIDs[i]));
+		}
+
+		Entity moved;
+
+		//=====Fill the hole with the last row=====
+		if(chunk != lastChunk || row != lastRow)
+		{
+			for(U32 i = 0; i < _componentIDs.size(); ++i)
+			{
+				U32 id = _componentIDs[i];
+				const ComponentInfo& info = ComponentRegistry::Instance()->GetInfo(id);
+
+				info.moveConstruct(GetComponent(chunk, row, id), GetComponent(lastChunk, lastRow, id));
+				info.destroy(GetComponent(lastChunk, lastRow, id));
+			}
+
+			moved = GetEntities(lastChunk)[lastRow];
+			GetEntities(chunk)[row] = moved;
+		}
+
+		--_chunkCounts[lastChunk];
+
+		if(_chunkCounts[lastChunk] == 0)
+		{
+			delete[] _chunks[lastChunk];
+			_chunks.pop_back();
+			_chunkCounts.pop_back();
+		}
+
+		return moved;
+	}
+
+	void Archetype::_ReserveRow(Entity entity, U32& chunk, U32& row)
+	{
+		if(_chunks.empty() || _chunkCounts.back() == _chunkCapacity)
+		{
+			_chunks.push_back(new U8[_chunkBytes]);
+			_chunkCounts.push_back(0);
+		}
+
+		chunk = (U32)_chunks.size() - 1;
+		row = _chunkCounts[chunk]++;
+
+		GetEntities(chunk)[row] = entity;
+	}
+}//End namespace
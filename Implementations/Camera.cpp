@@ -17,19 +17,7 @@ namespace KillerEngine
 
 	void Camera::SetUp(GLuint shader)
 	{
-		
-		//temporary fix to get camera working for now. 
-		const F32* data = _projection.GetElems();
-
-		GLint transform1 = glGetUniformLocation(shader, "perspective_mat");
-
-		glUniformMatrix4fv(transform1, 1, GL_FALSE, data);
-
-		const F32* data2 = _translation.GetElems();
-
-		GLint transform2 = glGetUniformLocation(shader, "modelView_mat");
-
-		glUniformMatrix4fv(transform2, 1, GL_FALSE, data2);
+		SetUp(shader, _translation, _version);
 
 /*	
 		//not working matrix multiplication. Will fix later
@@ -44,13 +32,28 @@ namespace KillerEngine
 */		
 	}
 
+//The projection never changes after the Camera is made, so it is safe to read from any thread.
+	void Camera::SetUp(GLuint shader, const Matrix& translation, U32 version)
+	{
+		//temporary fix to get camera working for now. 
+		GLStateCache::Instance()->UniformMatrix4(shader, "perspective_mat", _projection.GetElems(), version);
+
+		GLStateCache::Instance()->UniformMatrix4(shader, "modelView_mat", translation.GetElems(), version);
+	}
+
 //==========================================================================================================================
 //
 //Constructors	 	
 //
 //==========================================================================================================================
-	Camera::Camera(void) : _background(1.0f), _projection(), _translation(1.0f)
+	Camera::Camera(void) : _background(1.0f), 
+						   _projection(), 
+						   _translation(1.0f), 
+						   _offset(0.0f), 
+						   _viewWidth((F32)WinProgram::Instance()->GetWidth()), 
+						   _viewHeight((F32)WinProgram::Instance()->GetHeight()), 
+						   _version(1)
 	{
-		_projection.MakeOrthographic((F32)WinProgram::Instance()->GetWidth(), (F32)WinProgram::Instance()->GetHeight(), 200);
+		_projection.MakeOrthographic(_viewWidth, _viewHeight, 200);
 	}	
 }//end namespace
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include <Engine/Component.h>
+
+namespace KillerEngine
+{
+//==========================================================================================================================
+//
+//Singleton Functions
+//
+//==========================================================================================================================
+	ComponentRegistry* ComponentRegistry::_instance = NULL;
+
+	ComponentRegistry* ComponentRegistry::Instance(void)
+	{
+		if(_instance == NULL) { _instance = new ComponentRegistry(); }
+		return _instance;
+	}
+
+//==========================================================================================================================
+//
+//ComponentRegistry Functions
+//
+//==========================================================================================================================
+	U32 ComponentRegistry::Register(const ComponentInfo& info)
+	{
+		if(_infos.size() >= MAX_COMPONENT_TYPES)
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "ComponentRegistry -> Too many component types, the limit is 64.");
+			return INVALID_COMPONENT;
+		}
+
+		_infos.push_back(info);
+
+		return (U32)_infos.size() - 1;
+	}
+}//End namespace
@@ -0,0 +1,197 @@
+#include <Engine/EntityManager.h>
+
+namespace KillerEngine
+{
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+	EntityManager::EntityManager(void) : _records(), _archetypes(), _archetypeList()
+	{  }
+
+	EntityManager::~EntityManager(void)
+	{
+		for(U32 i = 0; i < _archetypeList.size(); ++i)
+		{
+			delete _archetypeList[i];
+		}
+	}
+
+//==========================================================================================================================
+//
+//Entity Functions
+//
+//==========================================================================================================================
+	Entity EntityManager::CreateEntity(void)
+	{
+		EntityRecord record;
+		record.archetype = _GetArchetype(0);
+		record.chunk = 0;
+		record.row = 0;
+
+		Entity entity = _records.Add(record);
+
+		EntityRecord* added = _records.Get(entity);
+		added->archetype->AddRow(entity, added->chunk, added->row);
+
+		return entity;
+	}
+
+	void EntityManager::DestroyEntity(Entity entity)
+	{
+		EntityRecord* record = _records.Get(entity);
+
+		if(record == NULL)
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "EntityManager -> Tried to destroy an entity that does not exist.");
+			return;
+		}
+
+		Entity moved = record->archetype->RemoveRow(record->chunk, record->row);
+
+		if(moved.IsValid())
+		{
+			EntityRecord* movedRecord = _records.Get(moved);
+			movedRecord->chunk = record->chunk;
+			movedRecord->row = record->row;
+		}
+
+		_records.Remove(entity);
+	}
+
+	ComponentMask EntityManager::GetMask(Entity entity)
+	{
+		EntityRecord* record = _records.Get(entity);
+
+		return record == NULL ? 0 : record->archetype->GetMask();
+	}
+
+//==========================================================================================================================
+//
+//Queries
+//
+//==========================================================================================================================
+	void EntityManager::GetMatchingChunks(ComponentMask required, std::vector<ChunkRef>& out)
+	{
+		for(U32 a = 0; a < _archetypeList.size(); ++a)
+		{
+			Archetype* archetype = _archetypeList[a];
+
+			if(!archetype->Matches(required)) { continue; }
+
+			for(U32 c = 0; c < archetype->GetChunkCount(); ++c)
+			{
+				ChunkRef ref;
+				ref.archetype = archetype;
+				ref.chunk = c;
+				out.push_back(ref);
+			}
+		}
+	}
+
+	void EntityManager::ForEachChunk(ComponentMask required, const std::function<void(ChunkRef& chunk)>& func)
+	{
+		for(U32 a = 0; a < _archetypeList.size(); ++a)
+		{
+			Archetype* archetype = _archetypeList[a];
+
+			if(!archetype->Matches(required)) { continue; }
+
+			for(U32 c = 0; c < archetype->GetChunkCount(); ++c)
+			{
+				ChunkRef ref;
+				ref.archetype = archetype;
+				ref.chunk = c;
+				func(ref);
+			}
+		}
+	}
+
+//==========================================================================================================================
+//
+//Private Functions
+//
+//==========================================================================================================================
+	Archetype* EntityManager::_GetArchetype(ComponentMask mask)
+	{
+		auto found = _archetypes.find(mask);
+
+		if(found != _archetypes.end()) { return found->second; }
+
+		Archetype* archetype = new Archetype(mask);
+		_archetypes.insert(std::map<ComponentMask, Archetype*>::value_type(mask, archetype));
+		_archetypeList.push_back(archetype);
+
+		return archetype;
+	}
+
+	void EntityManager::_Migrate(Entity entity, ComponentMask newMask)
+	{
+		EntityRecord* record = _records.Get(entity);
+		Archetype* source = record->archetype;
+		Archetype* dest = _GetArchetype(newMask);
+
+		U32 chunk;
+		U32 row;
+		dest->AddRowFrom(entity, *source, record->chunk, record->row, chunk, row);
+
+		Entity moved = source->RemoveRow(record->chunk, record->row);
+
+		if(moved.IsValid())
+		{
+			EntityRecord* movedRecord = _records.Get(moved);
+			movedRecord->chunk = record->chunk;
+			movedRecord->row = record->row;
+		}
+
+		record->archetype = dest;
+		record->chunk = chunk;
+		record->row = row;
+	}
+
+	void* EntityManager::_AddComponent(Entity entity, U32 componentID)
+	{
+		if(componentID >= MAX_COMPONENT_TYPES)
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "EntityManager -> Tried to add a component type that was never registered.");
+			return NULL;
+		}
+
+		EntityRecord* record = _records.Get(entity);
+
+		if(record == NULL)
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "EntityManager -> Tried to add a component to an entity that does not exist.");
+			return NULL;
+		}
+
+		ComponentMask mask = record->archetype->GetMask();
+		ComponentMask bit = ComponentMask(1) << componentID;
+
+		if((mask & bit) == 0) { _Migrate(entity, mask | bit); }
+
+		return _GetComponent(entity, componentID);
+	}
+
+	void EntityManager::_RemoveComponent(Entity entity, U32 componentID)
+	{
+		EntityRecord* record = _records.Get(entity);
+
+		if(record == NULL || componentID >= MAX_COMPONENT_TYPES) { return; }
+
+		ComponentMask mask = record->archetype->GetMask();
+		ComponentMask bit = ComponentMask(1) << componentID;
+
+		if(mask & bit) { _Migrate(entity, mask & ~bit); }
+	}
+
+	void* EntityManager::_GetComponent(Entity entity, U32 componentID)
+	{
+		EntityRecord* record = _records.Get(entity);
+
+		if(record == NULL) { return NULL; }
+
+		return record->archetype->GetComponent(record->chunk, record->row, componentID);
+	}
+}//End namespace
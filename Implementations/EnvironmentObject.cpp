@@ -11,12 +11,14 @@ namespace KillerEngine
 	{
 		GameObject2D::SetSprite(new SqrSprite());
 		GameObject2D::SetID();
+		GameObject2D::SetStatic(true);
 	}
 
 	EnvironmentObject::EnvironmentObject(Vec2& pos, F32 w, F32 h)
 	{
 		GameObject2D::SetSprite(new SqrSprite());
 		GameObject2D::SetID();
+		GameObject2D::SetStatic(true);
 		GameObject2D::SetDimensions(w, h);
 		GameObject2D::SetPosition(pos);
 	}
@@ -25,8 +27,12 @@ namespace KillerEngine
 	{
 		GameObject2D::SetSprite(new SqrSprite());
 		GameObject2D::SetID();
+		GameObject2D::SetStatic(true);
 		GameObject2D::SetDimensions(w, h);
 		GameObject2D::SetPosition(pos);
 		GameObject2D::SetTexture(textureID, 0.0f, 1.0f, 0.0f, 1.0f);
 	}
+
+	EnvironmentObject::~EnvironmentObject(void)
+	{  }
 }//end namespace
\ No newline at end of file
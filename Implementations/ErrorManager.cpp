@@ -26,6 +26,8 @@ namespace KillerEngine
 //=======================================================================================================	
 	void ErrorManager::SetError(ErrorCode code, string message) 
 	{
+		std::lock_guard<std::mutex> lock(_lock);
+
 		_errorCodes[_numErrors]	   = code;
 		_errorMessages[_numErrors] = message;
 		_numErrors++;
@@ -34,47 +36,62 @@ namespace KillerEngine
 //=======================================================================================================
 //DisplayErrors
 //=======================================================================================================
+//The errors are copied out first, so a worker that sets one is not held up by a MessageBox.
 	void ErrorManager::DisplayErrors(void) 
 	{
-		if (_numErrors > 0) 
+		U32 numErrors = 0;
+		map<U32, ErrorCode> errorCodes;
+		map<U32, string> errorMessages;
+
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+
+			if(_numErrors == 0) { return; }
+
+			numErrors = _numErrors;
+			errorCodes = _errorCodes;
+			errorMessages = _errorMessages;
+		}
+
+		if (numErrors > 0) 
 		{
-			for (U32 i = 0; i < _numErrors; i++) 
+			for (U32 i = 0; i < numErrors; i++) 
 			{
-				switch (_errorCodes[i]) 
+				switch (errorCodes[i]) 
 				{
 				case EC_NoError: {
 									 //later, it will print to a log file, maybe
 				}
 				case EC_Unknown: {
-					MessageBox(NULL, _errorMessages[i].c_str(), "UNKNOWN", MB_ICONERROR | MB_OK);
+					MessageBox(NULL, errorMessages[i].c_str(), "UNKNOWN", MB_ICONERROR | MB_OK);
 					break;
 				}
 				case EC_Game: {
-					MessageBox(NULL, _errorMessages[i].c_str(), "GAME", MB_ICONERROR | MB_OK);
+					MessageBox(NULL, errorMessages[i].c_str(), "GAME", MB_ICONERROR | MB_OK);
 					break;
 				}
 				case EC_KillerEngine: {
-					MessageBox(NULL, _errorMessages[i].c_str(), "KILLER_ENGINE", MB_ICONERROR | MB_OK);
+					MessageBox(NULL, errorMessages[i].c_str(), "KILLER_ENGINE", MB_ICONERROR | MB_OK);
 					break;
 				}
 				case EC_Windows: {
-					MessageBox(NULL, _errorMessages[i].c_str(), "WINDOWS", MB_ICONERROR | MB_OK);
+					MessageBox(NULL, errorMessages[i].c_str(), "WINDOWS", MB_ICONERROR | MB_OK);
 					break;
 				}
 				case EC_OpenGL: {
-					MessageBox(NULL, _errorMessages[i].c_str(), "OPENGL", MB_ICONERROR | MB_OK);
+					MessageBox(NULL, errorMessages[i].c_str(), "OPENGL", MB_ICONERROR | MB_OK);
 					break;
 				}
 				case EC_OpenGL_Shader: {
-					MessageBox(NULL, _errorMessages[i].c_str(), "OPENGL SHADER", MB_ICONERROR | MB_OK);
+					MessageBox(NULL, errorMessages[i].c_str(), "OPENGL SHADER", MB_ICONERROR | MB_OK);
 					break;
 				}
 				case EC_DirectInput: {
-					MessageBox(NULL, _errorMessages[i].c_str(), "DIRECT_INPUT", MB_ICONERROR | MB_OK);
+					MessageBox(NULL, errorMessages[i].c_str(), "DIRECT_INPUT", MB_ICONERROR | MB_OK);
 					break;
 				}
 				case EC_TextureManager: {
-					MessageBox(NULL, _errorMessages[i].c_str(), "TEXTURE_MANAGER", MB_ICONERROR | MB_OK);						
+					MessageBox(NULL, errorMessages[i].c_str(), "TEXTURE_MANAGER", MB_ICONERROR | MB_OK);						
 				}
 				default: break;
 				}
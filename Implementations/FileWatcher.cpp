@@ -0,0 +1,224 @@
+#include <Engine/FileWatcher.h>
+
+namespace KillerEngine
+{
+//==========================================================================================================================
+//
+//Singleton Functions
+//
+//==========================================================================================================================
+	FileWatcher* FileWatcher::_instance = NULL;
+
+	FileWatcher* FileWatcher::Instance(void)
+	{
+		if(_instance == NULL) { _instance = new FileWatcher(); }
+		return _instance;
+	}
+
+//==========================================================================================================================
+//
+//FileWatcher Functions
+//
+//==========================================================================================================================
+	U32 FileWatcher::Watch(string path, std::function<void(const string& path)> callback)
+	{
+		WatchedFile watched;
+		watched.path = path;
+		bool found = _GetStamp(path, watched.lastWrite);
+		watched.handle = -1;
+		watched.callback = callback;
+
+		//=====Split the path into the folder and the file name=====
+		size_t slash = path.find_last_of("/\\");
+
+		if(slash == string::npos)
+		{
+			watched.folder = ".";
+			watched.name = path;
+		}
+		else
+		{
+			watched.folder = path.substr(0, slash);
+			watched.name = path.substr(slash + 1);
+		}
+
+		if(!found)
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "FileWatcher -> Unable to find file to watch " + path);
+		}
+
+#ifdef __linux__
+		if(_notifyHandle >= 0)
+		{
+			watched.handle = inotify_add_watch(_notifyHandle, watched.folder.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+		}
+#endif
+
+		U32 id = _nextID++;
+		_watches.insert(std::map<U32, WatchedFile>::value_type(id, watched));
+
+		return id;
+	}
+
+	void FileWatcher::Unwatch(U32 watchID)
+	{
+		auto found = _watches.find(watchID);
+
+		if(found == _watches.end()) { return; }
+
+#ifdef __linux__
+		//=====inotify hands back the same handle for the same folder, only drop it when the last file goes=====
+		S32 handle = found->second.handle;
+		bool shared = false;
+
+		for(auto i = _watches.begin(); i != _watches.end(); ++i)
+		{
+			if(i != found && i->second.handle == handle) { shared = true; }
+		}
+
+		if(handle >= 0 && !shared) { inotify_rm_watch(_notifyHandle, handle); }
+#endif
+
+		_watches.erase(found);
+	}
+
+	void FileWatcher::Poll(void)
+	{
+		if(_watches.empty()) { return; }
+
+		_changed.clear();
+
+#ifdef __linux__
+		if(_notifyHandle >= 0) { _PollNotify(); }
+		else { _PollTimes(); }
+#else
+		_PollTimes();
+#endif
+
+		//=====Callbacks can watch or unwatch files, so look each one up again=====
+		for(U32 i = 0; i < _changed.size(); ++i)
+		{
+			auto found = _watches.find(_changed[i]);
+
+			if(found == _watches.end()) { continue; }
+
+			std::function<void(const string& path)> callback = found->second.callback;
+			string path = found->second.path;
+
+			callback(path);
+		}
+	}
+
+//==========================================================================================================================
+//
+//Constructor
+//
+//==========================================================================================================================
+	FileWatcher::FileWatcher(void) : _watches(), 
+									 _changed(), 
+									 _nextID(1), 
+									 _pollInterval(0.25f), 
+									 _lastPoll(std::chrono::steady_clock::now()), 
+									 _notifyHandle(-1)
+	{
+#ifdef __linux__
+		_notifyHandle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+	}
+
+	FileWatcher::~FileWatcher(void)
+	{
+#ifdef __linux__
+		if(_notifyHandle >= 0) { close(_notifyHandle); }
+#endif
+	}
+
+//==========================================================================================================================
+//
+//Private Functions
+//
+//==========================================================================================================================
+//st_mtime is only to the second, so the finer time each platform keeps is used instead. On Windows
+//that is a FILETIME, in 100 nanosecond steps.
+	bool FileWatcher::_GetStamp(const string& path, FileStamp& stamp)
+	{
+		stamp.time = 0;
+		stamp.size = 0;
+
+#ifdef _WIN32
+		WIN32_FILE_ATTRIBUTE_DATA info;
+		if(!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &info)) { return false; }
+
+		stamp.time = (S64)(((U64)info.ftLastWriteTime.dwHighDateTime << 32) | info.ftLastWriteTime.dwLowDateTime) * 100;
+		stamp.size = (S64)(((U64)info.nFileSizeHigh << 32) | info.nFileSizeLow);
+#else
+		struct stat info;
+		if(stat(path.c_str(), &info) != 0) { return false; }
+
+#ifdef __APPLE__
+		stamp.time = (S64)info.st_mtimespec.tv_sec * 1000000000 + info.st_mtimespec.tv_nsec;
+#else
+		stamp.time = (S64)info.st_mtim.tv_sec * 1000000000 + info.st_mtim.tv_nsec;
+#endif
+		stamp.size = (S64)info.st_size;
+#endif
+
+		return true;
+	}
+
+	void FileWatcher::_PollNotify(void)
+	{
+#ifdef __linux__
+		char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+		while(true)
+		{
+			ssize_t length = read(_notifyHandle, buffer, sizeof(buffer));
+
+			if(length <= 0) { break; }
+
+			for(char* p = buffer; p < buffer + length; )
+			{
+				const struct inotify_event* event = (const struct inotify_event*)p;
+
+				if(event->len > 0)
+				{
+					for(auto i = _watches.begin(); i != _watches.end(); ++i)
+					{
+						if(i->second.handle == event->wd && i->second.name == event->name &&
+						   std::find(_changed.begin(), _changed.end(), i->first) == _changed.end())
+						{
+							_changed.push_back(i->first);
+						}
+					}
+				}
+
+				p += sizeof(struct inotify_event) + event->len;
+			}
+		}
+#endif
+	}
+
+	void FileWatcher::_PollTimes(void)
+	{
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+		if(std::chrono::duration<F32>(now - _lastPoll).count() < _pollInterval) { return; }
+
+		_lastPoll = now;
+
+		for(auto i = _watches.begin(); i != _watches.end(); ++i)
+		{
+			FileStamp stamp;
+
+			if(!_GetStamp(i->second.path, stamp)) { continue; }
+
+			//=====A save can keep the size or, on a coarse file system, the time, but rarely both=====
+			if(stamp.time != i->second.lastWrite.time || stamp.size != i->second.lastWrite.size)
+			{
+				i->second.lastWrite = stamp;
+				_changed.push_back(i->first);
+			}
+		}
+	}
+}//End namespace
@@ -0,0 +1,117 @@
+#include <Engine/FlowField.h>
+
+namespace KillerEngine
+{
+	static const F32 DIAGONAL_COST = 1.41421356f;
+	static const F32 UNREACHED = -1.0f;
+	static const U8  NO_DIRECTION = 8;
+
+	//=====Opposite directions sit next to each other, so d ^ 1 turns a step around=====
+	static const S32 DIRECTION_X[9] = { 1, -1, 0, 0, 1, -1, 1, -1, 0 };
+	static const S32 DIRECTION_Y[9] = { 0, 0, 1, -1, 1, -1, -1, 1, 0 };
+
+	struct FlowEntry
+	{
+		F32 cost;
+		S32 cell;
+
+		bool operator>(const FlowEntry& e) const { return cost > e.cost; }
+	};
+
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+	FlowField::FlowField(void) : _width(0), _height(0), _goal(), _version(0), _costs(), _directions()
+	{  }
+
+//==========================================================================================================================
+//
+//FlowField Functions
+//
+//==========================================================================================================================
+	bool FlowField::Build(const TileCollisionLayer& layer, U8 blockingFlags, GridPoint goal)
+	{
+		_width = (S32)layer.GetWidth();
+		_height = (S32)layer.GetHeight();
+		_goal = goal;
+		_version = layer.GetVersion();
+
+		_costs.assign(_width * _height, UNREACHED);
+		_directions.assign(_width * _height, NO_DIRECTION);
+
+		auto walkable = [&layer, blockingFlags, this](S32 x, S32 y)
+		{
+			return x >= 0 && y >= 0 && x < _width && y < _height && !layer.Test((U32)x, (U32)y, blockingFlags);
+		};
+
+		if(!walkable(goal.x, goal.y)) { return false; }
+
+		//=====Dijkstra out from the goal=====
+		std::vector<FlowEntry> open;
+		std::vector<U8> closed(_width * _height, 0);
+
+		FlowEntry start;
+		start.cost = 0.0f;
+		start.cell = goal.y * _width + goal.x;
+		open.push_back(start);
+		_costs[start.cell] = 0.0f;
+
+		while(!open.empty())
+		{
+			std::pop_heap(open.begin(), open.end(), std::greater<FlowEntry>());
+			FlowEntry entry = open.back();
+			open.pop_back();
+
+			if(closed[entry.cell]) { continue; }
+			closed[entry.cell] = 1;
+
+			S32 x = entry.cell % _width;
+			S32 y = entry.cell / _width;
+
+			for(U8 d = 0; d < 8; ++d)
+			{
+				S32 dx = DIRECTION_X[d];
+				S32 dy = DIRECTION_Y[d];
+
+				if(!walkable(x + dx, y + dy)) { continue; }
+				if(dx != 0 && dy != 0 && (!walkable(x + dx, y) || !walkable(x, y + dy))) { continue; }
+
+				S32 next = (y + dy) * _width + (x + dx);
+				F32 cost = entry.cost + (dx != 0 && dy != 0 ? DIAGONAL_COST : 1.0f);
+
+				if(closed[next] || (_costs[next] != UNREACHED && _costs[next] <= cost)) { continue; }
+
+				_costs[next] = cost;
+
+				//=====Moves are symmetric, so the way back is the opposite step=====
+				_directions[next] = d ^ 1;
+
+				FlowEntry added;
+				added.cost = cost;
+				added.cell = next;
+				open.push_back(added);
+				std::push_heap(open.begin(), open.end(), std::greater<FlowEntry>());
+			}
+		}
+
+		return true;
+	}
+
+	GridPoint FlowField::GetDirection(S32 x, S32 y) const
+	{
+		if(x < 0 || y < 0 || x >= _width || y >= _height) { return GridPoint(0, 0); }
+
+		U8 d = _directions[y * _width + x];
+
+		return GridPoint(DIRECTION_X[d], DIRECTION_Y[d]);
+	}
+
+	F32 FlowField::GetCost(S32 x, S32 y) const
+	{
+		if(x < 0 || y < 0 || x >= _width || y >= _height) { return UNREACHED; }
+
+		return _costs[y * _width + x];
+	}
+}//End namespace
@@ -2,161 +2,374 @@
 
 namespace KillerEngine
 {
-	Font::Font(void) : _textureID(0), _fontFile(), _fontName() 
+	//=====True if the word from start to end is name=====
+	static inline bool WordIs(const char* start, const char* end, const char* name)
+	{
+		for(; start < end; ++start, ++name)
+		{
+			if(*name == 0 || *start != *name) { return false; }
+		}
+
+		return *name == 0;
+	}
+
+	//=====The binary file is little endian no matter what it is read on=====
+	static inline U32 ReadU16(const U8* data)
+	{
+		return U32(data[0]) | (U32(data[1]) << 8);
+	}
+
+	static inline U32 ReadU32(const U8* data)
+	{
+		return U32(data[0]) | (U32(data[1]) << 8) | (U32(data[2]) << 16) | (U32(data[3]) << 24);
+	}
+
+	static inline S32 ReadS16(const U8* data)
+	{
+		return S32(S16(ReadU16(data)));
+	}
+
+	static inline bool KerningLess(const KerningPair& a, const KerningPair& b)
+	{
+		return a.first < b.first || (a.first == b.first && a.second < b.second);
+	}
+
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+	Font::Font(void) : _textureID(0), _fontFile(), _fontName(), _lineHeight(0), _base(0),
+					   _glyphs(), _flatIndex(), _hashIndex(), _kernings(), _stats()
 	{  }
 
-	Font::Font(U32 tID) : _textureID(tID), _fontFile(), _fontName() 
+	Font::Font(U32 tID) : _textureID(tID), _fontFile(), _fontName(), _lineHeight(0), _base(0),
+						  _glyphs(), _flatIndex(), _hashIndex(), _kernings(), _stats()
 	{  }
 
+//==========================================================================================================================
+//
+//Font Functions
+//
+//==========================================================================================================================
+//The whole file is read in one go, then parsed from memory.
 	void Font::InitFont(string fontName, string fontFile)
 	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
 		_fontName = fontName;
 
 		_fontFile = fontFile;
 
-		std::ifstream file;
+		_Clear();
 
-		file.open(_fontFile.c_str());
+		std::ifstream file(_fontFile.c_str(), std::ios::binary);
 
 		if(!file.is_open())
 		{
-			//Add error manager, set error
-			//std::cout << "Failed to open file!\n" << _fontFile << std::endl; 
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "Font -> Unable to open " + _fontFile);
+			return;
 		}
-		else
+
+		file.seekg(0, std::ios::end);
+		std::streamoff size = file.tellg();
+		file.seekg(0, std::ios::beg);
+
+		if(size <= 0)
 		{
-			std::vector<string> results;
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "Font -> " + _fontFile + " is empty");
+			return;
+		}
+
+		//=====One past the end stays 0, so the text parser can always stop on it=====
+		string contents((size_t)size + 1, 0);
+		file.read(&contents[0], size);
+		file.close();
+
+		_stats.bytes = (U32)size;
 
-			 for(string token; getline(file, token, ' '); )
-			 {
-			 	if(token.find_first_not_of(' ') != std::string::npos) 
-			 		results.push_back(std::move(token));
-			 }
+		const U8* bytes = (const U8*)contents.data();
 
-			 bool first = true;
+		if(size >= 4 && bytes[0] == 'B' && bytes[1] == 'M' && bytes[2] == 'F')
+		{
+			_stats.binary = true;
+
+			if(!_ParseBinary(bytes, bytes + size))
+			{
+				ErrorManager::Instance()->SetError(EC_KillerEngine, "Font -> " + _fontFile + " is not a BMFont binary file this can read");
+				_Clear();
+				return;
+			}
+		}
+		else
+		{
+			_ParseText(contents.data(), contents.data() + size);
+		}
 
-			 results.erase(results.begin(), results.begin() + _headerSize);
+		_SortKernings();
 
-			 //for(auto i = results.begin(); i != results.end(); ++i)
-			 //95 is the number of characters in this sheet. 
-			 //There will need to be a way to find this number
-			 //from the sheet itself or something
-			 //for(U32 i = 0; i <= results.size(); ++i )
-			 while(results.size() > 1)
-			 {		
+		_stats.glyphs = (U32)_glyphs.size();
+		_stats.hashedGlyphs = (U32)_hashIndex.size();
+		_stats.kernings = (U32)_kernings.size();
+		_stats.loadTime = std::chrono::duration<F64, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}//InitFont
 
-			 	if(first)
-			 	{
-			 		first = false;
-			 		//use elements 0 - 7
-			 		
-			 		string id = results[0];
+	CharacterData* Font::GetDataForCharacter(char c)
+	{
+		return GetDataForCodepoint(U32(U8(c)));
+	}
 
-					string x = results[1];
+	CharacterData* Font::GetDataForCodepoint(U32 codepoint)
+	{
+		if(codepoint < _flatIndex.size())
+		{
+			U32 index = _flatIndex[codepoint];
 
-			 		string y = results[2];
+			return index == _NO_GLYPH ? NULL : &_glyphs[index];
+		}
 
-			 		string width = results[3];
+		if(codepoint < _FLAT_LIMIT || _hashIndex.empty()) { return NULL; }
 
-			 		string height = results[4];
+		auto found = _hashIndex.find(codepoint);
 
-			 		string xoffset = results[5];
+		if(found == _hashIndex.end()) { return NULL; }
 
-			 		string yoffset = results[6];
+		return &_glyphs[found->second];
+	}
 
-			 		string xadvance = results[7];
+	S32 Font::GetKerning(U32 first, U32 second) const
+	{
+		KerningPair key;
+		key.first = first;
+		key.second = second;
+		key.amount = 0;
 
-			 		_AddNewCharacterData(id, x, y, width, height, xoffset, yoffset, xadvance);
+		auto found = std::lower_bound(_kernings.begin(), _kernings.end(), key, KerningLess);
 
-				 	results.erase(results.begin(), results.begin()+9);
-				 	continue;
-			 	}
-			 	//after first, use elements 1 - 8
-			 	//need to skip char keyword
-			 	string id = results[1];
+		if(found == _kernings.end() || found->first != first || found->second != second) { return 0; }
 
-				string x = results[2];
+		return found->amount;
+	}
 
-		 		string y = results[3];
+	CharSprite* Font::CreateCharacter(char character)
+	{
+		CharacterData* data = GetDataForCharacter(character);
 
-		 		string width = results[4];
+		if(data == NULL) { return NULL; }
 
-		 		string height = results[5];
+		CharSprite* charSprite = new CharSprite();
 
-		 		string xoffset = results[6];
+		charSprite->SetCharID(data->id);
+		charSprite->SetCharX(data->x);
+	    charSprite->SetCharY(data->y);
+	    charSprite->SetCharWidth(data->width);
+	    charSprite->SetCharHeight(data->height);
+	    charSprite->SetXOffset(data->xoffset);
+	    charSprite->SetYOffset(data->yoffset);
+	    charSprite->SetXAdvance(data->xadvance);
 
-		 		string yoffset = results[7];
+		return charSprite;
+	}
 
-		 		string xadvance = results[8];
+//==========================================================================================================================
+//
+//Private Functions
+//
+//==========================================================================================================================
+	void Font::_Clear(void)
+	{
+		_lineHeight = 0;
+		_base = 0;
+		_glyphs.clear();
+		_flatIndex.clear();
+		_hashIndex.clear();
+		_kernings.clear();
+		_stats = FontStats();
+	}
 
-		 		_AddNewCharacterData(id, x, y, width, height, xoffset, yoffset, xadvance);
-		 
-			 	results.erase(results.begin(), results.begin() + 10);
-			 }
+//Every line is a tag followed by key=value pairs. Only the keys the engine uses are looked at,
+//quoted values are skipped whole, so a face name with spaces in it does not matter.
+	void Font::_ParseText(const char* text, const char* end)
+	{
+		const char* c = text;
 
-			 file.close();
+		while(c < end)
+		{
+			while(c < end && (*c == ' ' || *c == '\t' || *c == '\r' || *c == '\n')) { ++c; }
+
+			const char* tag = c;
+			while(c < end && *c > ' ') { ++c; }
+			const char* tagEnd = c;
+
+			bool isChar = WordIs(tag, tagEnd, "char");
+			bool isKerning = WordIs(tag, tagEnd, "kerning");
+			bool isCommon = WordIs(tag, tagEnd, "common");
+
+			CharacterData glyph = CharacterData();
+			KerningPair kerning = KerningPair();
+
+			while(c < end && *c != '\n')
+			{
+				if(*c <= ' ')
+				{
+					++c;
+					continue;
+				}
+
+				const char* key = c;
+				while(c < end && *c != '=' && *c > ' ') { ++c; }
+				const char* keyEnd = c;
+
+				if(c == end || *c != '=') { continue; }
+
+				++c;
+
+				if(c == end || *c <= ' ') { continue; }
+
+				if(*c == '"')
+				{
+					++c;
+					while(c < end && *c != '"' && *c != '\n') { ++c; }
+					if(c < end && *c == '"') { ++c; }
+
+					continue;
+				}
+
+				char* next = NULL;
+				S32 value = (S32)strtol(c, &next, 10);
+				c = next;
+
+				//=====Anything after the number, such as the rest of padding=1,1,1,1=====
+				while(c < end && *c > ' ') { ++c; }
+
+				if(isChar)
+				{
+					if(WordIs(key, keyEnd, "id")) 			 { glyph.id = (U32)value; }
+					else if(WordIs(key, keyEnd, "x")) 		 { glyph.x = (U32)value; }
+					else if(WordIs(key, keyEnd, "y")) 		 { glyph.y = (U32)value; }
+					else if(WordIs(key, keyEnd, "width")) 	 { glyph.width = (U32)value; }
+					else if(WordIs(key, keyEnd, "height")) 	 { glyph.height = (U32)value; }
+					else if(WordIs(key, keyEnd, "xoffset"))  { glyph.xoffset = value; }
+					else if(WordIs(key, keyEnd, "yoffset"))  { glyph.yoffset = value; }
+					else if(WordIs(key, keyEnd, "xadvance")) { glyph.xadvance = (U32)value; }
+				}
+				else if(isKerning)
+				{
+					if(WordIs(key, keyEnd, "first")) 		 { kerning.first = (U32)value; }
+					else if(WordIs(key, keyEnd, "second")) 	 { kerning.second = (U32)value; }
+					else if(WordIs(key, keyEnd, "amount")) 	 { kerning.amount = value; }
+				}
+				else if(isCommon)
+				{
+					if(WordIs(key, keyEnd, "lineHeight")) 	 { _lineHeight = (U32)value; }
+					else if(WordIs(key, keyEnd, "base")) 	 { _base = (U32)value; }
+				}
+			}
+
+			if(isChar) { _AddGlyph(glyph); }
+			else if(isKerning) { _kernings.push_back(kerning); }
 		}
-			
-	}//InitFont
+	}
 
-	CharacterData* Font::GetDataForCharacter(char c)
+//The binary file is BMF, a version byte, then blocks of a type byte, a 4 byte size and the data.
+//Only version 3, what BMFont writes now, is read. Info and pages are skipped.
+	bool Font::_ParseBinary(const U8* data, const U8* end)
 	{
-		U32 id = U32(c);
+		if(data[3] != 3) { return false; }
+
+		const U8* block = data + 4;
+
+		while(block < end)
+		{
+			if(end - block < 5) { return false; }
+
+			U8 type = block[0];
+			U32 size = ReadU32(block + 1);
+			const U8* body = block + 5;
+
+			if((U32)(end - body) < size) { return false; }
+
+			switch(type)
+			{
+			case 2:
+				if(size < 4) { return false; }
+
+				_lineHeight = ReadU16(body);
+				_base = ReadU16(body + 2);
+				break;
+			case 4:
+				_glyphs.reserve(_glyphs.size() + size / 20);
+
+				for(U32 i = 0; i + 20 <= size; i += 20)
+				{
+					const U8* c = body + i;
+
+					CharacterData glyph;
+					glyph.id = ReadU32(c);
+					glyph.x = ReadU16(c + 4);
+					glyph.y = ReadU16(c + 6);
+					glyph.width = ReadU16(c + 8);
+					glyph.height = ReadU16(c + 10);
+					glyph.xoffset = ReadS16(c + 12);
+					glyph.yoffset = ReadS16(c + 14);
+					glyph.xadvance = (U32)ReadS16(c + 16);
+
+					_AddGlyph(glyph);
+				}
+				break;
+			case 5:
+				_kernings.reserve(_kernings.size() + size / 10);
+
+				for(U32 i = 0; i + 10 <= size; i += 10)
+				{
+					const U8* k = body + i;
+
+					KerningPair kerning;
+					kerning.first = ReadU32(k);
+					kerning.second = ReadU32(k + 4);
+					kerning.amount = ReadS16(k + 8);
+
+					_kernings.push_back(kerning);
+				}
+				break;
+			default:
+				break;
+			}
+
+			block = body + size;
+		}
 
-		return _fontCharData[id];
+		return true;
 	}
 
-	CharSprite* Font::CreateCharacter(char character)
+//A glyph that comes twice replaces the first one, as it did when these were kept in a map.
+	void Font::_AddGlyph(const CharacterData& glyph)
 	{
-		U32 id = U32(character);
+		CharacterData* existing = GetDataForCodepoint(glyph.id);
 
-		CharSprite* charSprite = new CharSprite();
+		if(existing != NULL)
+		{
+			*existing = glyph;
+			return;
+		}
+
+		U32 index = (U32)_glyphs.size();
+		_glyphs.push_back(glyph);
+
+		if(glyph.id < _FLAT_LIMIT)
+		{
+			if(glyph.id >= _flatIndex.size()) { _flatIndex.resize(glyph.id + 1, U32(_NO_GLYPH)); }
 
-		charSprite->SetCharID(id);
-		charSprite->SetCharX(_fontCharData[id]->x); 
-	    charSprite->SetCharY(_fontCharData[id]->y); 
-	    charSprite->SetCharWidth(_fontCharData[id]->width); 
-	    charSprite->SetCharHeight(_fontCharData[id]->height); 
-	    charSprite->SetXOffset(_fontCharData[id]->xoffset); 
-	    charSprite->SetYOffset(_fontCharData[id]->yoffset); 
-	    charSprite->SetXAdvance(_fontCharData[id]->xadvance);
-		
-		return charSprite;	 		
+			_flatIndex[glyph.id] = index;
+		}
+		else
+		{
+			_hashIndex[glyph.id] = index;
+		}
 	}
 
-	void Font::_AddNewCharacterData(string id,      string x, 		string y,
-							    	string width,   string height,  string xoffset,
-							    	string yoffset, string xadvance)
+	void Font::_SortKernings(void)
 	{
-		//Make ID avilable first
- 		id.erase(id.begin(), id.begin() + id.find_first_of("=")+1);
- 		
- 		U32 charID = std::stoul(id);
-
- 		_fontCharData.insert(std::pair<U32, CharacterData*>(charID, new CharacterData()));
-
- 		//Create CharacterData for the given character
- 		_fontCharData[charID]->id = std::stoi(id);
-
- 		x.erase(x.begin(), x.begin() + x.find_first_of("=")+1);
- 		_fontCharData[charID]->x = std::stoi(x);
- 		
- 		y.erase(y.begin(), y.begin() + y.find_first_of("=")+1);
- 		_fontCharData[charID]->y = std::stoi(y);
- 		
- 		width.erase(width.begin(), width.begin() + width.find_first_of("=")+1);
- 		_fontCharData[charID]->width = std::stoi(width);
- 		
- 		height.erase(height.begin(), height.begin() + height.find_first_of("=")+1);
- 		_fontCharData[charID]->height = std::stoi(height);
- 		
- 		xoffset.erase(xoffset.begin(), xoffset.begin() + xoffset.find_first_of("=")+1);
- 		_fontCharData[charID]->xoffset = std::stoi(xoffset);
- 		
- 		yoffset.erase(yoffset.begin(), yoffset.begin() + yoffset.find_first_of("=")+1);
- 		_fontCharData[charID]->yoffset = std::stoi(yoffset);
- 		
- 		xadvance.erase(xadvance.begin(), xadvance.begin() + xadvance.find_first_of("=")+1);
- 		_fontCharData[charID]->xadvance = std::stoi(xadvance);
+		std::stable_sort(_kernings.begin(), _kernings.end(), KerningLess);
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,214 @@
+#include <Engine/GLRenderBackend.h>
+
+namespace KillerEngine
+{
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+	GLRenderBackend::GLRenderBackend(void) : _vertexArrayObject(0), 
+											 _quadBuffer(0),
+											 _stream(), 
+											 _regionSize(1 << 20), 
+											 _initialized(false),
+											 _queryIndex(0),
+											 _queryOpen(false),
+											 _timingEnabled(false),
+											 _lastGPUTime(0.0f),
+											 _totalGPUTime(0.0),
+											 _timedFrames(0),
+											 _view(NULL),
+											 _viewVersion(0)
+	{
+		for(U32 i = 0; i < _QUERY_COUNT; ++i)
+		{
+			_queries[i] = 0;
+			_queryPending[i] = false;
+		}
+	}
+
+	GLRenderBackend::~GLRenderBackend(void)
+	{
+		if(!_initialized) { return; }
+
+		_stream.ShutDown();
+		glDeleteQueries(_QUERY_COUNT, _queries);
+		glDeleteBuffers(1, &_quadBuffer);
+		GLStateCache::Instance()->ForgetVertexArray(_vertexArrayObject);
+		glDeleteVertexArrays(1, &_vertexArrayObject);
+	}
+
+//==========================================================================================================================
+//
+//Virtual Functions
+//
+//==========================================================================================================================
+	void GLRenderBackend::v_Init(void)
+	{
+		if(_initialized) { return; }
+
+		glGenVertexArrays(1, &_vertexArrayObject);
+		glBindVertexArray(_vertexArrayObject);
+		_stream.Init(GL_ARRAY_BUFFER, _regionSize);
+
+		//=====The corners are in triangle strip order, the same order the geometry shaders emit=====
+		static const F32 corners[] = { -1.0f, -1.0f, -1.0f, 1.0f, 1.0f, -1.0f, 1.0f, 1.0f };
+
+		glGenBuffers(1, &_quadBuffer);
+		glBindBuffer(GL_ARRAY_BUFFER, _quadBuffer);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+
+		glGenQueries(_QUERY_COUNT, _queries);
+
+		_initialized = true;
+	}
+
+	void GLRenderBackend::v_UseShader(GLuint shader)
+	{
+		GLStateCache::Instance()->UseProgram(shader);
+
+		if(_view != NULL) { Camera::Instance()->SetUp(shader, *_view, _viewVersion); }
+		else { Camera::Instance()->SetUp(shader); }
+	}
+
+	void GLRenderBackend::v_BindTexture(U32 textureID)
+	{
+		TextureManager::Instance()->SetCurrentTextureID(textureID);
+	}
+
+//The blend and divisors are set once for the whole batch, each piece only moves the attributes.
+	void GLRenderBackend::v_DrawBatch(const RenderBatch& batch)
+	{
+		U32 capacity = v_GetBatchCapacity();
+
+		if(capacity == 0) { return; }
+
+		if(batch.textured)
+		{
+			glEnable(GL_BLEND); 
+			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		}
+
+		for(U32 first = 0; first < batch.count; first += capacity)
+		{
+			U32 count = batch.count - first < capacity ? batch.count - first : capacity;
+			U32 bytes = sizeof(SpriteVertex) * count;
+			U32 offset = 0;
+
+			void* dest = _stream.Reserve(bytes, offset);
+
+			if(dest == NULL) { return; }
+
+			memcpy(dest, batch.vertices + first, bytes);
+			_stream.Commit();
+
+			_stream.Bind();
+			SpriteVertex::SetAttributes(offset);
+
+			if(first == 0) { _SetInstanced(_vertexArrayObject, batch.instanced); }
+
+			if(batch.instanced) { glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, count); }
+			else { glDrawArrays(GL_POINTS, 0, count); }
+		}
+	}
+
+	void GLRenderBackend::v_DrawStatic(GLuint vertexArray, U32 count, bool blend, bool instanced)
+	{
+		if(blend)
+		{
+			glEnable(GL_BLEND);
+			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		}
+
+		glBindVertexArray(vertexArray);
+		_SetInstanced(vertexArray, instanced);
+
+		if(instanced) { glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, count); }
+		else { glDrawArrays(GL_POINTS, 0, count); }
+
+		glBindVertexArray(_vertexArrayObject);
+	}
+
+	void GLRenderBackend::v_BeginFrame(void)
+	{
+		if(!_timingEnabled || !_initialized) { return; }
+
+		_ReadQueries();
+
+		//=====Every query is still in flight, skip timing this frame rather than wait=====
+		if(_queryPending[_queryIndex]) { return; }
+
+		glBeginQuery(GL_TIME_ELAPSED, _queries[_queryIndex]);
+		_queryOpen = true;
+	}
+
+	void GLRenderBackend::v_EndFrame(void)
+	{
+		if(!_queryOpen) { return; }
+
+		glEndQuery(GL_TIME_ELAPSED);
+		_queryOpen = false;
+		_queryPending[_queryIndex] = true;
+		_queryIndex = (_queryIndex + 1) % _QUERY_COUNT;
+	}
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+	void GLRenderBackend::ResetTiming(void)
+	{
+		_lastGPUTime = 0.0f;
+		_totalGPUTime = 0.0;
+		_timedFrames = 0;
+	}
+
+//==========================================================================================================================
+//
+//Private Functions
+//
+//==========================================================================================================================
+//The divisors belong to the bound vertex array, so they are set for every draw. Attribute 5 is 
+//only read by the instanced shaders, and is turned off again for points so a point draw never
+//reads the quad. The cache keeps it from being turned on or off when it already is.
+	void GLRenderBackend::_SetInstanced(GLuint vertexArray, bool state)
+	{
+		SpriteVertex::SetDivisor(state ? 1 : 0);
+
+		if(!state)
+		{
+			GLStateCache::Instance()->SetVertexAttribute(vertexArray, 5, false);
+			return;
+		}
+
+		glBindBuffer(GL_ARRAY_BUFFER, _quadBuffer);
+		glVertexAttribPointer(5, 2, GL_FLOAT, GL_FALSE, 0, 0);
+		GLStateCache::Instance()->SetVertexAttribute(vertexArray, 5, true);
+	}
+
+//Oldest first, so _lastGPUTime ends up as the newest frame that has finished.
+	void GLRenderBackend::_ReadQueries(void)
+	{
+		for(U32 n = 0; n < _QUERY_COUNT; ++n)
+		{
+			U32 i = (_queryIndex + n) % _QUERY_COUNT;
+
+			if(!_queryPending[i]) { continue; }
+
+			GLint available = 0;
+			glGetQueryObjectiv(_queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+
+			if(!available) { continue; }
+
+			GLuint64 nanoseconds = 0;
+			glGetQueryObjectui64v(_queries[i], GL_QUERY_RESULT, &nanoseconds);
+
+			_queryPending[i] = false;
+			_lastGPUTime = (F32)(nanoseconds / 1000000.0);
+			_totalGPUTime += _lastGPUTime;
+			++_timedFrames;
+		}
+	}
+}//End namespace
@@ -0,0 +1,212 @@
+#include <Engine/GLStateCache.h>
+
+namespace KillerEngine
+{
+//==========================================================================================================================
+//
+//Singleton Functions
+//
+//==========================================================================================================================
+	GLStateCache* GLStateCache::_instance = NULL;
+
+	GLStateCache* GLStateCache::Instance(void)
+	{
+		if(_instance == NULL) { _instance = new GLStateCache(); }
+		return _instance;
+	}
+
+//==========================================================================================================================
+//
+//State Functions
+//
+//==========================================================================================================================
+	void GLStateCache::UseProgram(GLuint program)
+	{
+		if(_programKnown && _program == program)
+		{
+			++_counters.programBindsElided;
+			return;
+		}
+
+		glUseProgram(program);
+		_program = program;
+		_programKnown = true;
+		++_counters.programBinds;
+	}
+
+//Everything is drawn from unit 0, so it is made active once, the first time after the cache is
+//made or invalidated.
+	void GLStateCache::BindTexture(GLuint texture)
+	{
+		if(_textureKnown && _texture == texture)
+		{
+			++_counters.textureBindsElided;
+			return;
+		}
+
+		if(!_textureKnown) { glActiveTexture(GL_TEXTURE0); }
+
+		glBindTexture(GL_TEXTURE_2D, texture);
+		_texture = texture;
+		_textureKnown = true;
+		++_counters.textureBinds;
+	}
+
+	GLint GLStateCache::GetUniformLocation(GLuint program, const GLchar* name)
+	{
+		return _FindUniform(program, name)->location;
+	}
+
+	void GLStateCache::UniformMatrix4(GLuint program, const GLchar* name, const F32* data, U32 version)
+	{
+		CachedUniform* uniform = _FindUniform(program, name);
+
+		if(uniform->version == version)
+		{
+			++_counters.uniformUploadsElided;
+			return;
+		}
+
+		glUniformMatrix4fv(uniform->location, 1, GL_FALSE, data);
+		uniform->version = version;
+		++_counters.uniformUploads;
+	}
+
+	void GLStateCache::CacheProgram(GLuint program)
+	{
+		if(program == 0) { return; }
+
+		_FindUniform(program, "perspective_mat");
+		_FindUniform(program, "modelView_mat");
+	}
+
+	void GLStateCache::ForgetProgram(GLuint program)
+	{
+		for(auto i = _programs.begin(); i != _programs.end(); ++i)
+		{
+			if(i->program == program)
+			{
+				_programs.erase(i);
+				break;
+			}
+		}
+
+		if(_program == program) { _programKnown = false; }
+	}
+
+//Attributes past 31 are not cached, no sprite layout comes close.
+	void GLStateCache::SetVertexAttribute(GLuint vertexArray, GLuint index, bool enabled)
+	{
+		if(index >= 32)
+		{
+			if(enabled) { glEnableVertexAttribArray(index); }
+			else { glDisableVertexAttribArray(index); }
+			return;
+		}
+
+		CachedVertexArray* cached = NULL;
+
+		for(U32 i = 0; i < _vertexArrays.size() && cached == NULL; ++i)
+		{
+			if(_vertexArrays[i].vertexArray == vertexArray) { cached = &_vertexArrays[i]; }
+		}
+
+		if(cached == NULL)
+		{
+			CachedVertexArray added;
+			added.vertexArray = vertexArray;
+			added.enabled = 0;
+			added.known = 0;
+			_vertexArrays.push_back(added);
+			cached = &_vertexArrays.back();
+		}
+
+		U32 bit = 1u << index;
+
+		if((cached->known & bit) != 0 && ((cached->enabled & bit) != 0) == enabled)
+		{
+			++_counters.attributeChangesElided;
+			return;
+		}
+
+		if(enabled) { glEnableVertexAttribArray(index); }
+		else { glDisableVertexAttribArray(index); }
+
+		cached->known |= bit;
+		cached->enabled = enabled ? cached->enabled | bit : cached->enabled & ~bit;
+		++_counters.attributeChanges;
+	}
+
+	void GLStateCache::ForgetVertexArray(GLuint vertexArray)
+	{
+		for(auto i = _vertexArrays.begin(); i != _vertexArrays.end(); ++i)
+		{
+			if(i->vertexArray == vertexArray)
+			{
+				_vertexArrays.erase(i);
+				break;
+			}
+		}
+	}
+
+	void GLStateCache::Invalidate(void)
+	{
+		_programKnown = false;
+		_textureKnown = false;
+		_vertexArrays.clear();
+	}
+
+//==========================================================================================================================
+//
+//Private Functions
+//
+//==========================================================================================================================
+	GLStateCache::CachedProgram* GLStateCache::_FindProgram(GLuint program)
+	{
+		for(U32 i = 0; i < _programs.size(); ++i)
+		{
+			if(_programs[i].program == program) { return &_programs[i]; }
+		}
+
+		CachedProgram added;
+		added.program = program;
+		_programs.push_back(added);
+
+		return &_programs.back();
+	}
+
+//Names are compared by pointer first, as they are almost always the same string literal, and by
+//value if that misses. The name must outlive the program, which a literal always does.
+	GLStateCache::CachedUniform* GLStateCache::_FindUniform(GLuint program, const GLchar* name)
+	{
+		CachedProgram* cached = _FindProgram(program);
+
+		for(U32 i = 0; i < cached->uniforms.size(); ++i)
+		{
+			CachedUniform& uniform = cached->uniforms[i];
+
+			if(uniform.name == name || strcmp(uniform.name, name) == 0)
+			{
+				++_counters.locationHits;
+				return &uniform;
+			}
+		}
+
+		CachedUniform added;
+		added.name = name;
+		added.location = glGetUniformLocation(program, name);
+		added.version = 0;
+		cached->uniforms.push_back(added);
+		++_counters.locationLookups;
+
+		return &cached->uniforms.back();
+	}
+
+//==========================================================================================================================
+//
+//Constructor
+//
+//==========================================================================================================================
+	GLStateCache::GLStateCache(void) : _programs(), _vertexArrays(), _program(0), _texture(0), _programKnown(false), _textureKnown(false), _counters()
+	{  }
+}//End namespace
@@ -2,7 +2,7 @@
 
 namespace KillerEngine
 {
-	U32 GameObject3D::_nextID = 1; 
+	std::atomic<U32> GameObject3D::_nextID(1); 
 
 //==========================================================================================================================
 //
@@ -0,0 +1,63 @@
+#include <Engine/GameObjectHostSystem.h>
+
+namespace KillerEngine
+{
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+	GameObjectHostSystem::GameObjectHostSystem(void) 
+		: EntitySystem(ComponentBit<GameObject2DComponent>() | ComponentBit<Position2D>(), ~ComponentMask(0), ~ComponentMask(0), true)
+	{  }
+
+//==========================================================================================================================
+//
+//Virtual Functions
+//
+//==========================================================================================================================
+	void GameObjectHostSystem::v_UpdateChunk(ChunkRef& chunk)
+	{
+		GameObject2DComponent* objects = chunk.Get<GameObject2DComponent>();
+		Position2D* positions = chunk.Get<Position2D>();
+
+		for(U32 i = 0; i < chunk.Count(); ++i)
+		{
+			objects[i].object->v_Update();
+			positions[i].value = objects[i].object->GetPosition();
+		}
+	}
+
+//==========================================================================================================================
+//
+//GameObjectHostSystem Functions
+//
+//==========================================================================================================================
+	Entity GameObjectHostSystem::Host(EntityManager& entities, GameObject2D* obj)
+	{
+		Entity entity = entities.CreateEntity();
+
+		GameObject2DComponent hosted;
+		hosted.object = obj;
+		entities.AddComponent(entity, hosted);
+
+		Position2D position;
+		position.value = obj->GetPosition();
+		entities.AddComponent(entity, position);
+
+		return entity;
+	}
+
+	void GameObjectHostSystem::Render(EntityManager& entities)
+	{
+		entities.ForEachChunk(ComponentBit<GameObject2DComponent>(), [](ChunkRef& chunk)
+		{
+			GameObject2DComponent* objects = chunk.Get<GameObject2DComponent>();
+
+			for(U32 i = 0; i < chunk.Count(); ++i)
+			{
+				objects[i].object->v_Render();
+			}
+		});
+	}
+}//End namespace
@@ -0,0 +1,388 @@
+#include <Engine/GridSearch.h>
+
+namespace KillerEngine
+{
+	static const F32 DIAGONAL_COST = 1.41421356f;
+
+	static const S32 DIRECTION_X[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+	static const S32 DIRECTION_Y[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+	static inline S32 Sign(S32 v)
+	{
+		return (v > 0) - (v < 0);
+	}
+
+	static inline F32 Octile(S32 dx, S32 dy)
+	{
+		if(dx < 0) { dx = -dx; }
+		if(dy < 0) { dy = -dy; }
+
+		S32 low = dx < dy ? dx : dy;
+		S32 high = dx < dy ? dy : dx;
+
+		return (F32)(high - low) + DIAGONAL_COST * (F32)low;
+	}
+
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+	GridSearch::GridSearch(void) : _layer(NULL), 
+								   _blocking(TC_SOLID), 
+								   _width(0), 
+								   _height(0), 
+								   _search(0), 
+								   _expanded(0), 
+								   _goal(), 
+								   _g(), 
+								   _parent(), 
+								   _seen(), 
+								   _closed(), 
+								   _open()
+	{  }
+
+//==========================================================================================================================
+//
+//GridSearch Functions
+//
+//==========================================================================================================================
+	void GridSearch::SetGrid(const TileCollisionLayer* layer, U8 blockingFlags)
+	{
+		_layer = layer;
+		_blocking = blockingFlags;
+		_width = layer == NULL ? 0 : (S32)layer->GetWidth();
+		_height = layer == NULL ? 0 : (S32)layer->GetHeight();
+
+		U32 size = (U32)(_width * _height);
+
+		if(_g.size() != size)
+		{
+			_g.assign(size, 0.0f);
+			_parent.assign(size, -1);
+			_seen.assign(size, 0);
+			_closed.assign(size, 0);
+			_search = 0;
+		}
+	}
+
+	bool GridSearch::FindPath(GridPoint start, GridPoint goal, std::vector<GridPoint>& out)
+	{
+		if(!_Begin(start, goal)) { return false; }
+
+		S32 goalCell = goal.y * _width + goal.x;
+		S32 cell;
+
+		while((cell = _PopOpen()) != -1)
+		{
+			if(cell == goalCell)
+			{
+				_BuildPath(cell, out);
+				return true;
+			}
+
+			++_expanded;
+
+			S32 x = cell % _width;
+			S32 y = cell / _width;
+
+			for(U32 d = 0; d < 8; ++d)
+			{
+				S32 dx = DIRECTION_X[d];
+				S32 dy = DIRECTION_Y[d];
+
+				if(!IsWalkable(x + dx, y + dy)) { continue; }
+				if(dx != 0 && dy != 0 && (!IsWalkable(x + dx, y) || !IsWalkable(x, y + dy))) { continue; }
+
+				S32 next = (y + dy) * _width + (x + dx);
+
+				if(_closed[next] == _search) { continue; }
+
+				_Push(next, _g[cell] + (dx != 0 && dy != 0 ? DIAGONAL_COST : 1.0f), cell);
+			}
+		}
+
+		return false;
+	}
+
+	bool GridSearch::FindPathJPS(GridPoint start, GridPoint goal, std::vector<GridPoint>& out)
+	{
+		if(!_Begin(start, goal)) { return false; }
+
+		S32 goalCell = goal.y * _width + goal.x;
+		S32 cell;
+
+		while((cell = _PopOpen()) != -1)
+		{
+			if(cell == goalCell)
+			{
+				_BuildPath(cell, out);
+				return true;
+			}
+
+			++_expanded;
+
+			S32 x = cell % _width;
+			S32 y = cell / _width;
+
+			//=====Work out which neighbors are worth jumping toward=====
+			S32 neighborX[8];
+			S32 neighborY[8];
+			U32 count = 0;
+
+			if(_parent[cell] == -1)
+			{
+				for(U32 d = 0; d < 8; ++d)
+				{
+					S32 dx = DIRECTION_X[d];
+					S32 dy = DIRECTION_Y[d];
+
+					if(!IsWalkable(x + dx, y + dy)) { continue; }
+					if(dx != 0 && dy != 0 && (!IsWalkable(x + dx, y) || !IsWalkable(x, y + dy))) { continue; }
+
+					neighborX[count] = dx;
+					neighborY[count] = dy;
+					++count;
+				}
+			}
+			else
+			{
+				S32 dx = Sign(x - _parent[cell] % _width);
+				S32 dy = Sign(y - _parent[cell] / _width);
+
+				if(dx != 0 && dy != 0)
+				{
+					bool vertical = IsWalkable(x, y + dy);
+					bool horizontal = IsWalkable(x + dx, y);
+
+					if(vertical) { neighborX[count] = 0; neighborY[count] = dy; ++count; }
+					if(horizontal) { neighborX[count] = dx; neighborY[count] = 0; ++count; }
+					if(vertical && horizontal) { neighborX[count] = dx; neighborY[count] = dy; ++count; }
+				}
+				else if(dx != 0)
+				{
+					bool next = IsWalkable(x + dx, y);
+					bool up = IsWalkable(x, y + 1);
+					bool down = IsWalkable(x, y - 1);
+
+					if(next)
+					{
+						neighborX[count] = dx; neighborY[count] = 0; ++count;
+						if(up) { neighborX[count] = dx; neighborY[count] = 1; ++count; }
+						if(down) { neighborX[count] = dx; neighborY[count] = -1; ++count; }
+					}
+
+					if(up) { neighborX[count] = 0; neighborY[count] = 1; ++count; }
+					if(down) { neighborX[count] = 0; neighborY[count] = -1; ++count; }
+				}
+				else
+				{
+					bool next = IsWalkable(x, y + dy);
+					bool right = IsWalkable(x + 1, y);
+					bool left = IsWalkable(x - 1, y);
+
+					if(next)
+					{
+						neighborX[count] = 0; neighborY[count] = dy; ++count;
+						if(right) { neighborX[count] = 1; neighborY[count] = dy; ++count; }
+						if(left) { neighborX[count] = -1; neighborY[count] = dy; ++count; }
+					}
+
+					if(right) { neighborX[count] = 1; neighborY[count] = 0; ++count; }
+					if(left) { neighborX[count] = -1; neighborY[count] = 0; ++count; }
+				}
+			}
+
+			//=====Jump from each one, and only open the jump points=====
+			for(U32 n = 0; n < count; ++n)
+			{
+				GridPoint jumpPoint;
+
+				if(!_Jump(x + neighborX[n], y + neighborY[n], neighborX[n], neighborY[n], jumpPoint)) { continue; }
+
+				S32 next = jumpPoint.y * _width + jumpPoint.x;
+
+				if(_closed[next] == _search) { continue; }
+
+				_Push(next, _g[cell] + Octile(jumpPoint.x - x, jumpPoint.y - y), cell);
+			}
+		}
+
+		return false;
+	}
+
+//==========================================================================================================================
+//
+//Private Functions
+//
+//==========================================================================================================================
+	bool GridSearch::_Begin(GridPoint start, GridPoint goal)
+	{
+		if(_layer == NULL)
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "GridSearch -> No grid has been set.");
+			return false;
+		}
+
+		//=====The layer may have been resized since SetGrid=====
+		if(_width != (S32)_layer->GetWidth() || _height != (S32)_layer->GetHeight()) { SetGrid(_layer, _blocking); }
+
+		if(!IsWalkable(start.x, start.y) || !IsWalkable(goal.x, goal.y)) { return false; }
+
+		++_search;
+
+		//=====The stamps wrapped, so they have to really be cleared once=====
+		if(_search == 0)
+		{
+			std::fill(_seen.begin(), _seen.end(), 0);
+			std::fill(_closed.begin(), _closed.end(), 0);
+			_search = 1;
+		}
+
+		_open.clear();
+		_expanded = 0;
+		_goal = goal;
+
+		_Push(start.y * _width + start.x, 0.0f, -1);
+
+		return true;
+	}
+
+	void GridSearch::_Push(S32 cell, F32 g, S32 parent)
+	{
+		if(_seen[cell] == _search && g >= _g[cell]) { return; }
+
+		_seen[cell] = _search;
+		_g[cell] = g;
+		_parent[cell] = parent;
+
+		HeapEntry entry;
+		entry.f = g + _Heuristic(cell % _width, cell / _width);
+		entry.cell = cell;
+
+		_open.push_back(entry);
+		std::push_heap(_open.begin(), _open.end(), std::greater<HeapEntry>());
+	}
+
+	S32 GridSearch::_PopOpen(void)
+	{
+		//=====Cells can be pushed more than once, the stale copies are skipped here=====
+		while(!_open.empty())
+		{
+			std::pop_heap(_open.begin(), _open.end(), std::greater<HeapEntry>());
+			S32 cell = _open.back().cell;
+			_open.pop_back();
+
+			if(_closed[cell] == _search) { continue; }
+
+			_closed[cell] = _search;
+			return cell;
+		}
+
+		return -1;
+	}
+
+	F32 GridSearch::_Heuristic(S32 x, S32 y) const
+	{
+		return Octile(_goal.x - x, _goal.y - y);
+	}
+
+	bool GridSearch::_Jump(S32 x, S32 y, S32 dx, S32 dy, GridPoint& jumpPoint) const
+	{
+		if(dx == 0 || dy == 0) { return _JumpStraight(x, y, dx, dy, jumpPoint); }
+
+		GridPoint found;
+
+		while(IsWalkable(x, y))
+		{
+			if(x == _goal.x && y == _goal.y) 
+			{
+				jumpPoint = GridPoint(x, y);
+				return true; 
+			}
+
+			//=====A diagonal stops anywhere a straight jump from it would find something=====
+			if(_JumpStraight(x + dx, y, dx, 0, found) || _JumpStraight(x, y + dy, 0, dy, found))
+			{
+				jumpPoint = GridPoint(x, y);
+				return true;
+			}
+
+			if(!IsWalkable(x + dx, y) || !IsWalkable(x, y + dy)) { return false; }
+
+			x += dx;
+			y += dy;
+		}
+
+		return false;
+	}
+
+	bool GridSearch::_JumpStraight(S32 x, S32 y, S32 dx, S32 dy, GridPoint& jumpPoint) const
+	{
+		while(IsWalkable(x, y))
+		{
+			if(x == _goal.x && y == _goal.y) 
+			{
+				jumpPoint = GridPoint(x, y);
+				return true; 
+			}
+
+			//=====Forced neighbors, an opening to the side that was walled off one step back=====
+			if(dx != 0)
+			{
+				if((IsWalkable(x, y - 1) && !IsWalkable(x - dx, y - 1)) || (IsWalkable(x, y + 1) && !IsWalkable(x - dx, y + 1)))
+				{
+					jumpPoint = GridPoint(x, y);
+					return true;
+				}
+			}
+			else
+			{
+				if((IsWalkable(x - 1, y) && !IsWalkable(x - 1, y - dy)) || (IsWalkable(x + 1, y) && !IsWalkable(x + 1, y - dy)))
+				{
+					jumpPoint = GridPoint(x, y);
+					return true;
+				}
+			}
+
+			x += dx;
+			y += dy;
+		}
+
+		return false;
+	}
+
+	void GridSearch::_BuildPath(S32 goalCell, std::vector<GridPoint>& out) const
+	{
+		U32 first = (U32)out.size();
+
+		for(S32 cell = goalCell; cell != -1; cell = _parent[cell])
+		{
+			out.push_back(GridPoint(cell % _width, cell / _width));
+		}
+
+		std::reverse(out.begin() + first, out.end());
+
+		//=====Jump point paths skip tiles, fill them back in. Every gap is a straight or diagonal line=====
+		std::vector<GridPoint> points(out.begin() + first, out.end());
+		out.resize(first);
+
+		for(U32 i = 0; i < points.size(); ++i)
+		{
+			if(i == 0)
+			{
+				out.push_back(points[i]);
+				continue;
+			}
+
+			GridPoint step = points[i - 1];
+
+			while(step != points[i])
+			{
+				step.x += Sign(points[i].x - step.x);
+				step.y += Sign(points[i].y - step.y);
+				out.push_back(step);
+			}
+		}
+	}
+}//End namespace
@@ -0,0 +1,40 @@
+#include <Engine/Integrate2DSystem.h>
+
+namespace KillerEngine
+{
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+	Integrate2DSystem::Integrate2DSystem(void) 
+		: EntitySystem(ComponentBit<Position2D>() | ComponentBit<Velocity2D>() | ComponentBit<Acceleration2D>(),
+					   ComponentBit<Acceleration2D>(),
+					   ComponentBit<Position2D>() | ComponentBit<Velocity2D>(),
+					   false),
+		  _deltaTime(0.0f)
+	{  }
+
+//==========================================================================================================================
+//
+//Virtual Functions
+//
+//==========================================================================================================================
+	void Integrate2DSystem::v_BeginUpdate(F32 delta)
+	{
+		_deltaTime = delta;
+	}
+
+	void Integrate2DSystem::v_UpdateChunk(ChunkRef& chunk)
+	{
+		Position2D* positions = chunk.Get<Position2D>();
+		Velocity2D* velocities = chunk.Get<Velocity2D>();
+		Acceleration2D* accelerations = chunk.Get<Acceleration2D>();
+
+		for(U32 i = 0; i < chunk.Count(); ++i)
+		{
+			velocities[i].value.AddScaledVector(accelerations[i].value, _deltaTime);
+			positions[i].value.AddScaledVector(velocities[i].value, _deltaTime);
+		}
+	}
+}//End namespace
@@ -0,0 +1,202 @@
+#include <Engine/JobPool.h>
+
+namespace KillerEngine
+{
+//==========================================================================================================================
+//
+//Singleton Functions
+//
+//==========================================================================================================================
+	JobPool* JobPool::_instance = NULL;
+
+	JobPool* JobPool::Instance(void)
+	{
+		if(_instance == NULL) { _instance = new JobPool(); }
+		return _instance;
+	}
+
+	void JobPool::Init(U32 workerCount)
+	{
+		if(_initialized) { ShutDown(); }
+
+		_running = true;
+		_initialized = true;
+
+		for(U32 i = 0; i < workerCount; ++i)
+		{
+			_workers.push_back(std::thread(&JobPool::_WorkerLoop, this));
+		}
+	}
+
+	void JobPool::ShutDown(void)
+	{
+		{
+			std::lock_guard<std::mutex> lock(_queueLock);
+			_running = false;
+		}
+		_queueSignal.notify_all();
+
+		for(U32 i = 0; i < _workers.size(); ++i)
+		{
+			_workers[i].join();
+		}
+
+		_workers.clear();
+		_initialized = false;
+	}
+
+//==========================================================================================================================
+//
+//JobPool Functions
+//
+//==========================================================================================================================
+	void JobPool::Submit(JobGroup& group, std::function<void(void)> job)
+	{
+		if(!_initialized)
+		{
+			U32 hardware = std::thread::hardware_concurrency();
+			Init(hardware > 1 ? hardware - 1 : 0);
+		}
+
+		if(_workers.empty())
+		{
+			job();
+			return;
+		}
+
+		_Push(group, std::move(job), NULL);
+	}
+
+	void JobPool::Submit(JobGroup& group, const std::function<void(void)>* job)
+	{
+		if(!_initialized)
+		{
+			U32 hardware = std::thread::hardware_concurrency();
+			Init(hardware > 1 ? hardware - 1 : 0);
+		}
+
+		if(_workers.empty())
+		{
+			(*job)();
+			return;
+		}
+
+		_Push(group, std::function<void(void)>(), job);
+	}
+
+	void JobPool::Wait(JobGroup& group)
+	{
+		std::unique_lock<std::mutex> lock(_queueLock);
+
+		while(!group.Done())
+		{
+			//=====Help out instead of sleeping while there is work=====
+			if(!_RunOne(lock))
+			{
+				_doneSignal.wait(lock);
+			}
+		}
+	}
+
+	void JobPool::ParallelFor(U32 count, U32 grain, const std::function<void(U32 begin, U32 end)>& job)
+	{
+		if(count == 0) { return; }
+		if(grain == 0) { grain = 1; }
+
+		JobGroup group;
+
+		for(U32 begin = 0; begin < count; begin += grain)
+		{
+			U32 end = begin + grain < count ? begin + grain : count;
+
+			Submit(group, [&job, begin, end]() { job(begin, end); });
+		}
+
+		Wait(group);
+	}
+
+//==========================================================================================================================
+//
+//Constructor
+//
+//==========================================================================================================================
+	JobPool::JobPool(void) : _workers(), _queue(), _queueHead(0), _running(false), _initialized(false)
+	{  }
+
+	JobPool::~JobPool(void)
+	{
+		if(_initialized) { ShutDown(); }
+	}
+
+//==========================================================================================================================
+//
+//Private Functions
+//
+//==========================================================================================================================
+	void JobPool::_WorkerLoop(void)
+	{
+		std::unique_lock<std::mutex> lock(_queueLock);
+
+		while(true)
+		{
+			_queueSignal.wait(lock, [this]() { return !_running || !_QueueEmpty(); });
+
+			if(!_running && _QueueEmpty()) { return; }
+
+			_RunOne(lock);
+		}
+	}
+
+	//=====Runs one job with the lock released. Expects the lock to be held=====
+	bool JobPool::_RunOne(std::unique_lock<std::mutex>& lock)
+	{
+		if(_QueueEmpty()) { return false; }
+
+		Job job = std::move(_queue[_queueHead]);
+		++_queueHead;
+
+		//=====Start from the front again once it is empty, or once most of it has been run=====
+		if(_QueueEmpty())
+		{
+			_queue.clear();
+			_queueHead = 0;
+		}
+		else if(_queueHead >= 64 && _queueHead * 2 >= _queue.size())
+		{
+			_queue.erase(_queue.begin(), _queue.begin() + _queueHead);
+			_queueHead = 0;
+		}
+
+		lock.unlock();
+
+		if(job.shared != NULL) { (*job.shared)(); }
+		else { job.work(); }
+
+		lock.lock();
+
+		if(job.group->_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			_doneSignal.notify_all();
+		}
+
+		return true;
+	}
+
+	//=====Expects the lock not to be held=====
+	void JobPool::_Push(JobGroup& group, std::function<void(void)>&& job, const std::function<void(void)>* shared)
+	{
+		group._pending.fetch_add(1, std::memory_order_relaxed);
+
+		{
+			std::lock_guard<std::mutex> lock(_queueLock);
+
+			Job newJob;
+			newJob.work = std::move(job);
+			newJob.shared = shared;
+			newJob.group = &group;
+
+			_queue.push_back(std::move(newJob));
+		}
+		_queueSignal.notify_one();
+	}
+}//End namespace
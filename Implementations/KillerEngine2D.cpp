@@ -14,11 +14,26 @@ namespace KillerEngine
 	{
 		WinProgram::Instance()->Init(width, height, title, fullscreen);
 
+		//=====Start every sprite program building now, so the first frame does not wait on them=====
+		SqrSprite::RequestShaders();
+		CharSprite::RequestShaders();
+		TriSprite::RequestShaders();
+
 		//Controller::Instance()->Init(WinProgram::Instance()->GetHINSTANCE(), WinProgram::Instance()->GetHWND());
 
 		ErrorManager::Instance()->DisplayErrors();
 	}
 
+//=======================================================================================================
+//End
+//=======================================================================================================
+	void KillerEngine2D::End(void)
+	{
+		RenderThread::Instance()->Stop();
+
+		MapManager::Instance()->SetRunning(false);
+	}
+
 //=======================================================================================================
 //Update
 //=======================================================================================================
@@ -40,15 +55,29 @@ namespace KillerEngine
 //=======================================================================================================
 	void KillerEngine2D::Render(void) 
 	{
+		Renderer::Instance()->BeginFrame();
+
 		MapManager::Instance()->Render();
 
 		Renderer::Instance()->Draw();
 
-		WinProgram::Instance()->BufferSwap();
+		Renderer::Instance()->EndFrame();
+
+		//=====The render thread swaps once it has drawn the frame=====
+		if(!RenderThread::Instance()->IsRunning()) { WinProgram::Instance()->BufferSwap(); }
 		
 		ErrorManager::Instance()->DisplayErrors();
 	}
 
+//=======================================================================================================
+//SetThreadedRender
+//=======================================================================================================
+	void KillerEngine2D::SetThreadedRender(bool state)
+	{
+		if(state) { RenderThread::Instance()->Start(); }
+		else { RenderThread::Instance()->Stop(); }
+	}
+
 //==========================================================================================================================
 //
 //Singleton functions
@@ -1,5 +1,4 @@
 #include <Engine/Map.h>
-#include <iostream>
 
 namespace KillerEngine 
 {
@@ -9,32 +8,67 @@ namespace KillerEngine
 			   		 _mapBottomBorder(0),
 			   		 _mapRightBorder(0),
 			   		 _mapLeftBorder(0),
-			   		 _bgColor()
-	{  }
+			   		 _bgColor(),
+			   		 _mapData(),
+			   		 _reloadWatch(0),
+			   		 _useAtlas(true),
+			   		 _backgroundSimulation(false),
+			   		 _tickDivisor(1),
+			   		 _tickFrames(0),
+			   		 _tickAccumulator(0.0f),
+			   		 _tickDelta(0.0f),
+			   		 _parallelRender(false),
+			   		 _renderGrain(256),
+			   		 _culling(false),
+			   		 _cullWithSceneIndex(false),
+			   		 _culler(),
+			   		 _cullCandidates(),
+			   		 _cullResults(),
+			   		 _visible2D(),
+			   		 _cullStats()
+	{
+		_pathfinding.SetGrid(&_collisionLayer);
+	}
 
 //=============================================================================
 //
 //AddObjectToMap
 //
 //=============================================================================
-	void Map::AddObjectToMap(GameObject2D* obj)
+	SlotHandle Map::AddObjectToMap(GameObject2D* obj)
 	{
-		_2DWorldObjects.insert(std::map<U32, GameObject2D*>::value_type(obj->GetID(), obj));
-		
-		if(_2DWorldObjects.find(obj->GetID()) == _2DWorldObjects.end()) 
-		{ 
-			ErrorManager::Instance()->SetError(EC_KillerEngine, "Unable to AddMap to _2DWorldObjects"); 
+		U32 id = obj->GetID();
+
+		if(Get2DHandle(id).IsValid())
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "Unable to AddMap to _2DWorldObjects, ID is already in use");
+			return SlotHandle();
 		}
+
+		SlotHandle handle = _2DWorldObjects.Add(obj);
+		_2DHandles[id] = handle;
+
+		if(obj->GetStatic()) { _staticLayer.Add(obj); }
+
+		_sceneIndex.Insert(id, _ObjectBounds(obj));
+
+		return handle;
 	}
 
-	void Map::AddObjectToMap(GameObject3D* obj)
+	SlotHandle Map::AddObjectToMap(GameObject3D* obj)
 	{
-		_3DWorldObjects.insert(std::map<U32, GameObject3D*>::value_type(obj->GetID(), obj));
-		
-		if(_3DWorldObjects.find(obj->GetID()) == _3DWorldObjects.end()) 
-		{ 
-			ErrorManager::Instance()->SetError(EC_KillerEngine, "Unable to AddMap to _3DWorldObjects"); 
+		U32 id = obj->GetID();
+
+		if(Get3DHandle(id).IsValid())
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "Unable to AddMap to _3DWorldObjects, ID is already in use");
+			return SlotHandle();
 		}
+
+		SlotHandle handle = _3DWorldObjects.Add(obj);
+		_3DHandles[id] = handle;
+
+		return handle;
 	}
 
 	void Map::_AddTile(TileData data)
@@ -54,16 +88,361 @@ namespace KillerEngine
 //=============================================================================
 	void Map::Remove2DObjectFromMap(U32 id)
 	{
-		std::map<U32, GameObject2D*>::iterator i = _2DWorldObjects.find(id);
+		SlotHandle handle = Get2DHandle(id);
+
+		if(!handle.IsValid())
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "Map -> Tried to remove a 2D object that is not in the map.");
+			return;
+		}
 
-		_2DWorldObjects.erase(i);
+		Remove2DObjectFromMap(handle);
+	}
+
+	void Map::Remove2DObjectFromMap(SlotHandle handle)
+	{
+		GameObject2D** obj = _2DWorldObjects.Get(handle);
+
+		if(obj == NULL)
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "Map -> Tried to remove a 2D object with a stale handle.");
+			return;
+		}
+
+		_staticLayer.Remove(*obj);
+		_sceneIndex.Remove((*obj)->GetID());
+		_2DHandles.erase((*obj)->GetID());
+		_2DWorldObjects.Remove(handle);
 	}
 
 	void Map::Remove3DObjectFromMap(U32 id)
 	{
-		std::map<U32, GameObject3D*>::iterator i = _3DWorldObjects.find(id);
+		SlotHandle handle = Get3DHandle(id);
+
+		if(!handle.IsValid())
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "Map -> Tried to remove a 3D object that is not in the map.");
+			return;
+		}
+
+		Remove3DObjectFromMap(handle);
+	}
+
+	void Map::Remove3DObjectFromMap(SlotHandle handle)
+	{
+		GameObject3D** obj = _3DWorldObjects.Get(handle);
+
+		if(obj == NULL)
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "Map -> Tried to remove a 3D object with a stale handle.");
+			return;
+		}
+
+		_3DHandles.erase((*obj)->GetID());
+		_3DWorldObjects.Remove(handle);
+	}
+
+//=============================================================================
+//
+//GetObject
+//
+//=============================================================================
+	SlotHandle Map::Get2DHandle(U32 id) const
+	{
+		auto found = _2DHandles.find(id);
+		return found == _2DHandles.end() ? SlotHandle() : found->second;
+	}
+
+	SlotHandle Map::Get3DHandle(U32 id) const
+	{
+		auto found = _3DHandles.find(id);
+		return found == _3DHandles.end() ? SlotHandle() : found->second;
+	}
+
+	GameObject2D* Map::Get2DObject(U32 id)
+	{
+		return Get2DObject(Get2DHandle(id));
+	}
+
+	GameObject2D* Map::Get2DObject(SlotHandle handle)
+	{
+		GameObject2D** obj = _2DWorldObjects.Get(handle);
+
+		return obj == NULL ? NULL : *obj;
+	}
+
+	GameObject3D* Map::Get3DObject(U32 id)
+	{
+		return Get3DObject(Get3DHandle(id));
+	}
+
+	GameObject3D* Map::Get3DObject(SlotHandle handle)
+	{
+		GameObject3D** obj = _3DWorldObjects.Get(handle);
+
+		return obj == NULL ? NULL : *obj;
+	}
+
+//=============================================================================
+//
+//Static Layer
+//
+//=============================================================================
+	void Map::UpdateStaticObject(U32 id)
+	{
+		GameObject2D* obj = Get2DObject(id);
+
+		if(obj == NULL || !obj->GetStatic())
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "Map -> Tried to update a static object that is not in the map.");
+			return;
+		}
+
+		_staticLayer.MarkDirty(obj);
+		_sceneIndex.Move(id, _ObjectBounds(obj));
+	}
+
+//=============================================================================
+//
+//Scene Index
+//
+//=============================================================================
+	void Map::UpdateSceneIndex(U32 id)
+	{
+		GameObject2D* obj = Get2DObject(id);
+
+		if(obj == NULL)
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "Map -> Tried to update the scene index for an object that is not in the map.");
+			return;
+		}
+
+		_sceneIndex.Move(id, _ObjectBounds(obj));
+	}
+
+	void Map::RefreshSceneIndex(void)
+	{
+		for(U32 i = 0; i < _2DWorldObjects.Size(); ++i)
+		{
+			GameObject2D* obj = _2DWorldObjects[i];
+
+			if(obj->GetStatic()) { continue; }
+
+			_sceneIndex.Move(obj->GetID(), _ObjectBounds(obj));
+		}
+	}
+
+	void Map::_ResizeSceneIndex(void)
+	{
+		//=====Maps are sized one side at a time, so wait until both are set=====
+		if(_mapWidth <= 0 || _mapHeight <= 0) { return; }
+
+		_sceneIndex.SetWorldBounds(AABB2D(0.0f, 0.0f, (F32)_mapWidth, (F32)_mapHeight));
+	}
+
+//=============================================================================
+//
+//Simulation
+//
+//Counts frames until divisor of them have passed, keeping the time that went
+//by. Returns true on the frame the map should be updated.
+//
+//=============================================================================
+	bool Map::AdvanceTick(F32 delta, U32 divisor)
+	{
+		_tickAccumulator += delta;
+		++_tickFrames;
+
+		if(_tickFrames < divisor) { return false; }
+
+		_tickDelta = _tickAccumulator;
+		_tickAccumulator = 0.0f;
+		_tickFrames = 0;
 
-		_3DWorldObjects.erase(i);
+		return true;
+	}
+
+//=============================================================================
+//
+//Parallel Render
+//
+//=============================================================================
+//With culling on, begin and end are in the visible list instead of the map.
+	void Map::_Render2DObjects(U32 begin, U32 end)
+	{
+		for(U32 i = begin; i < end; ++i)
+		{
+			GameObject2D* obj = _culling ? _visible2D[i] : _2DWorldObjects[i];
+
+			if(obj->GetStatic()) { continue; }
+
+			obj->v_Render();
+		}
+	}
+
+//=============================================================================
+//
+//Culling
+//
+//=============================================================================
+	void Map::_CullObjects(const AABB2D& view)
+	{
+		_staticLayer.Render(view);
+
+		_cullStats.chunksDrawn = _staticLayer.GetChunkCount() - _staticLayer.GetCulledCount();
+		_cullStats.chunksCulled = _staticLayer.GetCulledCount();
+
+		_visible2D.clear();
+		_cullResults.clear();
+
+		U32 dynamicCount = _2DWorldObjects.Size() - _staticLayer.GetObjectCount();
+
+		if(_cullWithSceneIndex)
+		{
+			_sceneIndex.QueryRect(view, _cullResults);
+			std::sort(_cullResults.begin(), _cullResults.end());
+
+			for(U32 i = 0; i < _cullResults.size(); ++i)
+			{
+				GameObject2D* obj = Get2DObject(_cullResults[i]);
+
+				if(obj != NULL && !obj->GetStatic()) { _visible2D.push_back(obj); }
+			}
+		}
+		else
+		{
+			_culler.Clear();
+			_cullCandidates.clear();
+
+			for(U32 i = 0; i < _2DWorldObjects.Size(); ++i)
+			{
+				GameObject2D* obj = _2DWorldObjects[i];
+
+				if(obj->GetStatic()) { continue; }
+
+				_culler.Add(_ObjectBounds(obj));
+				_cullCandidates.push_back(obj);
+			}
+
+			_culler.Cull(view, _cullResults);
+
+			for(U32 i = 0; i < _cullResults.size(); ++i)
+			{
+				_visible2D.push_back(_cullCandidates[_cullResults[i]]);
+			}
+		}
+
+		_cullStats.objectsVisible = (U32)_visible2D.size();
+		_cullStats.objectsCulled = dynamicCount - _cullStats.objectsVisible;
+	}
+
+//=============================================================================
+//
+//Deferred Changes
+//
+//=============================================================================
+	void Map::DeferAddObjectToMap(GameObject2D* obj)
+	{
+		_PushCommand(MC_ADD_2D, obj->GetID(), obj, NULL);
+	}
+
+	void Map::DeferAddObjectToMap(GameObject3D* obj)
+	{
+		_PushCommand(MC_ADD_3D, obj->GetID(), NULL, obj);
+	}
+
+	void Map::DeferRemove2DObjectFromMap(U32 id)
+	{
+		_PushCommand(MC_REMOVE_2D, id, NULL, NULL);
+	}
+
+	void Map::DeferRemove3DObjectFromMap(U32 id)
+	{
+		_PushCommand(MC_REMOVE_3D, id, NULL, NULL);
+	}
+
+	void Map::DeferSet2DObjectActive(U32 id, bool active)
+	{
+		_PushCommand(active ? MC_ACTIVATE_2D : MC_DEACTIVATE_2D, id, NULL, NULL);
+	}
+
+	void Map::DeferSet3DObjectActive(U32 id, bool active)
+	{
+		_PushCommand(active ? MC_ACTIVATE_3D : MC_DEACTIVATE_3D, id, NULL, NULL);
+	}
+
+	void Map::FlushCommands(void)
+	{
+		if(_commands.Empty()) { return; }
+
+		_flushedCommands.clear();
+		_commands.Flush(_flushedCommands);
+
+		for(U32 i = 0; i < _flushedCommands.size(); ++i)
+		{
+			ApplyCommand(_flushedCommands[i]);
+		}
+	}
+
+	void Map::ApplyCommand(const MapCommand& command)
+	{
+		switch(command.type)
+		{
+			case MC_ADD_2D:
+				AddObjectToMap(command.obj2D);
+				break;
+
+			case MC_ADD_3D:
+				AddObjectToMap(command.obj3D);
+				break;
+
+			case MC_REMOVE_2D:
+				Remove2DObjectFromMap(command.objectID);
+				break;
+
+			case MC_REMOVE_3D:
+				Remove3DObjectFromMap(command.objectID);
+				break;
+
+			case MC_ACTIVATE_2D:
+			case MC_DEACTIVATE_2D:
+			{
+				GameObject2D* obj = Get2DObject(command.objectID);
+
+				if(obj == NULL) { ErrorManager::Instance()->SetError(EC_KillerEngine, "Map -> Tried to change the active state of a 2D object that is not in the map."); }
+				else if(command.type == MC_ACTIVATE_2D) { obj->SetActive(); }
+				else { obj->SetInactive(); }
+				break;
+			}
+
+			case MC_ACTIVATE_3D:
+			case MC_DEACTIVATE_3D:
+			{
+				GameObject3D* obj = Get3DObject(command.objectID);
+
+				if(obj == NULL) { ErrorManager::Instance()->SetError(EC_KillerEngine, "Map -> Tried to change the active state of a 3D object that is not in the map."); }
+				else { obj->SetActive(command.type == MC_ACTIVATE_3D); }
+				break;
+			}
+
+			default:
+				ErrorManager::Instance()->SetError(EC_KillerEngine, "Map -> Moving objects between maps must go through the MapManager.");
+				break;
+		}
+	}
+
+	void Map::_PushCommand(MapCommandType type, U32 objectID, GameObject2D* obj2D, GameObject3D* obj3D)
+	{
+		MapCommand command;
+		command.type = type;
+		command.mapID = _ID;
+		command.targetMapID = _ID;
+		command.objectID = objectID;
+		command.obj2D = obj2D;
+		command.obj3D = obj3D;
+		command.next = NULL;
+
+		_commands.Push(command);
 	}
 
 //==========================================================================================================================
@@ -73,193 +452,435 @@ namespace KillerEngine
 //==========================================================================================================================	
 	void Map::Importer2D(string tmxFilePath)
 	{
+		MapData mapData;
+		std::map<U32, TileData> tiles;
+		std::vector<S32> layout;
+
+		if(!_ParseTMX(tmxFilePath, mapData, tiles, layout)) { return; }
+
+		_tmxPath = tmxFilePath;
+		_mapData = mapData;
+
+		//=====Set Map variables=====
+		SetMapWidth(mapData.mapWidth * mapData.tileWidth);
+		SetMapHeight(mapData.mapHeight * mapData.tileHeight);
+		SetBackgroundColor(mapData.color);
+
+		//=====Tiles are placed starting one tile in from the world origin, which is cell 0, 0=====
+		_collisionLayer.Init(mapData.mapWidth, mapData.mapHeight, (F32)mapData.tileWidth, (F32)mapData.tileHeight);
+		_collisionLayer.SetOrigin((F32)mapData.tileWidth, (F32)mapData.tileHeight);
+
+		//=====Tile set. Anything the atlas could not take is loaded on its own=====
+		if(_useAtlas)
+		{
+			for(auto i = tiles.begin(); i != tiles.end(); ++i)
+			{
+				TextureAtlas::Instance()->AddImage(i->second.textureID, i->second.texturePath);
+			}
 
+			TextureAtlas::Instance()->Build();
+		}
+
+		for(auto i = tiles.begin(); i != tiles.end(); ++i)
+		{
+			_AddTile(i->second);
+
+			if(TextureAtlas::Instance()->Contains(i->second.textureID)) { continue; }
+
+			TextureManager::Instance()->LoadTexture(i->second.texturePath, i->second.textureID, i->second.width, i->second.height);
+		}
+
+		//=====Tile layout=====
+		_layout = layout;
+		_layoutObjects.assign(layout.size(), 0);
+
+		for(U32 i = 0; i < _layout.size(); ++i)
+		{
+			if(_layout[i] > 0) { _PlaceTile(i); }
+		}
+	}//end Importer
+
+//==========================================================================================================================
+//
+//TMX Hot Reload
+//
+//==========================================================================================================================
+	U32 Map::ReloadTMX(string tmxFilePath)
+	{
+		if(tmxFilePath.empty()) { tmxFilePath = _tmxPath; }
+
+		MapData mapData;
+		std::map<U32, TileData> tiles;
+		std::vector<S32> layout;
+
+		if(!_ParseTMX(tmxFilePath, mapData, tiles, layout)) { return 0; }
+
+		_tmxPath = tmxFilePath;
+
+		//=====A new size moves every tile, so there is nothing to keep=====
+		bool resized = mapData.mapWidth != _mapData.mapWidth || mapData.mapHeight != _mapData.mapHeight ||
+					   mapData.tileWidth != _mapData.tileWidth || mapData.tileHeight != _mapData.tileHeight;
+
+		if(resized)
+		{
+			for(U32 i = 0; i < _layout.size(); ++i)
+			{
+				_RemoveTile(i);
+			}
+
+			_layout.clear();
+
+			SetMapWidth(mapData.mapWidth * mapData.tileWidth);
+			SetMapHeight(mapData.mapHeight * mapData.tileHeight);
+			_collisionLayer.Init(mapData.mapWidth, mapData.mapHeight, (F32)mapData.tileWidth, (F32)mapData.tileHeight);
+			_collisionLayer.SetOrigin((F32)mapData.tileWidth, (F32)mapData.tileHeight);
+		}
+
+		_mapData = mapData;
+		SetBackgroundColor(mapData.color);
+
+		//=====Tile set. Only the textures that changed are loaded again, and only the tiles whose objects would be
+		//different have to be made again=====
+		std::vector<bool> changedTiles;
+
+		for(auto i = tiles.begin(); i != tiles.end(); ++i)
+		{
+			const TileData& tile = i->second;
+			auto old = _2DTileData.find(i->first);
+
+			if(tile.tileID >= (S32)changedTiles.size()) { changedTiles.resize(tile.tileID + 1, false); }
+
+			if(old == _2DTileData.end() || old->second.textureID != tile.textureID)
+			{
+				if(!TextureAtlas::Instance()->Contains(tile.textureID))
+				{
+					TextureManager::Instance()->LoadTexture(tile.texturePath, tile.textureID, tile.width, tile.height);
+				}
+
+				changedTiles[tile.tileID] = true;
+				continue;
+			}
+
+			if(old->second.texturePath != tile.texturePath || old->second.width != tile.width || old->second.height != tile.height)
+			{
+				if(!TextureAtlas::Instance()->Contains(tile.textureID))
+				{
+					TextureManager::Instance()->ReloadTexture(tile.texturePath, tile.textureID, tile.width, tile.height);
+				}
+				else if(!TextureAtlas::Instance()->UpdateImage(tile.textureID, tile.texturePath))
+				{
+					//=====It no longer fits its rect, so it moves out of the atlas and its tiles are made again=====
+					TextureAtlas::Instance()->Remove(tile.textureID);
+					TextureManager::Instance()->ReloadTexture(tile.texturePath, tile.textureID, tile.width, tile.height);
+					changedTiles[tile.tileID] = true;
+				}
+			}
+
+			if(old->second.width != tile.width || old->second.height != tile.height || 
+			   old->second.type != tile.type || old->second.collision != tile.collision)
+			{
+				changedTiles[tile.tileID] = true;
+			}
+		}
+
+		//=====Tiles that were taken out of the tile set=====
+		for(auto i = _2DTileData.begin(); i != _2DTileData.end(); ++i)
+		{
+			if(tiles.find(i->first) != tiles.end()) { continue; }
+
+			if(i->second.tileID >= (S32)changedTiles.size()) { changedTiles.resize(i->second.tileID + 1, false); }
+			changedTiles[i->second.tileID] = true;
+		}
+
+		_2DTileData = tiles;
+
+		//=====Tile layout=====
+		if(_layout.size() < layout.size())
+		{
+			_layout.resize(layout.size(), 0);
+			_layoutObjects.resize(layout.size(), 0);
+		}
+
+		U32 changed = 0;
+
+		for(U32 i = 0; i < _layout.size(); ++i)
+		{
+			S32 oldTile = _layout[i];
+			S32 newTile = i < layout.size() ? layout[i] : 0;
+
+			bool tileChanged = (oldTile > 0 && oldTile < (S32)changedTiles.size() && changedTiles[oldTile]) ||
+							   (newTile > 0 && newTile < (S32)changedTiles.size() && changedTiles[newTile]);
+
+			if(oldTile == newTile && !tileChanged) { continue; }
+
+			_RemoveTile(i);
+			_layout[i] = newTile;
+
+			if(newTile > 0) { _PlaceTile(i); }
+
+			++changed;
+		}
+
+		_layout.resize(layout.size());
+		_layoutObjects.resize(layout.size());
+
+		return changed;
+	}
+
+	void Map::EnableHotReload(bool state)
+	{
+		if(_reloadWatch != 0)
+		{
+			FileWatcher::Instance()->Unwatch(_reloadWatch);
+			_reloadWatch = 0;
+		}
+
+		if(!state) { return; }
+
+		if(_tmxPath.empty())
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "Map -> Hot reload needs a map that was imported from a .tmx file.");
+			return;
+		}
+
+		_reloadWatch = FileWatcher::Instance()->Watch(_tmxPath, [this](const string& path) { ReloadTMX(path); });
+	}
+
+//==========================================================================================================================
+//
+//TMX Parsing
+//
+//==========================================================================================================================
+	bool Map::_ParseTMX(string tmxFilePath, MapData& mapData, std::map<U32, TileData>& tiles, std::vector<S32>& layout)
+	{
 		tinyxml2::XMLDocument doc;
 		doc.LoadFile(tmxFilePath.c_str());
 
-		if(!doc.Error())
+		if(doc.Error())
 		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "Unable to open file path to .tmx file " + tmxFilePath);
+			return false;
+		}
+
 //==========================================================================================================================
 //Caputre map data
 //==========================================================================================================================			
-			MapData mapData;
+		tinyxml2::XMLElement* elem = doc.RootElement();
+
+		if(elem == NULL)
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "Unable to open element or node");
+			return false;
+		}
+
+		elem->QueryIntAttribute("width", &mapData.mapWidth);
+		elem->QueryIntAttribute("height", &mapData.mapHeight);
+		elem->QueryIntAttribute("tilewidth", &mapData.tileWidth);
+		elem->QueryIntAttribute("tileheight", &mapData.tileHeight);
+		
+		string color = elem->Attribute("backgroundcolor");
+
+		string red = "0x" + color.substr(1,2);
+		string green = "0x" + color.substr(3,2);
+		string blue = "0x" + color.substr(5,2);
+
+		U32 ir = std::stoul(red, NULL, 16); 
+		U32 ig = std::stoul(green, NULL, 16); 
+		U32 ib = std::stoul(blue, NULL, 16); 
+
+		F32 r = (F32)ir / 255;
+		F32 g = (F32)ig / 255;
+		F32 b = (F32)ib / 255;
+					 
+		mapData.color = Col(r, g, b);
+
+//==========================================================================================================================
+//Capture Tile Data
+//==========================================================================================================================
+		elem = doc.RootElement()->FirstChildElement("tileset");
+		
+		if(elem == NULL)
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "Unable to open element or node");
+			return false;
+		}
+
+		for(tinyxml2::XMLElement* e = elem->FirstChildElement("tile"); e != NULL; e = e->NextSiblingElement())
+		{
+			TileData texData;
 			
+			//=====Capture tile ID=====
+			e->QueryIntAttribute("id", &texData.tileID);
 
-			tinyxml2::XMLElement* elem = doc.RootElement();
+			//Increase by one for now, but later this will be
+			//increased by the <tileset firstgid="1"
+			++texData.tileID;
+			
+			//=====Capture Custom Properties=====
+			//ObjectType
+			tinyxml2::XMLElement* p = e->FirstChildElement("properties")->FirstChildElement("property");
 
-			if(elem != NULL)
+			string att = p->Attribute("name");
+			
+			if(att == "ObjectType")
 			{
-				elem->QueryIntAttribute("width", &mapData.mapWidth);
-				elem->QueryIntAttribute("height", &mapData.mapHeight);
-				elem->QueryIntAttribute("tilewidth", &mapData.tileWidth);
-				elem->QueryIntAttribute("tileheight", &mapData.tileHeight);
-				
-				string color = elem->Attribute("backgroundcolor");
-
-				string red = "0x" + color.substr(1,2);
-				string green = "0x" + color.substr(3,2);
-				string blue = "0x" + color.substr(5,2);
-
-				U32 ir = std::stoul(red, NULL, 16); 
-				U32 ig = std::stoul(green, NULL, 16); 
-				U32 ib = std::stoul(blue, NULL, 16); 
-
-				F32 r = (F32)ir / 255;
-				F32 g = (F32)ig / 255;
-				F32 b = (F32)ib / 255;
-
-				std::cout << "color " << r << " " << g << " " << b << "\n";
-							 
-				mapData.color = Col(r, g, b);
+				string name = p->Attribute("value");
+
+				texData.type = v_StringToTileData(name);				
 			}
 			else
 			{
-				ErrorManager::Instance()->SetError(EC_KillerEngine, "Unable to open element or node");
+				ErrorManager::Instance()->SetError(EC_KillerEngine, "In correct format for tile ObjectType.");
 			}
 
-			//=====Set Map variables=====
-			SetMapWidth(mapData.mapWidth * mapData.tileWidth);
-			SetMapHeight(mapData.mapHeight * mapData.tileHeight);
-			SetBackgroundColor(mapData.color);
-//==========================================================================================================================
-//Capture Tile Data
-//==========================================================================================================================
-			elem = doc.RootElement()->FirstChildElement("tileset");
-			
-			if(elem != NULL)
+			//TextureID
+			p = e->FirstChildElement("properties")->FirstChildElement("property")->NextSiblingElement("property");
+
+			att = p->Attribute("name");
+
+			if(att == "TextureID")
 			{
-				for(tinyxml2::XMLElement* e = elem->FirstChildElement("tile"); e != NULL; e = e->NextSiblingElement())
+				p->QueryIntAttribute("value", &texData.textureID);
+			}
+			else
+			{
+				ErrorManager::Instance()->SetError(EC_KillerEngine, "In correct format for tile TextureID");
+			}
+
+			//Collision, optional. Environment tiles are solid unless they say otherwise
+			texData.collision = texData.type == ENVIRONMENT ? TC_SOLID : TC_NONE;
+
+			for(p = e->FirstChildElement("properties")->FirstChildElement("property"); p != NULL; p = p->NextSiblingElement("property"))
+			{
+				att = p->Attribute("name");
+
+				if(att == "Collision")
 				{
-					TileData texData;
-					
-					//=====Capture tile ID=====
-					e->QueryIntAttribute("id", &texData.tileID);
-
-					//Increase by one for now, but later this will be
-					//increased by the <tileset firstgid="1"
-					++texData.tileID;
-					
-					//=====Capture Custom Properties=====
-					//ObjectType
-					tinyxml2::XMLElement* p = e->FirstChildElement("properties")->FirstChildElement("property");
-
-					string att = p->Attribute("name");
-					
-					if(att == "ObjectType")
-					{
-						string name = p->Attribute("value");
-
-						texData.type = v_StringToTileData(name);				
-					}
-					else
-					{
-						ErrorManager::Instance()->SetError(EC_KillerEngine, "In correct format for tile ObjectType.");
-					}
-
-					//TextureID
-					p = e->FirstChildElement("properties")->FirstChildElement("property")->NextSiblingElement("property");
-
-					att = p->Attribute("name");
-
-					if(att == "TextureID")
-					{
-						p->QueryIntAttribute("value", &texData.textureID);
-					}
-					else
-					{
-						ErrorManager::Instance()->SetError(EC_KillerEngine, "In correct format for tile TextureID");
-					}
-
-					//=====Capture Image texData=====
-					tinyxml2::XMLElement* image = e->FirstChildElement("image");
-
-					image->QueryIntAttribute("width", &texData.width);
-					image->QueryIntAttribute("height", &texData.height);
-					texData.texturePath = image->Attribute("source");
-
-					//=====ReFormat the texture URL=====
-					for(auto i = texData.texturePath.begin(); i != texData.texturePath.end(); i++)
-					{
-						if(*i == '/')
-						{
-							*i = '\\';
-						}
-						if(*i == '.' && *(i+1) == '.')
-						{
-							texData.texturePath.erase(i, i + 1);
-						}
-					}
-
-					texData.texturePath = "..\\Assets" + texData.texturePath;
-					_AddTile(texData);
-					TextureManager::Instance()->LoadTexture(texData.texturePath, texData.textureID, texData.width, texData.height);
+					texData.collision = v_StringToCollision(p->Attribute("value"));
+					break;
 				}
-//==========================================================================================================================
-//Caputre tile layout
-//==========================================================================================================================
-				elem = doc.RootElement()->FirstChildElement("layer")->FirstChildElement("data");
-				string name = elem->Attribute("encoding");
+			}
+
+			//=====Capture Image texData=====
+			tinyxml2::XMLElement* image = e->FirstChildElement("image");
 
-				if(name == "csv")
+			image->QueryIntAttribute("width", &texData.width);
+			image->QueryIntAttribute("height", &texData.height);
+			texData.texturePath = image->Attribute("source");
+
+			//=====ReFormat the texture URL=====
+			for(auto i = texData.texturePath.begin(); i != texData.texturePath.end(); i++)
+			{
+				if(*i == '/')
 				{
-					string csvData = elem->GetText();
-
-					for(U32 i = 0; i < csvData.size(); ++i)
-					{
-						csvData.erase(std::remove(csvData.begin(), csvData.end(), ','), csvData.end());
-						csvData.erase(std::remove(csvData.begin(), csvData.end(), '\n'), csvData.end());
-						
-						if(csvData[i] > '0')
-						{
-							//=====Get X Y from csv data for textures=====
-							U32 x;
-							U32 y;
-														
-							U32 p = i + 1;
-
-							if(p % mapData.mapWidth == 0) { x = mapData.mapWidth; }	
-							else
-							{
-								U32 t = 1; 
-								U32 m = p / mapData.mapWidth;
-								while((m * mapData.mapWidth) + t != p)
-								{
-									++t;
-								}
-								x = t;
-							}
-
-							y = mapData.mapHeight - ((i + 1) / mapData.mapHeight);
-
-							//=====Add Object to Map=====
-							S32 tile = csvData[i] - '0';
-
-							TileData currentTile = _2DTileData.find(tile)->second;
-
-							AddObjectToMap(v_CreateObject(currentTile.type, 
-										   Vec2( (F32)(x * mapData.tileWidth)+(currentTile.width / 2), (F32)(y * mapData.tileHeight)+(currentTile.height / 2)),
-										   currentTile.textureID,
-										   (F32)currentTile.width, (F32)currentTile.height));
-						}
- 					}
+					*i = '\\';
 				}
-				else
+				if(*i == '.' && *(i+1) == '.')
 				{
-					ErrorManager::Instance()->SetError(EC_KillerEngine, "Incorrect encoding in imported file, not csv, " + name);
+					texData.texturePath.erase(i, i + 1);
 				}
 			}
-			else
+
+			texData.texturePath = "..\\Assets" + texData.texturePath;
+			tiles[texData.tileID] = texData;
+		}
+
+//==========================================================================================================================
+//Caputre tile layout
+//==========================================================================================================================
+		elem = doc.RootElement()->FirstChildElement("layer")->FirstChildElement("data");
+		string name = elem->Attribute("encoding");
+
+		if(name != "csv")
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "Incorrect encoding in imported file, not csv, " + name);
+			return false;
+		}
+
+		string csvData = elem->GetText();
+
+		csvData.erase(std::remove(csvData.begin(), csvData.end(), ','), csvData.end());
+		csvData.erase(std::remove(csvData.begin(), csvData.end(), '\n'), csvData.end());
+
+		layout.assign(csvData.size(), 0);
+
+		for(U32 i = 0; i < csvData.size(); ++i)
+		{
+			if(csvData[i] > '0') 
 			{
-				ErrorManager::Instance()->SetError(EC_KillerEngine, "Unable to open element or node");
+				layout[i] = csvData[i] - '0';
+
+				if(tiles.find(layout[i]) == tiles.end())
+				{
+					ErrorManager::Instance()->SetError(EC_KillerEngine, "Tile in layout is not in the tile set.");
+					layout[i] = 0;
+				}
 			}
-			
 		}
-		else
+
+		return true;
+	}
+
+//==========================================================================================================================
+//
+//Tile Placement
+//
+//==========================================================================================================================
+//The csv runs left to right from the top row down, the cells run from the bottom row up.
+	void Map::_TileCell(U32 index, U32& x, U32& y) const
+	{
+		U32 row = index / _mapData.mapWidth;
+
+		x = index % _mapData.mapWidth;
+		y = _mapData.mapHeight - 1 - row;
+	}
+
+	void Map::_PlaceTile(U32 index)
+	{
+		U32 x;
+		U32 y;
+		_TileCell(index, x, y);
+
+		const TileData& currentTile = _2DTileData.find(_layout[index])->second;
+
+		_collisionLayer.SetTile(x, y, currentTile.collision);
+
+		GameObject2D* obj = v_CreateObject(currentTile.type, 
+					   Vec2( (F32)((x + 1) * _mapData.tileWidth)+(currentTile.width / 2), (F32)((y + 1) * _mapData.tileHeight)+(currentTile.height / 2)),
+					   currentTile.textureID,
+					   (F32)currentTile.width, (F32)currentTile.height);
+
+		if(obj == NULL) { return; }
+
+		//=====Background and environment tiles never move=====
+		if(currentTile.type == BACKGROUND || currentTile.type == ENVIRONMENT) { obj->SetStatic(true); }
+
+		AddObjectToMap(obj);
+		_layoutObjects[index] = obj->GetID();
+	}
+
+	void Map::_RemoveTile(U32 index)
+	{
+		if(index >= _layoutObjects.size()) { return; }
+
+		U32 x;
+		U32 y;
+		_TileCell(index, x, y);
+
+		if(_layout[index] > 0) { _collisionLayer.SetTile(x, y, TC_NONE); }
+
+		if(_layoutObjects[index] == 0) { return; }
+
+		GameObject2D* obj = Get2DObject(_layoutObjects[index]);
+
+		if(obj != NULL)
 		{
-			ErrorManager::Instance()->SetError(EC_KillerEngine, "Unable to open file path to .tmx file " + tmxFilePath);
+			Remove2DObjectFromMap(_layoutObjects[index]);
+			v_DestroyObject(obj);
 		}
 
-	}//end Importer
+		_layoutObjects[index] = 0;
+	}
 
 //==========================================================================================================================
 //
@@ -283,4 +904,43 @@ namespace KillerEngine
 		}
 	}
 
+//==========================================================================================================================
+//
+//StringToCollision
+//
+//The Collision property is a list of flags split by commas, such as "Solid" or "OneWay, Hazard". "None" clears them all.
+//
+//==========================================================================================================================
+	U8 Map::v_StringToCollision(string s)
+	{
+		U8 flags = TC_NONE;
+		U32 start = 0;
+
+		while(start <= s.size())
+		{
+			size_t found = s.find(',', start);
+			U32 end = found == string::npos ? (U32)s.size() : (U32)found;
+
+			string flag = s.substr(start, end - start);
+			flag.erase(std::remove(flag.begin(), flag.end(), ' '), flag.end());
+
+			if(flag == "Solid") { flags |= TC_SOLID; }
+
+			else if(flag == "OneWay") { flags |= TC_ONE_WAY; }
+
+			else if(flag == "Hazard") { flags |= TC_HAZARD; }
+
+			else if(flag == "None" || flag.empty()) {  }
+
+			else
+			{
+				ErrorManager::Instance()->SetError(EC_KillerEngine, "No such collision flag during import of file " + flag);
+			}
+
+			start = end + 1;
+		}
+
+		return flags;
+	}
+
 }//End namespace
@@ -0,0 +1,76 @@
+#include <Engine/MapCommandBuffer.h>
+
+namespace KillerEngine
+{
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+	MapCommandBuffer::MapCommandBuffer(void) : _pool(256), _poolNext(0), _head(NULL)
+	{  }
+
+	MapCommandBuffer::MapCommandBuffer(U32 capacity) : _pool(capacity > 0 ? capacity : 1), _poolNext(0), _head(NULL)
+	{  }
+
+	MapCommandBuffer::~MapCommandBuffer(void)
+	{
+		std::vector<MapCommand> unused;
+		Flush(unused);
+	}
+
+//==========================================================================================================================
+//
+//MapCommandBuffer Functions
+//
+//==========================================================================================================================
+	void MapCommandBuffer::Push(const MapCommand& command)
+	{
+		U32 slot = _poolNext.fetch_add(1, std::memory_order_relaxed);
+
+		MapCommand* node = slot < _pool.size() ? &_pool[slot] : new MapCommand();
+
+		*node = command;
+
+		//=====Intrusive stack push=====
+		MapCommand* head = _head.load(std::memory_order_relaxed);
+		do
+		{
+			node->next = head;
+		} while(!_head.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	void MapCommandBuffer::Flush(std::vector<MapCommand>& out)
+	{
+		MapCommand* node = _head.exchange(NULL, std::memory_order_acquire);
+
+		//=====Reverse the stack so commands come out in push order=====
+		MapCommand* ordered = NULL;
+		while(node != NULL)
+		{
+			MapCommand* next = node->next;
+			node->next = ordered;
+			ordered = node;
+			node = next;
+		}
+
+		const MapCommand* poolBegin = _pool.empty() ? NULL : &_pool[0];
+		const MapCommand* poolEnd   = poolBegin + _pool.size();
+
+		while(ordered != NULL)
+		{
+			MapCommand* next = ordered->next;
+
+			out.push_back(*ordered);
+			out.back().next = NULL;
+
+			if(ordered < poolBegin || ordered >= poolEnd) { delete ordered; }
+
+			ordered = next;
+		}
+
+		//=====Grow the pool to last frame's high-water mark=====
+		U32 used = _poolNext.exchange(0, std::memory_order_relaxed);
+		if(used > _pool.size()) { _pool.resize(used); }
+	}
+}//End namespace
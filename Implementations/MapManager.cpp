@@ -37,6 +37,11 @@ namespace KillerEngine
 	void MapManager::RemoveMap(U32 worldID) 
 	{
 		auto w = _worlds.find(worldID);
+
+		if(w == _worlds.end()) { return; }
+
+		if(w->second == _activeMap) { _activeMap = NULL; }
+
 		_worlds.erase(w);
 	}
 
@@ -60,7 +65,47 @@ namespace KillerEngine
 //==========================================================================================================================
 	void MapManager::Update(void) 
 	{
-		_activeMap->v_Update();
+		//=====Hot reloads happen before the update, so the map is never changed part way through=====
+		FileWatcher::Instance()->Poll();
+
+		F32 delta = KM::Timer::Instance()->DeltaTime();
+		JobGroup group;
+		_tickedMaps.clear();
+
+		//=====Background maps go to the workers first=====
+		for(auto i = _worlds.begin(); i != _worlds.end(); ++i)
+		{
+			Map* map = i->second;
+
+			if(map == _activeMap || !map->GetBackgroundSimulation()) { continue; }
+
+			if(!map->AdvanceTick(delta, map->GetTickDivisor())) { continue; }
+
+			_tickedMaps.push_back(map);
+			JobPool::Instance()->Submit(group, [map]() { map->v_Update(); });
+		}
+
+		//=====The active map is updated here, it is the only one allowed to use the Renderer=====
+		if(_activeMap != NULL)
+		{
+			_activeMap->AdvanceTick(delta, 1);
+			_activeMap->v_Update();
+		}
+
+		JobPool::Instance()->Wait(group);
+
+		//=====Sync point=====
+		FlushCommands();
+
+		for(U32 i = 0; i < _tickedMaps.size(); ++i)
+		{
+			Map* map = _tickedMaps[i];
+			JobPool::Instance()->Submit(group, [map]() { map->GetPathfinding().ProcessRequests(); });
+		}
+
+		if(_activeMap != NULL) { _activeMap->GetPathfinding().ProcessRequests(); }
+
+		JobPool::Instance()->Wait(group);
 	}
 
 //==========================================================================================================================
@@ -70,6 +115,9 @@ namespace KillerEngine
 //==========================================================================================================================
 	void MapManager::Render(void) 
 	{
+		//=====RemoveMap may have taken the active map away=====
+		if(_activeMap == NULL) { return; }
+
 		_activeMap->v_Render();
 	}
 
@@ -103,4 +151,139 @@ namespace KillerEngine
 		if(_worlds.find(worldID) != _worlds.end()) { _worlds[worldID]->Remove3DObjectFromMap(objID); }
 	}
 
+//==========================================================================================================================
+//
+//Deferred Changes
+//
+//==========================================================================================================================
+	void MapManager::DeferAddObjectToMap(U32 id, GameObject2D* obj)
+	{
+		_PushCommand(MC_ADD_2D, id, id, obj->GetID(), obj, NULL);
+	}
+
+	void MapManager::DeferAddObjectToMap(U32 id, GameObject3D* obj)
+	{
+		_PushCommand(MC_ADD_3D, id, id, obj->GetID(), NULL, obj);
+	}
+
+	void MapManager::DeferRemove2DObjectFromMap(U32 worldID, U32 objID)
+	{
+		_PushCommand(MC_REMOVE_2D, worldID, worldID, objID, NULL, NULL);
+	}
+
+	void MapManager::DeferRemove3DObjectFromMap(U32 worldID, U32 objID)
+	{
+		_PushCommand(MC_REMOVE_3D, worldID, worldID, objID, NULL, NULL);
+	}
+
+	void MapManager::DeferSet2DObjectActive(U32 worldID, U32 objID, bool active)
+	{
+		_PushCommand(active ? MC_ACTIVATE_2D : MC_DEACTIVATE_2D, worldID, worldID, objID, NULL, NULL);
+	}
+
+	void MapManager::DeferSet3DObjectActive(U32 worldID, U32 objID, bool active)
+	{
+		_PushCommand(active ? MC_ACTIVATE_3D : MC_DEACTIVATE_3D, worldID, worldID, objID, NULL, NULL);
+	}
+
+	void MapManager::DeferMove2DObject(U32 fromWorldID, U32 toWorldID, U32 objID)
+	{
+		_PushCommand(MC_MOVE_2D, fromWorldID, toWorldID, objID, NULL, NULL);
+	}
+
+	void MapManager::DeferMove3DObject(U32 fromWorldID, U32 toWorldID, U32 objID)
+	{
+		_PushCommand(MC_MOVE_3D, fromWorldID, toWorldID, objID, NULL, NULL);
+	}
+
+//=======================================================================================================
+//FlushCommands
+//
+//Each map applies its own queue first, then the commands that were given to the manager are applied
+//in the order they were queued. 
+//=======================================================================================================
+	void MapManager::FlushCommands(void)
+	{
+		for(auto i = _worlds.begin(); i != _worlds.end(); ++i)
+		{
+			i->second->FlushCommands();
+		}
+
+		if(_commands.Empty()) { return; }
+
+		_flushedCommands.clear();
+		_commands.Flush(_flushedCommands);
+
+		for(U32 i = 0; i < _flushedCommands.size(); ++i)
+		{
+			const MapCommand& command = _flushedCommands[i];
+
+			if(command.type == MC_MOVE_2D || command.type == MC_MOVE_3D)
+			{
+				_MoveObject(command);
+			}
+			else if(_worlds.find(command.mapID) != _worlds.end())
+			{
+				_worlds[command.mapID]->ApplyCommand(command);
+			}
+			else 
+			{
+				ErrorManager::Instance()->SetError(EC_KillerEngine, "MapManager -> Tried to apply a deferred command to a world that does not exist.");
+			}
+		}
+	}
+
+	void MapManager::_PushCommand(MapCommandType type, U32 worldID, U32 targetWorldID, U32 objID, GameObject2D* obj2D, GameObject3D* obj3D)
+	{
+		MapCommand command;
+		command.type = type;
+		command.mapID = worldID;
+		command.targetMapID = targetWorldID;
+		command.objectID = objID;
+		command.obj2D = obj2D;
+		command.obj3D = obj3D;
+		command.next = NULL;
+
+		_commands.Push(command);
+	}
+
+	void MapManager::_MoveObject(const MapCommand& command)
+	{
+		auto from = _worlds.find(command.mapID);
+		auto to = _worlds.find(command.targetMapID);
+
+		if(from == _worlds.end() || to == _worlds.end())
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "MapManager -> Tried to move an object between worlds that do not exist.");
+			return;
+		}
+
+		if(command.type == MC_MOVE_2D)
+		{
+			GameObject2D* obj = from->second->Get2DObject(command.objectID);
+
+			if(obj == NULL)
+			{
+				ErrorManager::Instance()->SetError(EC_KillerEngine, "MapManager -> Tried to move a 2D object that is not in the world.");
+				return;
+			}
+
+			from->second->Remove2DObjectFromMap(command.objectID);
+			to->second->AddObjectToMap(obj);
+		}
+		else
+		{
+			GameObject3D* obj = from->second->Get3DObject(command.objectID);
+
+			if(obj == NULL)
+			{
+				ErrorManager::Instance()->SetError(EC_KillerEngine, "MapManager -> Tried to move a 3D object that is not in the world.");
+				return;
+			}
+
+			from->second->Remove3DObjectFromMap(command.objectID);
+			to->second->AddObjectToMap(obj);
+		}
+	}
+
 }//End namsepace
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include <Engine/ParticleBuffer2D.h>
+
+namespace KillerEngine
+{
+#ifdef KILLER_PARTICLE_SSE
+	//=====SpriteVertex::FloatToHalf for four floats at once. The half is in the low 16 bits of each lane=====
+	static inline __m128i FloatToHalf4(__m128 value)
+	{
+		const __m128i signMask = _mm_set1_epi32((S32)0x80000000);
+		const __m128i halfMax = _mm_set1_epi32((127 + 16) << 23);
+		const __m128i minNormal = _mm_set1_epi32((127 - 14) << 23);
+		const __m128i subnormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+		const __m128i normalBias = _mm_set1_epi32(0xFFF - ((127 - 15) << 23));
+
+		__m128 sign = _mm_and_ps(_mm_castsi128_ps(signMask), value);
+		__m128 absolute = _mm_andnot_ps(_mm_castsi128_ps(signMask), value);
+		__m128i bits = _mm_castps_si128(absolute);
+
+		//=====Infinity, or a quiet NaN=====
+		__m128i isNaN = _mm_castps_si128(_mm_cmpunord_ps(absolute, absolute));
+		__m128i special = _mm_or_si128(_mm_and_si128(isNaN, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7C00));
+		__m128i isRegular = _mm_cmpgt_epi32(halfMax, bits);
+
+		//=====Too small for a normal half, the add rounds it to a subnormal, ties to even=====
+		__m128i isSubnormal = _mm_cmpgt_epi32(minNormal, bits);
+		__m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absolute, _mm_castsi128_ps(subnormalMagic))), subnormalMagic);
+
+		//=====Rebias the exponent and round the mantissa, ties to even=====
+		__m128i odd = _mm_srai_epi32(_mm_slli_epi32(bits, 31 - 13), 31);
+		__m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(bits, normalBias), odd), 13);
+
+		__m128i finite = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+		__m128i result = _mm_or_si128(_mm_and_si128(isRegular, finite), _mm_andnot_si128(isRegular, special));
+
+		return _mm_or_si128(result, _mm_srli_epi32(_mm_castps_si128(sign), 16));
+	}
+#endif
+
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+	ParticleBuffer2D::ParticleBuffer2D(void) : _x(), _y(), _size(), _color(), _frame(), _frames(), _z(0.0f)
+	{  }
+
+//==========================================================================================================================
+//
+//ParticleBuffer2D Functions
+//
+//==========================================================================================================================
+	U32 ParticleBuffer2D::Add(F32 x, F32 y, F32 size, const Col& color, U16 frame)
+	{
+		_x.push_back(x);
+		_y.push_back(y);
+		_size.push_back(size);
+		_color.push_back(PackColor(color));
+		_frame.push_back(frame);
+
+		return (U32)_x.size() - 1;
+	}
+
+	void ParticleBuffer2D::Remove(U32 index)
+	{
+		if(index >= GetCount()) { return; }
+
+		U32 last = GetCount() - 1;
+
+		_x[index] = _x[last];
+		_y[index] = _y[last];
+		_size[index] = _size[last];
+		_color[index] = _color[last];
+		_frame[index] = _frame[last];
+
+		_x.pop_back();
+		_y.pop_back();
+		_size.pop_back();
+		_color.pop_back();
+		_frame.pop_back();
+	}
+
+	void ParticleBuffer2D::Clear(void)
+	{
+		_x.clear();
+		_y.clear();
+		_size.clear();
+		_color.clear();
+		_frame.clear();
+	}
+
+	void ParticleBuffer2D::Reserve(U32 count)
+	{
+		_x.reserve(count);
+		_y.reserve(count);
+		_size.reserve(count);
+		_color.reserve(count);
+		_frame.reserve(count);
+	}
+
+	U16 ParticleBuffer2D::AddFrame(F32 bottom, F32 top, F32 left, F32 right)
+	{
+		_frames.push_back(SpriteVertex::PackUnorm16(bottom));
+		_frames.push_back(SpriteVertex::PackUnorm16(top));
+		_frames.push_back(SpriteVertex::PackUnorm16(left));
+		_frames.push_back(SpriteVertex::PackUnorm16(right));
+
+		return (U16)(GetFrameCount() - 1);
+	}
+
+	void ParticleBuffer2D::ClearFrames(void)
+	{
+		_frames.clear();
+	}
+
+//Four sizes are turned into halves at a time, then each of the four vertices is written field by
+//field. Whatever is left over at the end goes through SpriteVertex::FloatToHalf.
+	void ParticleBuffer2D::Pack(SpriteVertex* vertices, U32 first, U32 count) const
+	{
+		if(first >= GetCount()) { return; }
+		if(count > GetCount() - first) { count = GetCount() - first; }
+
+		//=====The same rect AddToBatch gives a sprite with no texture rect of its own=====
+		static const U16 wholeTexture[4] = { 0, 0, 65535, 65535 };
+
+		const U16* frames = _frames.empty() ? wholeTexture : &_frames[0];
+		U32 frameCount = _frames.empty() ? 1 : GetFrameCount();
+
+		const F32* x = &_x[first];
+		const F32* y = &_y[first];
+		const F32* size = &_size[first];
+		const U32* color = &_color[first];
+		const U16* frame = &_frame[first];
+
+		U32 i = 0;
+
+#ifdef KILLER_PARTICLE_SSE
+		const __m128 half = _mm_set1_ps(0.5f);
+		U32 halves[4];
+
+		for(; i + 4 <= count; i += 4)
+		{
+			_mm_storeu_si128((__m128i*)halves, FloatToHalf4(_mm_mul_ps(_mm_loadu_ps(size + i), half)));
+
+			for(U32 lane = 0; lane < 4; ++lane)
+			{
+				U32 n = i + lane;
+				SpriteVertex& vertex = vertices[n];
+				U32 rect = frame[n] < frameCount ? frame[n] : 0;
+
+				vertex.position[0] = x[n];
+				vertex.position[1] = y[n];
+				vertex.position[2] = _z;
+				vertex.color = color[n];
+				vertex.halfSize[0] = (U16)halves[lane];
+				vertex.halfSize[1] = (U16)halves[lane];
+				memcpy(vertex.uvs, frames + rect * 4, sizeof(vertex.uvs));
+			}
+		}
+#endif
+
+		for(; i < count; ++i)
+		{
+			SpriteVertex& vertex = vertices[i];
+			U32 rect = frame[i] < frameCount ? frame[i] : 0;
+			U16 halfSize = SpriteVertex::FloatToHalf(size[i] * 0.5f);
+
+			vertex.position[0] = x[i];
+			vertex.position[1] = y[i];
+			vertex.position[2] = _z;
+			vertex.color = color[i];
+			vertex.halfSize[0] = halfSize;
+			vertex.halfSize[1] = halfSize;
+			memcpy(vertex.uvs, frames + rect * 4, sizeof(vertex.uvs));
+		}
+	}
+}//End namespace
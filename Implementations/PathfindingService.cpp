@@ -0,0 +1,354 @@
+#include <Engine/PathfindingService.h>
+
+namespace KillerEngine
+{
+	//=====Most requests taken off of the queue in one frame=====
+	static const U32 MAX_REQUESTS_PER_FRAME = 512;
+
+	//=====The path cache is dropped when it gets bigger than this=====
+	static const U32 MAX_CACHED_PATHS = 4096;
+
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+	PathfindingService::PathfindingService(void) : _layer(NULL), 
+												   _blocking(TC_SOLID), 
+												   _budget(2.0f), 
+												   _regionSize(8), 
+												   _nextTicket(1), 
+												   _cacheVersion(0), 
+												   _pending(), 
+												   _results(), 
+												   _working(), 
+												   _searches(), 
+												   _pathCache(), 
+												   _flowFields(), 
+												   _cacheLock(), 
+												   _cacheHits(0), 
+												   _cacheMisses(0)
+	{  }
+
+	PathfindingService::~PathfindingService(void)
+	{
+		ClearCache();
+
+		for(U32 i = 0; i < _searches.size(); ++i)
+		{
+			delete _searches[i];
+		}
+	}
+
+//==========================================================================================================================
+//
+//PathfindingService Functions
+//
+//==========================================================================================================================
+	void PathfindingService::SetGrid(const TileCollisionLayer* layer)
+	{
+		_layer = layer;
+		ClearCache();
+	}
+
+	U32 PathfindingService::RequestPath(GridPoint start, GridPoint goal, PathAlgorithm algorithm)
+	{
+		PathRequest request;
+		request.ticket = _nextTicket++;
+		request.start = start;
+		request.goal = goal;
+		request.algorithm = algorithm;
+
+		if(_nextTicket == 0) { _nextTicket = 1; }
+
+		//=====Nothing off the grid is queued, the ticket is answered straight away=====
+		if(_layer != NULL && (!_InGrid(start) || !_InGrid(goal)))
+		{
+			_results[request.ticket].status = PS_NOT_FOUND;
+			return request.ticket;
+		}
+
+		_pending.push_back(request);
+		_results[request.ticket].status = PS_PENDING;
+
+		return request.ticket;
+	}
+
+	void PathfindingService::CancelRequest(U32 ticket)
+	{
+		for(auto i = _pending.begin(); i != _pending.end(); ++i)
+		{
+			if(i->ticket == ticket)
+			{
+				_pending.erase(i);
+				break;
+			}
+		}
+
+		_results.erase(ticket);
+	}
+
+	PathStatus PathfindingService::GetStatus(U32 ticket) const
+	{
+		auto found = _results.find(ticket);
+
+		return found == _results.end() ? PS_NONE : found->second.status;
+	}
+
+	bool PathfindingService::TakePath(U32 ticket, std::vector<GridPoint>& out)
+	{
+		auto found = _results.find(ticket);
+
+		if(found == _results.end() || found->second.status == PS_PENDING) { return false; }
+
+		bool succeeded = found->second.status == PS_FOUND;
+
+		if(succeeded) { out.swap(found->second.path); }
+
+		_results.erase(found);
+
+		return succeeded;
+	}
+
+	void PathfindingService::ProcessRequests(void)
+	{
+		if(_pending.empty() || _layer == NULL) { return; }
+
+		_CheckVersion();
+
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + 
+														 std::chrono::microseconds((S64)(_budget * 1000.0f));
+
+		//=====Take a batch off of the queue=====
+		_working.clear();
+
+		while(!_pending.empty() && _working.size() < MAX_REQUESTS_PER_FRAME)
+		{
+			WorkItem item;
+			item.request = _pending.front();
+			item.done = false;
+			item.found = false;
+			_working.push_back(item);
+
+			_pending.pop_front();
+		}
+
+		U32 jobCount = JobPool::Instance()->GetWorkerCount() + 1;
+		if(jobCount > _working.size()) { jobCount = (U32)_working.size(); }
+
+		for(U32 j = 0; j < jobCount; ++j) { _GetSearch(j); }
+
+		//=====Each job keeps pulling requests until the queue or the budget runs out. Every job does at least one=====
+		std::atomic<U32> next(0);
+		JobGroup group;
+
+		for(U32 j = 0; j < jobCount; ++j)
+		{
+			JobPool::Instance()->Submit(group, [this, j, &next, deadline]()
+			{
+				GridSearch& search = *_searches[j];
+				bool first = true;
+
+				while(first || std::chrono::steady_clock::now() < deadline)
+				{
+					U32 index = next.fetch_add(1);
+
+					if(index >= _working.size()) { return; }
+
+					WorkItem& item = _working[index];
+					item.found = _Solve(search, item.request, item.path);
+					item.done = true;
+					first = false;
+				}
+			});
+		}
+
+		JobPool::Instance()->Wait(group);
+
+		//=====Store what finished, and put the rest back at the front in the same order=====
+		for(U32 i = (U32)_working.size(); i > 0; --i)
+		{
+			WorkItem& item = _working[i - 1];
+
+			if(!item.done)
+			{
+				_pending.push_front(item.request);
+				continue;
+			}
+
+			auto result = _results.find(item.request.ticket);
+
+			//=====Cancelled while it was being worked on=====
+			if(result == _results.end()) { continue; }
+
+			result->second.status = item.found ? PS_FOUND : PS_NOT_FOUND;
+			result->second.path.swap(item.path);
+		}
+
+		_working.clear();
+	}
+
+	bool PathfindingService::FindPathNow(GridPoint start, GridPoint goal, PathAlgorithm algorithm, std::vector<GridPoint>& out)
+	{
+		if(_layer == NULL)
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "PathfindingService -> No grid has been set.");
+			return false;
+		}
+
+		_CheckVersion();
+
+		PathRequest request;
+		request.ticket = 0;
+		request.start = start;
+		request.goal = goal;
+		request.algorithm = algorithm;
+
+		return _Solve(*_GetSearch(0), request, out);
+	}
+
+	const FlowField* PathfindingService::GetFlowField(GridPoint goal)
+	{
+		if(_layer == NULL)
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "PathfindingService -> No grid has been set.");
+			return NULL;
+		}
+
+		_CheckVersion();
+
+		if(!_InGrid(goal)) { return NULL; }
+
+		U32 key = (U32)goal.y * _layer->GetWidth() + (U32)goal.x;
+		auto found = _flowFields.find(key);
+
+		if(found != _flowFields.end()) { return found->second; }
+
+		FlowField* field = new FlowField();
+
+		if(!field->Build(*_layer, _blocking, goal))
+		{
+			delete field;
+			return NULL;
+		}
+
+		_flowFields.insert(std::map<U32, FlowField*>::value_type(key, field));
+
+		return field;
+	}
+
+	void PathfindingService::ClearCache(void)
+	{
+		std::lock_guard<std::mutex> lock(_cacheLock);
+
+		_pathCache.clear();
+
+		for(auto i = _flowFields.begin(); i != _flowFields.end(); ++i)
+		{
+			delete i->second;
+		}
+
+		_flowFields.clear();
+	}
+
+//==========================================================================================================================
+//
+//Private Functions
+//
+//==========================================================================================================================
+//The grid may have been changed since the request was queued, so it is checked again here, before
+//the key is made from the coordinates.
+	bool PathfindingService::_Solve(GridSearch& search, const PathRequest& request, std::vector<GridPoint>& out)
+	{
+		out.clear();
+
+		if(!_InGrid(request.start) || !_InGrid(request.goal)) { return false; }
+
+		U64 key = _CacheKey(request.start, request.goal);
+		std::vector<GridPoint> cached;
+
+		{
+			std::lock_guard<std::mutex> lock(_cacheLock);
+			auto found = _pathCache.find(key);
+
+			if(found != _pathCache.end()) { cached = found->second; }
+		}
+
+		//=====Join the cached path at the last point that is still close to the start=====
+		if(!cached.empty())
+		{
+			S32 join = -1;
+
+			for(S32 i = (S32)cached.size() - 1; i >= 0; --i)
+			{
+				S32 dx = abs(cached[i].x - request.start.x);
+				S32 dy = abs(cached[i].y - request.start.y);
+
+				if(dx <= (S32)_regionSize && dy <= (S32)_regionSize)
+				{
+					join = i;
+					break;
+				}
+			}
+
+			if(join >= 0 && search.FindPath(request.start, cached[join], out))
+			{
+				out.insert(out.end(), cached.begin() + join + 1, cached.end());
+				++_cacheHits;
+				return true;
+			}
+
+			out.clear();
+		}
+
+		++_cacheMisses;
+
+		bool found = request.algorithm == PA_JPS ? search.FindPathJPS(request.start, request.goal, out) 
+												 : search.FindPath(request.start, request.goal, out);
+
+		if(found)
+		{
+			std::lock_guard<std::mutex> lock(_cacheLock);
+
+			if(_pathCache.size() >= MAX_CACHED_PATHS) { _pathCache.clear(); }
+
+			_pathCache[key] = out;
+		}
+
+		return found;
+	}
+
+	void PathfindingService::_CheckVersion(void)
+	{
+		if(_layer->GetVersion() == _cacheVersion) { return; }
+
+		ClearCache();
+		_cacheVersion = _layer->GetVersion();
+	}
+
+	U64 PathfindingService::_CacheKey(GridPoint start, GridPoint goal) const
+	{
+		U32 regionsPerRow = (_layer->GetWidth() + _regionSize - 1) / _regionSize;
+		U32 region = ((U32)start.y / _regionSize) * regionsPerRow + (U32)start.x / _regionSize;
+		U32 goalCell = (U32)goal.y * _layer->GetWidth() + (U32)goal.x;
+
+		return ((U64)region << 32) | (U64)goalCell;
+	}
+
+	bool PathfindingService::_InGrid(GridPoint point) const
+	{
+		return point.x >= 0 && point.y >= 0 && (U32)point.x < _layer->GetWidth() && (U32)point.y < _layer->GetHeight();
+	}
+
+	GridSearch* PathfindingService::_GetSearch(U32 index)
+	{
+		while(_searches.size() <= index)
+		{
+			_searches.push_back(new GridSearch());
+		}
+
+		_searches[index]->SetGrid(_layer, _blocking);
+
+		return _searches[index];
+	}
+}//End namespace
@@ -0,0 +1,440 @@
+#include <Engine/QuadTree.h>
+
+namespace KillerEngine
+{
+	//=====Deepest a tree can go. Keeps the fixed query stacks small=====
+	static const U32 MAX_QUAD_TREE_DEPTH = 20;
+	static const U32 QUERY_STACK_SIZE = (MAX_QUAD_TREE_DEPTH + 1) * 4;
+
+	const S32 QuadTree::NO_INDEX;
+
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+	QuadTree::QuadTree(void) : _worldBounds(0.0f, 0.0f, 1024.0f, 1024.0f), 
+							   _maxDepth(8), 
+							   _nodes(), 
+							   _items(), 
+							   _itemIndex()
+	{
+		_ResetRoot();
+	}
+
+	QuadTree::QuadTree(const AABB2D& worldBounds, U32 maxDepth) : _worldBounds(worldBounds), 
+																  _maxDepth(maxDepth > MAX_QUAD_TREE_DEPTH ? MAX_QUAD_TREE_DEPTH : maxDepth), 
+																  _nodes(), 
+																  _items(), 
+																  _itemIndex()
+	{
+		_ResetRoot();
+	}
+
+//==========================================================================================================================
+//
+//QuadTree Functions
+//
+//==========================================================================================================================
+	void QuadTree::SetWorldBounds(const AABB2D& worldBounds)
+	{
+		if(worldBounds.GetWidth() <= 0.0f || worldBounds.GetHeight() <= 0.0f)
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "QuadTree -> World bounds must have a size greater than 0.");
+			return;
+		}
+
+		_worldBounds = worldBounds;
+
+		//=====Every item has to find its node again=====
+		std::vector<Item> items;
+		items.swap(_items);
+
+		Clear();
+
+		for(U32 i = 0; i < items.size(); ++i)
+		{
+			Insert(items[i].id, items[i].bounds);
+		}
+	}
+
+	void QuadTree::SetMaxDepth(U32 depth)
+	{
+		_maxDepth = depth > MAX_QUAD_TREE_DEPTH ? MAX_QUAD_TREE_DEPTH : depth;
+		SetWorldBounds(_worldBounds);
+	}
+
+	void QuadTree::Insert(U32 id, const AABB2D& bounds)
+	{
+		if(Contains(id))
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "QuadTree -> Item is already in the tree.");
+			return;
+		}
+
+		Item item;
+		item.bounds = bounds;
+		item.id = id;
+		item.node = NO_INDEX;
+		item.prev = NO_INDEX;
+		item.next = NO_INDEX;
+
+		S32 index = (S32)_items.size();
+		_items.push_back(item);
+
+		if(id >= _itemIndex.size()) { _itemIndex.resize(id + 1, NO_INDEX); }
+		_itemIndex[id] = index;
+
+		_Link(index, _FindNode(bounds));
+	}
+
+	void QuadTree::Remove(U32 id)
+	{
+		if(!Contains(id)) { return; }
+
+		S32 index = _itemIndex[id];
+		_Unlink(index);
+		_itemIndex[id] = NO_INDEX;
+
+		//=====Move the last item into the hole and fix its links=====
+		S32 last = (S32)_items.size() - 1;
+
+		if(index != last)
+		{
+			Item& moved = _items[index];
+			moved = _items[last];
+
+			if(moved.prev != NO_INDEX) { _items[moved.prev].next = index; }
+			else { _nodes[moved.node].firstItem = index; }
+
+			if(moved.next != NO_INDEX) { _items[moved.next].prev = index; }
+
+			_itemIndex[moved.id] = index;
+		}
+
+		_items.pop_back();
+	}
+
+	void QuadTree::Move(U32 id, const AABB2D& bounds)
+	{
+		if(!Contains(id))
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "QuadTree -> Tried to move an item that is not in the tree.");
+			return;
+		}
+
+		S32 index = _itemIndex[id];
+		S32 node = _FindNode(bounds);
+
+		if(node != _items[index].node)
+		{
+			_Unlink(index);
+			_items[index].bounds = bounds;
+			_Link(index, node);
+		}
+		else
+		{
+			_items[index].bounds = bounds;
+		}
+	}
+
+	void QuadTree::Clear(void)
+	{
+		_items.clear();
+		_itemIndex.clear();
+		_ResetRoot();
+	}
+
+//==========================================================================================================================
+//
+//Queries
+//
+//==========================================================================================================================
+	void QuadTree::QueryPoint(F32 x, F32 y, std::vector<U32>& out) const
+	{
+		S32 stack[QUERY_STACK_SIZE];
+		U32 top = 0;
+		stack[top++] = 0;
+
+		while(top > 0)
+		{
+			const Node& node = _nodes[stack[--top]];
+
+			if(node.total == 0) { continue; }
+			if(node.parent != NO_INDEX && !_LooseBounds(node).Contains(x, y)) { continue; }
+
+			for(S32 i = node.firstItem; i != NO_INDEX; i = _items[i].next)
+			{
+				if(_items[i].bounds.Contains(x, y)) { out.push_back(_items[i].id); }
+			}
+
+			if(node.firstChild != NO_INDEX)
+			{
+				for(S32 c = 0; c < 4; ++c) { stack[top++] = node.firstChild + c; }
+			}
+		}
+	}
+
+	void QuadTree::QueryRect(const AABB2D& rect, std::vector<U32>& out) const
+	{
+		S32 stack[QUERY_STACK_SIZE];
+		U32 top = 0;
+		stack[top++] = 0;
+
+		while(top > 0)
+		{
+			const Node& node = _nodes[stack[--top]];
+
+			if(node.total == 0) { continue; }
+			if(node.parent != NO_INDEX && !_LooseBounds(node).Overlaps(rect)) { continue; }
+
+			for(S32 i = node.firstItem; i != NO_INDEX; i = _items[i].next)
+			{
+				if(_items[i].bounds.Overlaps(rect)) { out.push_back(_items[i].id); }
+			}
+
+			if(node.firstChild != NO_INDEX)
+			{
+				for(S32 c = 0; c < 4; ++c) { stack[top++] = node.firstChild + c; }
+			}
+		}
+	}
+
+	void QuadTree::QueryRay(const Vec2& origin, const Vec2& direction, F32 maxDistance, std::vector<QuadTreeHit>& out) const
+	{
+		U32 first = (U32)out.size();
+
+		F32 originX = origin.GetX();
+		F32 originY = origin.GetY();
+
+		//=====A large number instead of infinity keeps 0 * inv from being NaN=====
+		F32 invX = direction.GetX() != 0.0f ? 1.0f / direction.GetX() : 1e30f;
+		F32 invY = direction.GetY() != 0.0f ? 1.0f / direction.GetY() : 1e30f;
+		F32 hit;
+
+		S32 stack[QUERY_STACK_SIZE];
+		U32 top = 0;
+		stack[top++] = 0;
+
+		while(top > 0)
+		{
+			const Node& node = _nodes[stack[--top]];
+
+			if(node.total == 0) { continue; }
+			if(node.parent != NO_INDEX && !_LooseBounds(node).RayHit(originX, originY, invX, invY, maxDistance, hit)) { continue; }
+
+			for(S32 i = node.firstItem; i != NO_INDEX; i = _items[i].next)
+			{
+				if(_items[i].bounds.RayHit(originX, originY, invX, invY, maxDistance, hit))
+				{
+					QuadTreeHit result;
+					result.id = _items[i].id;
+					result.distance = hit;
+					out.push_back(result);
+				}
+			}
+
+			if(node.firstChild != NO_INDEX)
+			{
+				for(S32 c = 0; c < 4; ++c) { stack[top++] = node.firstChild + c; }
+			}
+		}
+
+		std::sort(out.begin() + first, out.end(), [](const QuadTreeHit& a, const QuadTreeHit& b) { return a.distance < b.distance; });
+	}
+
+	void QuadTree::QueryNearest(F32 x, F32 y, U32 count, std::vector<QuadTreeHit>& out) const
+	{
+		if(count == 0) { return; }
+
+		//=====Best first search. Entries are (squared distance, index), items use negative indices=====
+		typedef std::pair<F32, S32> Entry;
+		std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+
+		open.push(Entry(0.0f, 0));
+		U32 found = 0;
+
+		while(!open.empty() && found < count)
+		{
+			Entry entry = open.top();
+			open.pop();
+
+			if(entry.second < 0)
+			{
+				QuadTreeHit result;
+				result.id = _items[-entry.second - 1].id;
+				result.distance = std::sqrt(entry.first);
+				out.push_back(result);
+				++found;
+				continue;
+			}
+
+			const Node& node = _nodes[entry.second];
+
+			for(S32 i = node.firstItem; i != NO_INDEX; i = _items[i].next)
+			{
+				open.push(Entry(_items[i].bounds.SqrDistance(x, y), -i - 1));
+			}
+
+			if(node.firstChild != NO_INDEX)
+			{
+				for(S32 c = 0; c < 4; ++c)
+				{
+					const Node& child = _nodes[node.firstChild + c];
+
+					if(child.total > 0) { open.push(Entry(_LooseBounds(child).SqrDistance(x, y), node.firstChild + c)); }
+				}
+			}
+		}
+	}
+
+	void QuadTree::QueryBatch(std::vector<QuadTreeQuery>& queries) const
+	{
+		JobPool::Instance()->ParallelFor((U32)queries.size(), 16, [this, &queries](U32 begin, U32 end)
+		{
+			std::vector<QuadTreeHit> hits;
+
+			for(U32 q = begin; q < end; ++q)
+			{
+				QuadTreeQuery& query = queries[q];
+				query.results.clear();
+
+				switch(query.type)
+				{
+					case QT_POINT:
+						QueryPoint(query.point.GetX(), query.point.GetY(), query.results);
+						break;
+
+					case QT_RECT:
+						QueryRect(query.rect, query.results);
+						break;
+
+					case QT_RAY:
+					case QT_NEAREST:
+						hits.clear();
+
+						if(query.type == QT_RAY) { QueryRay(query.point, query.direction, query.maxDistance, hits); }
+						else { QueryNearest(query.point.GetX(), query.point.GetY(), query.count, hits); }
+
+						for(U32 h = 0; h < hits.size(); ++h)
+						{
+							query.results.push_back(hits[h].id);
+						}
+						break;
+				}
+			}
+		});
+	}
+
+//==========================================================================================================================
+//
+//Private Functions
+//
+//==========================================================================================================================
+	void QuadTree::_ResetRoot(void)
+	{
+		F32 w = _worldBounds.GetWidth();
+		F32 h = _worldBounds.GetHeight();
+
+		Node root;
+		root.centerX = _worldBounds.GetCenterX();
+		root.centerY = _worldBounds.GetCenterY();
+		root.halfSize = (w > h ? w : h) / 2;
+		root.parent = NO_INDEX;
+		root.firstChild = NO_INDEX;
+		root.firstItem = NO_INDEX;
+		root.total = 0;
+		root.depth = 0;
+
+		_nodes.clear();
+		_nodes.push_back(root);
+	}
+
+	S32 QuadTree::_FindNode(const AABB2D& bounds)
+	{
+		F32 size = bounds.GetWidth() > bounds.GetHeight() ? bounds.GetWidth() : bounds.GetHeight();
+		F32 x = bounds.GetCenterX();
+		F32 y = bounds.GetCenterY();
+
+		const Node& root = _nodes[0];
+
+		//=====Centers outside of the world stay in the root=====
+		if(x < root.centerX - root.halfSize || x > root.centerX + root.halfSize ||
+		   y < root.centerY - root.halfSize || y > root.centerY + root.halfSize)
+		{
+			return 0;
+		}
+
+		S32 node = 0;
+
+		//=====A child's loose bounds reach half its parent's size past its cell, so the item fits if it is no bigger than that=====
+		while(_nodes[node].depth < _maxDepth && size <= _nodes[node].halfSize)
+		{
+			if(_nodes[node].firstChild == NO_INDEX) { _SplitNode(node); }
+
+			S32 quadrant = (x >= _nodes[node].centerX ? 1 : 0) + (y >= _nodes[node].centerY ? 2 : 0);
+			node = _nodes[node].firstChild + quadrant;
+		}
+
+		return node;
+	}
+
+	void QuadTree::_Link(S32 item, S32 node)
+	{
+		Item& linked = _items[item];
+		linked.node = node;
+		linked.prev = NO_INDEX;
+		linked.next = _nodes[node].firstItem;
+
+		if(linked.next != NO_INDEX) { _items[linked.next].prev = item; }
+
+		_nodes[node].firstItem = item;
+
+		for(S32 n = node; n != NO_INDEX; n = _nodes[n].parent)
+		{
+			++_nodes[n].total;
+		}
+	}
+
+	void QuadTree::_Unlink(S32 item)
+	{
+		Item& unlinked = _items[item];
+
+		if(unlinked.prev != NO_INDEX) { _items[unlinked.prev].next = unlinked.next; }
+		else { _nodes[unlinked.node].firstItem = unlinked.next; }
+
+		if(unlinked.next != NO_INDEX) { _items[unlinked.next].prev = unlinked.prev; }
+
+		for(S32 n = unlinked.node; n != NO_INDEX; n = _nodes[n].parent)
+		{
+			--_nodes[n].total;
+		}
+
+		unlinked.node = NO_INDEX;
+		unlinked.prev = NO_INDEX;
+		unlinked.next = NO_INDEX;
+	}
+
+	void QuadTree::_SplitNode(S32 node)
+	{
+		S32 first = (S32)_nodes.size();
+		F32 half = _nodes[node].halfSize / 2;
+
+		for(S32 c = 0; c < 4; ++c)
+		{
+			Node child;
+			child.centerX = _nodes[node].centerX + ((c & 1) ? half : -half);
+			child.centerY = _nodes[node].centerY + ((c & 2) ? half : -half);
+			child.halfSize = half;
+			child.parent = node;
+			child.firstChild = NO_INDEX;
+			child.firstItem = NO_INDEX;
+			child.total = 0;
+			child.depth = _nodes[node].depth + 1;
+
+			_nodes.push_back(child);
+		}
+
+		_nodes[node].firstChild = first;
+	}
+}//End namespace
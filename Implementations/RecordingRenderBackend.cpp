@@ -0,0 +1,142 @@
+#include <Engine/RecordingRenderBackend.h>
+
+namespace KillerEngine
+{
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+	RecordingRenderBackend::RecordingRenderBackend(void) : _batches(), _counters(), _shader(0), _textureID(0), _keepData(true)
+	{
+		Reset();
+	}
+
+//==========================================================================================================================
+//
+//Virtual Functions
+//
+//==========================================================================================================================
+	void RecordingRenderBackend::v_UseShader(GLuint shader)
+	{
+		_shader = shader;
+		++_counters.shaderSwitches;
+	}
+
+	void RecordingRenderBackend::v_BindTexture(U32 textureID)
+	{
+		_textureID = textureID;
+		++_counters.textureSwitches;
+	}
+
+	void RecordingRenderBackend::v_DrawBatch(const RenderBatch& batch)
+	{
+		RecordedBatch& recorded = _NewBatch(batch.count, false, 0);
+
+		++_counters.batches;
+		_counters.sprites += batch.count;
+
+		recorded.textured = batch.textured;
+		recorded.instanced = batch.instanced;
+
+		if(!_keepData) { return; }
+
+		recorded.vertices.assign(batch.vertices, batch.vertices + batch.count);
+	}
+
+	void RecordingRenderBackend::v_DrawStatic(GLuint vertexArray, U32 count, bool blend, bool instanced)
+	{
+		RecordedBatch& recorded = _NewBatch(count, true, vertexArray);
+		recorded.textured = blend;
+		recorded.instanced = instanced;
+
+		++_counters.staticDraws;
+		_counters.sprites += count;
+	}
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+	void RecordingRenderBackend::Reset(void)
+	{
+		_batches.clear();
+		_counters.batches = 0;
+		_counters.staticDraws = 0;
+		_counters.sprites = 0;
+		_counters.shaderSwitches = 0;
+		_counters.textureSwitches = 0;
+		_counters.frames = 0;
+	}
+
+	bool RecordingRenderBackend::SaveToFile(string path) const
+	{
+		std::ofstream file(path.c_str());
+
+		if(!file.is_open())
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "RecordingRenderBackend -> Unable to open " + path + " to save the recording.");
+			return false;
+		}
+
+		file << "batches " << _counters.batches << " static " << _counters.staticDraws << " sprites " << _counters.sprites
+			 << " shaders " << _counters.shaderSwitches << " textures " << _counters.textureSwitches 
+			 << " frames " << _counters.frames << "\n";
+
+		for(U32 i = 0; i < _batches.size(); ++i)
+		{
+			const RecordedBatch& batch = _batches[i];
+
+			file << (batch.isStatic ? "static" : "batch") << " shader " << batch.shader << " texture " << batch.textureID 
+				 << " count " << batch.count;
+
+			if(batch.isStatic) { file << " vao " << batch.vertexArray; }
+
+			if(batch.instanced) { file << " instanced"; }
+
+			file << "\n";
+
+			if(batch.vertices.empty()) { continue; }
+
+			for(U32 v = 0; v < batch.vertices.size(); ++v)
+			{
+				const SpriteVertex& vertex = batch.vertices[v];
+
+				file << "  " << vertex.position[0] << " " << vertex.position[1] << " " << vertex.position[2]
+					 << " | " << vertex.GetColor(0) << " " << vertex.GetColor(1) << " " << vertex.GetColor(2) << " " << vertex.GetColor(3)
+					 << " | " << vertex.GetHalfSize(0) << " " << vertex.GetHalfSize(1);
+
+				if(batch.textured)
+				{
+					file << " | " << vertex.GetUV(0) << " " << vertex.GetUV(1) << " " << vertex.GetUV(2) << " " << vertex.GetUV(3);
+				}
+
+				file << "\n";
+			}
+		}
+
+		return true;
+	}
+
+//==========================================================================================================================
+//
+//Private Functions
+//
+//==========================================================================================================================
+	RecordedBatch& RecordingRenderBackend::_NewBatch(U32 count, bool isStatic, GLuint vertexArray)
+	{
+		_batches.push_back(RecordedBatch());
+
+		RecordedBatch& batch = _batches.back();
+		batch.shader = _shader;
+		batch.textureID = _textureID;
+		batch.count = count;
+		batch.isStatic = isStatic;
+		batch.vertexArray = vertexArray;
+		batch.textured = false;
+		batch.instanced = false;
+
+		return batch;
+	}
+}//End namespace
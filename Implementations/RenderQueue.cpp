@@ -0,0 +1,171 @@
+#include <Engine/RenderQueue.h>
+
+namespace KillerEngine
+{
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+	RenderQueue::RenderQueue(void) : _items(), _keys(), _order(), _keysTemp(), _orderTemp(), _count(0), _growths(0)
+	{  }
+
+//==========================================================================================================================
+//
+//RenderQueue Functions
+//
+//==========================================================================================================================
+	void RenderQueue::Add(U8 layer, GLuint shader, U32 textureID, bool textured, const SpriteVertex& vertex)
+	{
+		if(_count == _items.size()) { _Grow(_count == 0 ? 256 : _count * 2); }
+
+		QueuedSprite* item = &_items[_count];
+		item->vertex = vertex;
+		item->shader = shader;
+		item->textureID = textureID;
+		item->textured = textured;
+
+		_order[_count] = _count;
+		_keys[_count] = MakeKey(layer, shader, textured ? textureID : 0, vertex.position[2]);
+		++_count;
+	}
+
+//Grows at most once for the whole range, then fills it the same way Add does.
+	void RenderQueue::AddRange(U8 layer, GLuint shader, U32 textureID, bool textured, const SpriteVertex* vertices, U32 count)
+	{
+		U32 total = _count + count;
+
+		if(total > _items.size())
+		{
+			U32 capacity = _items.size() == 0 ? 256 : (U32)_items.size();
+			while(capacity < total) { capacity *= 2; }
+
+			_Grow(capacity);
+		}
+
+		U32 keyTexture = textured ? textureID : 0;
+
+		for(U32 i = 0; i < count; ++i)
+		{
+			QueuedSprite* item = &_items[_count];
+			item->vertex = vertices[i];
+			item->shader = shader;
+			item->textureID = textureID;
+			item->textured = textured;
+
+			_order[_count] = _count;
+			_keys[_count] = MakeKey(layer, shader, keyTexture, vertices[i].position[2]);
+			++_count;
+		}
+	}
+
+	void RenderQueue::Sort(void)
+	{
+		U32 count = _count;
+
+		if(count < 2) { return; }
+
+		U64* keys = &_keys[0];
+		U32* order = &_order[0];
+		U64* keysTemp = &_keysTemp[0];
+		U32* orderTemp = &_orderTemp[0];
+
+		U32 histogram[256];
+
+		for(U32 shift = 0; shift < 64; shift += 8)
+		{
+			memset(histogram, 0, sizeof(histogram));
+
+			for(U32 i = 0; i < count; ++i)
+			{
+				++histogram[(keys[i] >> shift) & 0xFF];
+			}
+
+			//=====Every key has the same byte, this pass would not move anything=====
+			if(histogram[(keys[0] >> shift) & 0xFF] == count) { continue; }
+
+			U32 total = 0;
+
+			for(U32 b = 0; b < 256; ++b)
+			{
+				U32 bucket = histogram[b];
+				histogram[b] = total;
+				total += bucket;
+			}
+
+			for(U32 i = 0; i < count; ++i)
+			{
+				U32 slot = histogram[(keys[i] >> shift) & 0xFF]++;
+				keysTemp[slot] = keys[i];
+				orderTemp[slot] = order[i];
+			}
+
+			std::swap(keys, keysTemp);
+			std::swap(order, orderTemp);
+			_keys.swap(_keysTemp);
+			_order.swap(_orderTemp);
+		}
+	}
+
+	void RenderQueue::Clear(void)
+	{
+		_count = 0;
+	}
+
+	void RenderQueue::Reserve(U32 count)
+	{
+		if(count > _items.size()) { _Grow(count); }
+	}
+
+	void RenderQueue::Append(const RenderQueue& other)
+	{
+		U32 total = _count + other._count;
+
+		if(total > _items.size())
+		{
+			U32 capacity = _items.size() == 0 ? 256 : (U32)_items.size();
+			while(capacity < total) { capacity *= 2; }
+
+			_Grow(capacity);
+		}
+
+		for(U32 i = 0; i < other._count; ++i)
+		{
+			_items[_count + i] = other._items[other._order[i]];
+			_keys[_count + i] = other._keys[i];
+			_order[_count + i] = _count + i;
+		}
+
+		_count = total;
+	}
+
+	U64 RenderQueue::MakeKey(U8 layer, GLuint shader, U32 textureID, F32 depth)
+	{
+		//=====Flip the float so its bits sort the same way as its value=====
+		U32 bits;
+		memcpy(&bits, &depth, sizeof(bits));
+		bits = (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
+
+		return ((U64)layer << 56) | 
+			   ((U64)(shader & 0xFFF) << 44) | 
+			   ((U64)(textureID & 0xFFFF) << 28) | 
+			   (U64)(bits >> 4);
+	}
+
+//==========================================================================================================================
+//
+//Private Functions
+//
+//==========================================================================================================================
+//Every array is kept the same size, so the sort never has to resize the temp arrays.
+	void RenderQueue::_Grow(U32 capacity)
+	{
+		_items.resize(capacity);
+		_keys.resize(capacity);
+		_order.resize(capacity);
+		_keysTemp.resize(capacity);
+		_orderTemp.resize(capacity);
+
+		++_growths;
+	}
+}//End namespace
@@ -1,5 +1,4 @@
 #include <Engine/RenderText.h>
-#include <iostream>
 
 namespace KillerEngine
 {
@@ -8,19 +7,25 @@ namespace KillerEngine
 //Constructors
 //
 //==========================================================================================================================	
-	RenderText::RenderText(void) : _text(), _font(), _totalWidth(0), _totalHeight(0), _center(0.0f)
+	RenderText::RenderText(void) : _text(), _font(), _glyphs(), _vertices(), _textureID(0), _origin(0.0f), _color(), 
+								   _widthScaleFactor(1.0f), _heightScaleFactor(1.0f), _totalWidth(0), _totalHeight(0), 
+								   _center(0.0f), _layoutDirty(true), _verticesDirty(true)
 	{
 		GameObject2D::SetID();
 	}
 
-	RenderText::RenderText(Font& font) : _text(), _font(font), _totalWidth(0), _totalHeight(0), _center(0.0f)
+	RenderText::RenderText(Font& font) : _text(), _font(font), _glyphs(), _vertices(), _textureID(0), _origin(0.0f), _color(), 
+										 _widthScaleFactor(1.0f), _heightScaleFactor(1.0f), _totalWidth(0), _totalHeight(0), 
+										 _center(0.0f), _layoutDirty(true), _verticesDirty(true)
 	{
 		GameObject2D::SetID();
 	}
 
-	RenderText::RenderText(string text, Font& font) : _text(text), _font(font), _totalWidth(0), _totalHeight(0), _center(0.0f)
+	RenderText::RenderText(string text, Font& font) : _text(), _font(font), _glyphs(), _vertices(), _textureID(0), _origin(0.0f), _color(), 
+													  _widthScaleFactor(1.0f), _heightScaleFactor(1.0f), _totalWidth(0), _totalHeight(0), 
+													  _center(0.0f), _layoutDirty(true), _verticesDirty(true)
 	{
-		AddText(_text);
+		AddText(text);
 	}
 
 //==========================================================================================================================
@@ -30,10 +35,13 @@ namespace KillerEngine
 //==========================================================================================================================
 	void RenderText::v_Render(void)
 	{
-		for(CharSprite* sprite : _spriteList)
-		{
-			sprite->v_RenderSprite();
-		}
+		if(_layoutDirty) { _Layout(); }
+
+		if(_glyphs.empty()) { return; }
+
+		if(_verticesDirty) { _PackVertices(); }
+
+		Renderer::Instance()->AddToBatch(CharSprite::GetProgram(), _textureID, &_vertices[0], (U32)_vertices.size());
 	}
 
 //==========================================================================================================================
@@ -41,81 +49,116 @@ namespace KillerEngine
 //RenderText Functions
 //
 //==========================================================================================================================
+//Setting the text it already has is free, which is what most callers do every frame.
 	void RenderText::AddText(string text)
 	{
-		_spriteList.clear();
+		if(text == _text && !_layoutDirty) { return; }
 
 		_text = text;
+		_origin = GameObject2D::GetPosition();
+		_Layout();
+	}
+
+	void RenderText::SetTextPosition(Vec2& pos)
+	{
+		_origin = pos;
+		_verticesDirty = true;
+	}
+
+	void RenderText::SetTextColor(Col& col)
+	{
+		_color = col;
+		_verticesDirty = true;
+	}
+
+//==========================================================================================================================
+//
+//Private Functions
+//
+//==========================================================================================================================
+//Glyphs are kept relative to the origin, so moving the text never needs the font again. A character
+//the font does not have is skipped.
+	void RenderText::_Layout(void)
+	{
+		_glyphs.clear();
+		_totalWidth = 0.0f;
+		_totalHeight = 0.0f;
+		_layoutDirty = false;
+		_verticesDirty = true;
+
+		if(_text.empty()) 
+		{ 
+			_center = Vec2(0.0f, 0.0f);
+			return; 
+		}
 
-		F32 currentX = GameObject2D::GetPosition().GetX();
-		F32 currentY = GameObject2D::GetPosition().GetY();
+		U32 fontTexture = _font.GetTextureID();
+		_textureID = fontTexture;
 
-		Texture& texture = TextureManager::Instance()->GetTexture(_font.GetTextureID());
+		Texture& texture = TextureManager::Instance()->GetTexture(fontTexture);
+		F32 textureWidth  = F32(texture.GetWidth());
+		F32 textureHeight = F32(texture.GetHeight());
 
+		F32 currentX = 0.0f;
 
-		for(char& c : text)
+		for(char c : _text)
 		{
-			CharSprite* sprite = _font.CreateCharacter(c);
+			CharacterData* data = _font.GetDataForCharacter(c);
 
-			F32 xOffset = F32(sprite->GetXOffset() / 2);
-			F32 yOffset = F32(sprite->GetYOffset() / 2);
+			if(data == NULL) { continue; }
 
-			sprite->SetPosition(Vec2(currentX + xOffset, currentY - yOffset));			
+			F32 charWidth  = F32(data->width);
+			F32 charHeight = F32(data->height);
 
-			currentX += F32(sprite->GetXAdvance()) * _widthScaleFactor;
+			GlyphQuad glyph;
+			glyph.x = currentX + F32(data->xoffset / 2);
+			glyph.y = -F32(data->yoffset / 2);
 
-			F32 charWidth  	  = F32(sprite->GetCharWidth());
-			F32 charHeight 	  = F32(sprite->GetCharHeight());
-			F32 charX 	 	  = F32(sprite->GetCharX());
-			F32 charY 	 	  = F32(sprite->GetCharY());
-			F32 textureWidth  = F32(texture.GetWidth());
-			F32 textureHeight = F32(texture.GetHeight());
+			currentX += F32(data->xadvance) * _widthScaleFactor;
 
-			F32 rightCoord   = (charX / textureWidth);
-			F32 topCoord    = charY / textureHeight;
-			F32 leftCoord  = rightCoord + charWidth / textureWidth;
-			F32 bottomCoord = topCoord + charHeight / textureHeight;
+			glyph.right  = F32(data->x) / textureWidth;
+			glyph.top 	 = F32(data->y) / textureHeight;
+			glyph.left 	 = glyph.right + charWidth / textureWidth;
+			glyph.bottom = glyph.top + charHeight / textureHeight;
 
-			//std::cout << "Top=" << topCoord << "\nBottom=" << bottomCoord << "\nrRight=" << rightCoord << "\nLeft=" << leftCoord << "\n";
+			U32 atlasID = fontTexture;
+			TextureAtlas::Instance()->Remap(atlasID, glyph.bottom, glyph.top, glyph.left, glyph.right);
 
-			sprite->SetTexture(_font.GetTextureID(), topCoord, bottomCoord, rightCoord, leftCoord);
-
-			F32 totalCharWidth = charWidth * _widthScaleFactor;
+			F32 totalCharWidth  = charWidth * _widthScaleFactor;
 			F32 totalCharHeight = charHeight * _heightScaleFactor;
 
-			sprite->SetDimensions(totalCharWidth, totalCharHeight);
+			glyph.halfWidth  = totalCharWidth / 2.0f;
+			glyph.halfHeight = totalCharHeight / 2.0f;
 
 			_totalWidth += totalCharWidth;
-			if(_totalHeight <= totalCharHeight) { _totalHeight = totalCharHeight; } 
+			if(_totalHeight <= totalCharHeight) { _totalHeight = totalCharHeight; }
 
-			_spriteList.push_back(sprite);
+			//=====Every glyph comes from the same texture, so they all land on the same page=====
+			_textureID = atlasID;
+			_glyphs.push_back(glyph);
 		}
 
 		_center = Vec2(_totalWidth / 2.0f, _totalHeight / 2.0f);
-	}//End AddText
+	}//End _Layout
 
-	void RenderText::SetTextPosition(Vec2& pos)
+	void RenderText::_PackVertices(void)
 	{
-		F32 currentX = pos.GetX();
-		F32 currentY = pos.GetY();
+		_vertices.resize(_glyphs.size());
 
-		for(CharSprite* sprite : _spriteList)
-		{
-			F32 xOffset = F32(sprite->GetXOffset() / 2);
-			F32 yOffset = F32(sprite->GetYOffset() / 2);
+		F32 x = _origin.GetX();
+		F32 y = _origin.GetY();
+		F32 z = _origin.GetZ();
 
-			sprite->SetPosition(Vec2(currentX + xOffset, currentY - yOffset));			
+		for(U32 i = 0; i < _glyphs.size(); ++i)
+		{
+			const GlyphQuad& glyph = _glyphs[i];
 
-			currentX += F32(sprite->GetXAdvance()) * _widthScaleFactor;
+			_vertices[i] = SpriteVertex::Pack(x + glyph.x, y + glyph.y, z, 
+											  _color.GetRed(), _color.GetGreen(), _color.GetBlue(), _color.GetAlpha(),
+											  glyph.halfWidth, glyph.halfHeight, glyph.bottom, glyph.top, glyph.left, glyph.right);
 		}
-	}
 
-	void RenderText::SetTextColor(Col& col)
-	{
-		for(CharSprite* sprite : _spriteList)
-		{
-			sprite->SetColor(col);
-		}
+		_verticesDirty = false;
 	}
 
 }//End Namespace
\ No newline at end of file
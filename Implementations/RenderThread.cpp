@@ -0,0 +1,373 @@
+#include <Engine/RenderThread.h>
+
+namespace KillerEngine
+{
+//==========================================================================================================================
+//
+//Singleton Functions
+//
+//==========================================================================================================================
+	RenderThread* RenderThread::_instance = NULL;
+
+	RenderThread* RenderThread::Instance(void)
+	{
+		if(_instance == NULL) { _instance = new RenderThread(); }
+		return _instance;
+	}
+
+//Every program is finished first, as only the render thread can talk to the driver after this.
+	void RenderThread::Start(void)
+	{
+		if(_running) { return; }
+
+		ShaderRegistry::Instance()->FinishAll();
+
+		//=====Anything already batched is drawn here, with the context still on this thread=====
+		Renderer::Instance()->SetBackend(this);
+
+		for(U32 i = 0; i < _MAX_BUFFERS; ++i)
+		{
+			_snapshots[i].state = SS_FREE;
+		}
+
+		_ready.clear();
+		_writing = -1;
+		_lastShader = 0;
+		_lastTexture = 0;
+		_stopping = false;
+		_running = true;
+
+		WinProgram::Instance()->MakeContextCurrent(false);
+
+		_thread = std::thread(&RenderThread::_ThreadLoop, this);
+	}
+
+//The frame being written when Stop is called is replayed on the normal backend once the context
+//is back, and the rest of it follows straight after, so nothing is dropped. It is not swapped here,
+//it is presented with the rest of the frame.
+	void RenderThread::Stop(void)
+	{
+		if(!_running) { return; }
+
+		//=====Whatever is still in the batch goes into the snapshot first=====
+		Renderer::Instance()->SetBackend(NULL);
+
+		S32 unfinished = -1;
+
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+
+			unfinished = _writing;
+			_writing = -1;
+			_stopping = true;
+		}
+		_signal.notify_all();
+
+		_thread.join();
+		_running = false;
+
+		WinProgram::Instance()->MakeContextCurrent(true);
+		GLStateCache::Instance()->Invalidate();
+		Renderer::Instance()->BindDefaultVertexArray();
+
+		if(unfinished >= 0)
+		{
+			_Replay(*Renderer::Instance()->GetBackend(), _snapshots[unfinished]);
+			_snapshots[unfinished].state = SS_FREE;
+		}
+	}
+
+//==========================================================================================================================
+//
+//Virtual Functions
+//
+//==========================================================================================================================
+	void RenderThread::v_UseShader(GLuint shader)
+	{
+		_AddCommand(RC_USE_SHADER, shader, 0, 0, false, false);
+		_lastShader = shader;
+	}
+
+	void RenderThread::v_BindTexture(U32 textureID)
+	{
+		_AddCommand(RC_BIND_TEXTURE, textureID, 0, 0, false, false);
+		_lastTexture = textureID;
+	}
+
+//The batch belongs to the Renderer, so the vertices are copied into the snapshot.
+	void RenderThread::v_DrawBatch(const RenderBatch& batch)
+	{
+		RenderSnapshot& snapshot = _GetSnapshot();
+		U32 first = (U32)snapshot.vertices.size();
+
+		snapshot.vertices.insert(snapshot.vertices.end(), batch.vertices, batch.vertices + batch.count);
+
+		_AddCommand(RC_DRAW_BATCH, 0, first, batch.count, batch.textured, batch.instanced);
+	}
+
+	void RenderThread::v_DrawStatic(GLuint vertexArray, U32 count, bool blend, bool instanced)
+	{
+		_AddCommand(RC_DRAW_STATIC, vertexArray, 0, count, blend, instanced);
+	}
+
+	void RenderThread::v_BindDefaultVertexArray(void)
+	{
+		_AddCommand(RC_BIND_DEFAULT, 0, 0, 0, false, false);
+	}
+
+	void RenderThread::v_BeginFrame(void)
+	{
+		if(_writing < 0) { _Acquire(); }
+	}
+
+	void RenderThread::v_EndFrame(void)
+	{
+		if(_writing < 0) { _Acquire(); }
+
+		_Publish();
+	}
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+	void RenderThread::SetBufferCount(U32 count)
+	{
+		if(_running)
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "RenderThread -> SetBufferCount called while the thread is running.");
+			return;
+		}
+
+		if(count < 2) { count = 2; }
+		if(count > _MAX_BUFFERS) { count = _MAX_BUFFERS; }
+
+		_bufferCount = count;
+	}
+
+	RenderThreadStats RenderThread::GetStats(void)
+	{
+		std::lock_guard<std::mutex> lock(_lock);
+		return _stats;
+	}
+
+	void RenderThread::ResetStats(void)
+	{
+		std::lock_guard<std::mutex> lock(_lock);
+		_stats = RenderThreadStats();
+	}
+
+//==========================================================================================================================
+//
+//Private Functions
+//
+//==========================================================================================================================
+	RenderThread::RenderSnapshot& RenderThread::_GetSnapshot(void)
+	{
+		if(_writing < 0) { _Acquire(); }
+
+		return _snapshots[_writing];
+	}
+
+//Waits for a free snapshot, unless late frames are dropped, in which case the oldest frame that
+//is waiting is taken instead. The shader and texture are written again at the top, so a snapshot
+//draws the same no matter which frames before it were dropped.
+	void RenderThread::_Acquire(void)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		std::unique_lock<std::mutex> lock(_lock);
+
+		S32 found = -1;
+
+		while(found < 0)
+		{
+			if(_ready.size() < _maxFramesAhead)
+			{
+				for(U32 i = 0; i < _bufferCount && found < 0; ++i)
+				{
+					if(_snapshots[i].state == SS_FREE) { found = (S32)i; }
+				}
+			}
+
+			if(found < 0 && _dropLateFrames && !_ready.empty())
+			{
+				found = (S32)_ready.front();
+				_ready.pop_front();
+				++_stats.framesDropped;
+			}
+
+			if(found < 0) { _signal.wait(lock); }
+		}
+
+		_stats.simWaitMs += std::chrono::duration<F64, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		_writing = found;
+
+		RenderSnapshot& snapshot = _snapshots[found];
+		snapshot.state = SS_WRITING;
+
+		lock.unlock();
+
+		snapshot.commands.clear();
+		snapshot.vertices.clear();
+		snapshot.view = Camera::Instance()->GetTranslation();
+		snapshot.viewVersion = Camera::Instance()->GetVersion();
+
+		const GLfloat* clearColor = WinProgram::Instance()->GetBackgroundColor();
+
+		for(U32 i = 0; i < 4; ++i)
+		{
+			snapshot.clearColor[i] = clearColor[i];
+		}
+
+		if(_lastShader != 0) { _AddCommand(RC_USE_SHADER, _lastShader, 0, 0, false, false); }
+		if(_lastTexture != 0) { _AddCommand(RC_BIND_TEXTURE, _lastTexture, 0, 0, false, false); }
+	}
+
+	void RenderThread::_Publish(void)
+	{
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+
+			_snapshots[_writing].state = SS_READY;
+			_ready.push_back((U32)_writing);
+			_writing = -1;
+			++_stats.framesSubmitted;
+		}
+		_signal.notify_all();
+	}
+
+	void RenderThread::_AddCommand(CommandType type, GLuint id, U32 first, U32 count, bool textured, bool instanced)
+	{
+		RenderCommand command;
+		command.type = type;
+		command.id = id;
+		command.first = first;
+		command.count = count;
+		command.textured = textured;
+		command.instanced = instanced;
+
+		_GetSnapshot().commands.push_back(command);
+	}
+
+//The backend is made here, so every GL object it owns belongs to this thread's time with the
+//context, and is gone before the context is handed back. Frames still waiting when Stop is
+//called are drawn before the loop ends.
+	void RenderThread::_ThreadLoop(void)
+	{
+		WinProgram::Instance()->MakeContextCurrent(true);
+		GLStateCache::Instance()->Invalidate();
+
+		GLRenderBackend* backend = new GLRenderBackend();
+		backend->v_Init();
+
+		while(true)
+		{
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			std::unique_lock<std::mutex> lock(_lock);
+
+			while(_ready.empty() && !_stopping) { _signal.wait(lock); }
+
+			_stats.renderWaitMs += std::chrono::duration<F64, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+			if(_ready.empty()) { break; }
+
+			U32 index = _ready.front();
+			_ready.pop_front();
+
+			RenderSnapshot& snapshot = _snapshots[index];
+			snapshot.state = SS_DRAWING;
+
+			lock.unlock();
+
+			backend->SetView(&snapshot.view, snapshot.viewVersion);
+			backend->v_BeginFrame();
+
+			_Replay(*backend, snapshot);
+
+			backend->v_EndFrame();
+			backend->SetView(NULL, 0);
+
+			WinProgram::Instance()->BufferSwap(snapshot.clearColor);
+
+			lock.lock();
+			snapshot.state = SS_FREE;
+			++_stats.framesDrawn;
+			lock.unlock();
+
+			_signal.notify_all();
+		}
+
+		delete backend;
+
+		GLStateCache::Instance()->Invalidate();
+		WinProgram::Instance()->MakeContextCurrent(false);
+	}
+
+	void RenderThread::_Replay(RenderBackend& backend, const RenderSnapshot& snapshot)
+	{
+		for(U32 i = 0; i < snapshot.commands.size(); ++i)
+		{
+			const RenderCommand& command = snapshot.commands[i];
+
+			switch(command.type)
+			{
+			case RC_USE_SHADER:
+				backend.v_UseShader(command.id);
+				break;
+			case RC_BIND_TEXTURE:
+				backend.v_BindTexture(command.id);
+				break;
+			case RC_DRAW_BATCH:
+			{
+				RenderBatch batch;
+				batch.vertices = &snapshot.vertices[command.first];
+				batch.count = command.count;
+				batch.textured = command.textured;
+				batch.instanced = command.instanced;
+
+				backend.v_DrawBatch(batch);
+				break;
+			}
+			case RC_DRAW_STATIC:
+				backend.v_DrawStatic(command.id, command.count, command.textured, command.instanced);
+				break;
+			case RC_BIND_DEFAULT:
+				backend.v_BindDefaultVertexArray();
+				break;
+			}
+		}
+	}
+
+//==========================================================================================================================
+//
+//Constructor
+//
+//==========================================================================================================================
+	RenderThread::RenderThread(void) : _bufferCount(2),
+									   _maxFramesAhead(1),
+									   _dropLateFrames(false),
+									   _ready(),
+									   _writing(-1),
+									   _lastShader(0),
+									   _lastTexture(0),
+									   _thread(),
+									   _lock(),
+									   _signal(),
+									   _running(false),
+									   _stopping(false),
+									   _stats()
+	{
+		for(U32 i = 0; i < _MAX_BUFFERS; ++i)
+		{
+			_snapshots[i].viewVersion = 0;
+			_snapshots[i].state = SS_FREE;
+		}
+	}
+
+	RenderThread::~RenderThread(void)
+	{
+		Stop();
+	}
+}//End namespace
@@ -60,128 +60,534 @@ namespace KillerEngine
 //=======================================================================================================
 	void Renderer::AddToBatch(GLuint shader, Vec2& pos, F32 w, F32 h, Col& c)
 	{
-		if(_currentShader != shader)
+		_Submit(shader, 0, false, _Pack(pos, w, h, c, 0.0f, 0.0f, 1.0f, 1.0f));
+	}
+
+	void Renderer::AddToBatch(GLuint shader, Vec2& pos, F32 w, F32 h, Col& c, U32 textureID)
+	{
+		_Submit(shader, textureID, true, _Pack(pos, w, h, c, 0.0f, 0.0f, 1.0f, 1.0f));
+	}
+
+	void Renderer::AddToBatch(GLuint shader, Vec2& pos, F32 w, F32 h, Col& c, U32 textureID, Vec2& origin, Vec2& limit)
+	{
+		_Submit(shader, textureID, true, _Pack(pos, w, h, c, origin.GetX(), origin.GetY(), limit.GetX(), limit.GetY()));
+	}
+
+//A texture ID of 0 means the vertices are not textured, the same as DrawStatic.
+	void Renderer::AddToBatch(GLuint shader, U32 textureID, const SpriteVertex* vertices, U32 count)
+	{
+		if(count == 0) { return; }
+
+		bool textured = textureID != 0;
+
+		if(_threadCommandList != NULL)
 		{
-			Draw();
-			_currentShader = shader;
+			_threadCommandList->AddRange(_layer, shader, textureID, textured, vertices, count);
+			return;
+		}
 
-			glUseProgram(_currentShader);
+		_frameStats.sprites += count;
 
-			//_SetOrthoProjection();
-			Camera::Instance()->SetUp(shader);
+		if(_queueEnabled)
+		{
+			_queue.AddRange(_layer, shader, textureID, textured, vertices, count);
+			return;
 		}
 
-		if(_currentBatchSize + 1 >= _maxBatchSize) { Draw(); }
+		if(textured) { SetTexture(textureID); }
+		SetShader(shader);
 
-		_vertices.push_back(pos.GetX());
-		_vertices.push_back(pos.GetY());
-		_vertices.push_back(pos.GetZ());
-		_vertices.push_back(pos.GetW());
-		
-		_dimensions.push_back(w/2);
-		_dimensions.push_back(h/2);
+		for(U32 i = 0; i < count; ++i)
+		{
+			_AddSprite(vertices[i], textured);
+		}
+	}
 
-		_colors.push_back(c.GetRed());
-		_colors.push_back(c.GetGreen());
-		_colors.push_back(c.GetBlue());
-		_colors.push_back(c.GetAlpha());
-		
-		++_currentBatchSize;
+//=======================================================================================================
+//Draw
+//=======================================================================================================
+//Draws everything that has been submitted. With the queue on, that is the whole frame, sorted.
+	void Renderer::Draw(void)
+	{
+		if(!_queue.Empty()) { _DrawQueue(); }
+
+		_DrawBatch();
 	}
 
-	void Renderer::AddToBatch(GLuint shader, Vec2& pos, F32 w, F32 h, Col& c, U32 textureID)
+//=======================================================================================================
+//Queue
+//=======================================================================================================
+//Turning the queue off draws what is in it first, so nothing is lost or drawn twice.
+	void Renderer::SetQueueEnabled(bool state)
 	{
-		if(TextureManager::Instance()->GetCurrentTextureID() != textureID)
+		if(!state && !_queue.Empty()) { Draw(); }
+
+		_queueEnabled = state;
+	}
+
+	void Renderer::_Submit(GLuint shader, U32 textureID, bool textured, const SpriteVertex& vertex)
+	{
+		if(_threadCommandList != NULL)
 		{
-			Draw();
-			TextureManager::Instance()->SetCurrentTextureID(textureID);
+			_threadCommandList->Add(_layer, shader, textureID, textured, vertex);
+			return;
 		}
 
-		_bottomTop.push_back(0.0f);
-		_bottomTop.push_back(0.0f);
-		_leftRight.push_back(1.0f);
-		_leftRight.push_back(1.0f);
-		AddToBatch(shader, pos, w, h, c);
+		++_frameStats.sprites;
+
+		if(_queueEnabled)
+		{
+			_queue.Add(_layer, shader, textureID, textured, vertex);
+			return;
+		}
+
+		if(textured) { SetTexture(textureID); }
+		SetShader(shader);
+		_AddSprite(vertex, textured);
 	}
 
-	void Renderer::AddToBatch(GLuint shader, Vec2& pos, F32 w, F32 h, Col& c, U32 textureID, Vec2& origin, Vec2& limit)
+	void Renderer::_DrawQueue(void)
 	{
-		
-		if(TextureManager::Instance()->GetCurrentTextureID() != textureID)
+		if(_queue.Size() > _frameStats.highWater) { _frameStats.highWater = _queue.Size(); }
+
+		_queue.Sort();
+
+		for(U32 i = 0; i < _queue.Size(); ++i)
 		{
-			Draw();
-			TextureManager::Instance()->SetCurrentTextureID(textureID);
+			const QueuedSprite& sprite = _queue.Get(i);
+
+			if(sprite.textured) { SetTexture(sprite.textureID); }
+			SetShader(sprite.shader);
+			_AddSprite(sprite.vertex, sprite.textured);
 		}
-		
-		_bottomTop.push_back(origin.GetX());
-		_bottomTop.push_back(origin.GetY());
-		_leftRight.push_back(limit.GetX());
-		_leftRight.push_back(limit.GetY());
-		AddToBatch(shader, pos, w, h, c);
+
+		_queue.Clear();
 	}
 
 //=======================================================================================================
-//Draw
+//_DrawBatch
 //=======================================================================================================
-
-	void Renderer::Draw(void)
+	void Renderer::_DrawBatch(void)
 	{
 		if(_currentBatchSize == 0) return;
 
-		GLuint buffers[5];
-		glGenBuffers(5, buffers);
-
-		glBindBuffer(GL_ARRAY_BUFFER, buffers[0]);
-		glBufferData(GL_ARRAY_BUFFER, (sizeof(F32) * _vertices.size()), &_vertices[0], GL_STATIC_DRAW);
-		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 0, NULL);
-		
-		glBindBuffer(GL_ARRAY_BUFFER, buffers[1]);
-		glBufferData(GL_ARRAY_BUFFER, (sizeof(F32) * _colors.size()), &_colors[0], GL_STATIC_DRAW);
-		glEnableVertexAttribArray(1);
-		glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 0, NULL);
-
-		glBindBuffer(GL_ARRAY_BUFFER, buffers[2]);
-		glBufferData(GL_ARRAY_BUFFER, (sizeof(F32) * _dimensions.size()), &_dimensions[0], GL_STATIC_DRAW);
-		glEnableVertexAttribArray(2);
-		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 0, NULL);
-
-		if(_bottomTop.size() > 0)
-		{
-			
-			glEnable (GL_BLEND); 
-			glBlendFunc (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-			glBindBuffer(GL_ARRAY_BUFFER, buffers[3]);
-			glBufferData(GL_ARRAY_BUFFER, (sizeof(F32) * _bottomTop.size()), &_bottomTop[0], GL_STATIC_DRAW);
-			glEnableVertexAttribArray(3);
-			glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, 0, NULL);
-	
-			glBindBuffer(GL_ARRAY_BUFFER, buffers[4]);
-			glBufferData(GL_ARRAY_BUFFER, (sizeof(F32) * _leftRight.size()), &_leftRight[0], GL_STATIC_DRAW);
-			glEnableVertexAttribArray(4);
-			glVertexAttribPointer(4, 2, GL_FLOAT, GL_FALSE, 0, NULL);
-		}
-		
-		glDrawArrays(GL_POINTS, 0, _currentBatchSize);
-
-		//=====Reset All Containers and Counters=====
-		_vertices.clear();
-		_dimensions.clear();
-		_colors.clear();
-		_bottomTop.clear();
-		_leftRight.clear();
+		RenderBatch batch;
+		batch.vertices = _batchData;
+		batch.count = _currentBatchSize;
+		batch.textured = _batchTextured;
+		batch.instanced = _currentInstanced;
+
+		_GetBackend()->v_DrawBatch(batch);
+		++_frameStats.batches;
+
+		//=====Reset the Counters, the array is kept for the next batch=====
+		_batchTextured = false;
 		_currentBatchSize = 0;
 	}
+
+//=======================================================================================================
+//_AddSprite
+//=======================================================================================================
+//Writes the packed sprite into the next slot of the batch in one store.
+	void Renderer::_AddSprite(const SpriteVertex& vertex, bool textured)
+	{
+		if(_currentBatchSize >= _maxBatchSize) { _DrawBatch(); }
+
+		_batchData[_currentBatchSize] = vertex;
+
+		_batchTextured = _batchTextured || textured;
+		++_currentBatchSize;
+	}
+
+	SpriteVertex Renderer::_Pack(Vec2& pos, F32 w, F32 h, Col& c, F32 bottom, F32 top, F32 left, F32 right)
+	{
+		return SpriteVertex::Pack(pos.GetX(), pos.GetY(), pos.GetZ(), 
+								  c.GetRed(), c.GetGreen(), c.GetBlue(), c.GetAlpha(), 
+								  w / 2, h / 2, bottom, top, left, right);
+	}
+
+//=======================================================================================================
+//EndFrame
+//=======================================================================================================
+//Anything the queue grows by here is counted against this frame, so a frame that sets a new high
+//water mark shows up, and the next one of the same size does not.
+	void Renderer::EndFrame(void)
+	{
+		_queue.Reserve(_frameStats.highWater + _frameStats.highWater / 8);
+
+		U32 growths = _GetGrowthCount();
+		_frameStats.bufferGrowths = growths - _frameGrowthBase;
+		_frameGrowthBase = growths;
+
+		_lastFrameStats = _frameStats;
+		_frameStats = RenderFrameStats();
+
+		_GetBackend()->v_EndFrame();
+	}
+
+//=======================================================================================================
+//RecordParallel
+//=======================================================================================================
+//Each piece has its own list, picked by its index, so two threads never share one
+//and the lists can be merged in the order the range was given. The lists keep their size between
+//frames like the queue does.
+	thread_local RenderQueue* Renderer::_threadCommandList = NULL;
+
+	void Renderer::RecordParallel(U32 count, U32 grain, const std::function<void(U32 begin, U32 end)>& record)
+	{
+		if(count == 0) { return; }
+		if(grain == 0) { grain = 1; }
+
+		if(!_queueEnabled || count <= grain)
+		{
+			record(0, count);
+			return;
+		}
+
+		U32 pieces = (count + grain - 1) / grain;
+
+		if(_commandLists.size() < pieces)
+		{
+			_commandLists.resize(pieces);
+			++_commandListGrowths;
+		}
+
+		_record = &record;
+		_recordCount = count;
+		_recordGrain = grain;
+		_recordPieces = pieces;
+		_nextRecordPiece.store(0, std::memory_order_relaxed);
+
+		//=====The first Submit starts the pool if it has not been, so the worker count is known after it=====
+		JobPool* pool = JobPool::Instance();
+		JobGroup group;
+
+		pool->Submit(group, &_recordJob);
+
+		U32 jobs = pool->GetWorkerCount() + 1 < pieces ? pool->GetWorkerCount() + 1 : pieces;
+
+		for(U32 i = 1; i < jobs; ++i)
+		{
+			pool->Submit(group, &_recordJob);
+		}
+
+		pool->Wait(group);
+		_record = NULL;
+
+		for(U32 i = 0; i < pieces; ++i)
+		{
+			RenderQueue& list = _commandLists[i];
+
+			_frameStats.sprites += list.Size();
+			_queue.Append(list);
+			list.Clear();
+		}
+	}
+
+	U32 Renderer::_GetGrowthCount(void) const
+	{
+		U32 count = _queue.GetGrowthCount() + _commandListGrowths;
+
+		for(U32 i = 0; i < _commandLists.size(); ++i)
+		{
+			count += _commandLists[i].GetGrowthCount();
+		}
+
+		return count;
+	}
+
+//Runs on every thread _recordJob was given to. The lists are picked by piece, not by thread, so it
+//does not matter which thread takes which piece.
+	void Renderer::_RecordPieces(void)
+	{
+		RenderQueue* previous = _threadCommandList;
+
+		for(U32 piece = _nextRecordPiece.fetch_add(1, std::memory_order_relaxed); piece < _recordPieces; 
+			piece = _nextRecordPiece.fetch_add(1, std::memory_order_relaxed))
+		{
+			U32 begin = piece * _recordGrain;
+			U32 end = _recordCount - begin > _recordGrain ? begin + _recordGrain : _recordCount;
+
+			_threadCommandList = &_commandLists[piece];
+			(*_record)(begin, end);
+		}
+
+		_threadCommandList = previous;
+	}
+
+//=======================================================================================================
+//SetShader
+//=======================================================================================================
+	void Renderer::SetShader(GLuint shader)
+	{
+		if(_currentShader == shader) { return; }
+
+		_DrawBatch();
+		_currentShader = shader;
+		_currentInstanced = IsInstancedShader(shader);
+
+		//_SetOrthoProjection();
+		_GetBackend()->v_UseShader(_currentShader);
+	}
+
+//=======================================================================================================
+//SetTexture
+//=======================================================================================================
+	void Renderer::SetTexture(U32 textureID)
+	{
+		if(_currentTextureID == textureID) { return; }
+
+		_DrawBatch();
+		_currentTextureID = textureID;
+
+		_GetBackend()->v_BindTexture(textureID);
+	}
+
+//=======================================================================================================
+//SetBackend
+//=======================================================================================================
+//Anything in the batch is drawn with the old backend first. NULL goes back to the GLRenderBackend.
+//The shader and texture are bound again on the new backend the next time they are used.
+	void Renderer::SetBackend(RenderBackend* backend)
+	{
+		if(backend == NULL) { backend = &_glBackend; }
+
+		if(backend == _backend) { return; }
+
+		Draw();
+		_backend = backend;
+		_backendReady = false;
+		_currentShader = 0;
+		_currentInstanced = false;
+		_currentTextureID = 0;
+
+		if(_batchSizeOverride == 0) { _ResizeBatch(_GetBackendBatchSize()); }
+	}
+
+//=======================================================================================================
+//Batch Size
+//=======================================================================================================
+	void Renderer::SetMaxBatchSize(U32 sprites)
+	{
+		Draw();
+
+		_batchSizeOverride = sprites;
+		_ResizeBatch(sprites == 0 ? _GetBackendBatchSize() : sprites);
+	}
+
+//Every size is tried with the queue off, so the time is only batching and the driver, not sorting.
+//One frame at each size is thrown away first to let the driver settle.
+	U32 Renderer::CalibrateBatchSize(GLuint shader, U32 sprites, U32 frames)
+	{
+		_calibrationResults.clear();
+
+		if(_backend->v_IsDeferred())
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "Renderer -> CalibrateBatchSize can not time a deferred backend.");
+			return _maxBatchSize;
+		}
+
+		if(sprites == 0 || frames == 0) { return _maxBatchSize; }
+
+		Draw();
+
+		std::vector<SpriteVertex> vertices(sprites);
+		F32 width = (F32)WinProgram::Instance()->GetWidth();
+		F32 height = (F32)WinProgram::Instance()->GetHeight();
+
+		for(U32 i = 0; i < sprites; ++i)
+		{
+			vertices[i] = SpriteVertex::Pack((F32)(i % 97) / 97.0f * width, (F32)(i % 89) / 89.0f * height, 0.0f, 
+											 1.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f);
+		}
+
+		bool queueEnabled = _queueEnabled;
+		U32 limit = _GetBackendBatchSize();
+		U32 best = _maxBatchSize;
+		F64 bestTime = 0.0;
+
+		_queueEnabled = false;
+		_ResizeBatch(limit);
+
+		for(U32 size = 256; ; size *= 2)
+		{
+			if(size > limit) { size = limit; }
+
+			_maxBatchSize = size;
+
+			F64 total = 0.0;
+
+			for(U32 frame = 0; frame <= frames; ++frame)
+			{
+				std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+				AddToBatch(shader, 0, &vertices[0], sprites);
+				_DrawBatch();
+				_GetBackend()->v_Finish();
+
+				if(frame > 0) { total += std::chrono::duration<F64, std::milli>(std::chrono::steady_clock::now() - start).count(); }
+			}
+
+			BatchSizeResult result;
+			result.batchSize = size;
+			result.frameTime = total / frames;
+			_calibrationResults.push_back(result);
+
+			if(bestTime == 0.0 || result.frameTime < bestTime)
+			{
+				best = size;
+				bestTime = result.frameTime;
+			}
+
+			if(size == limit) { break; }
+		}
+
+		_queueEnabled = queueEnabled;
+		_frameStats = RenderFrameStats();
+
+		SetMaxBatchSize(best);
+
+		return best;
+	}
+
+	U32 Renderer::_GetBackendBatchSize(void)
+	{
+		U32 capacity = _backend->v_GetBatchCapacity();
+
+		if(capacity == 0) { capacity = _glBackend.v_GetBatchCapacity(); }
+
+		return capacity == 0 ? 1 : capacity;
+	}
+
+//The array only grows, so going back to a larger size later does not allocate again. Nothing may be
+//waiting in the batch when this is called.
+	void Renderer::_ResizeBatch(U32 sprites)
+	{
+		if(sprites == 0) { sprites = 1; }
+
+		if(_batch.size() < sprites) { _batch.resize(sprites); }
+
+		_batchData = &_batch[0];
+		_maxBatchSize = sprites;
+	}
+
+//=======================================================================================================
+//SpritePath
+//=======================================================================================================
+//Sprites ask for their shader every time they are rendered, so a change takes effect on the next
+//frame, but it costs a second set of programs. Anything already submitted is drawn first.
+	void Renderer::SetSpritePath(SpritePath path)
+	{
+		if(path == _spritePath) { return; }
+
+		Draw();
+		_spritePath = path;
+	}
+
+	void Renderer::RegisterInstancedShader(GLuint shader)
+	{
+		if(shader == 0 || IsInstancedShader(shader)) { return; }
+
+		_instancedShaders.push_back(shader);
+	}
+
+	bool Renderer::IsInstancedShader(GLuint shader) const
+	{
+		for(U32 i = 0; i < _instancedShaders.size(); ++i)
+		{
+			if(_instancedShaders[i] == shader) { return true; }
+		}
+
+		return false;
+	}
+
+//=======================================================================================================
+//DrawStatic
+//=======================================================================================================
+//Draws a buffer that is already on the GPU, such as a chunk from the StaticLayerCache. The vertex 
+//array must use the same attribute layout as the batch. Anything waiting in the batch is drawn
+//first so the order things were submitted in is kept.
+	void Renderer::DrawStatic(GLuint shader, U32 textureID, GLuint vertexArray, U32 count)
+	{
+		if(count == 0) return;
+
+		Draw();
+		SetShader(shader);
+
+		if(textureID != 0) { SetTexture(textureID); }
+
+		_GetBackend()->v_DrawStatic(vertexArray, count, textureID != 0, _currentInstanced);
+	}
+
+//=======================================================================================================
+//AddParticles
+//=======================================================================================================
+//The batch is empty once Draw returns, so each run is packed over the top of it and flushed.
+	void Renderer::AddParticles(GLuint shader, U32 textureID, const ParticleBuffer2D& particles)
+	{
+		U32 count = particles.GetCount();
+
+		if(count == 0) return;
+
+		Draw();
+		SetShader(shader);
+
+		bool textured = textureID != 0;
+
+		if(textured) { SetTexture(textureID); }
+
+		_frameStats.sprites += count;
+
+		for(U32 first = 0; first < count; first += _maxBatchSize)
+		{
+			U32 run = count - first < _maxBatchSize ? count - first : _maxBatchSize;
+
+			particles.Pack(_batchData, first, run);
+
+			_currentBatchSize = run;
+			_batchTextured = textured;
+			_DrawBatch();
+		}
+	}
+
 //=======================================================================================================
 //
 //Constructor
 //
 //=======================================================================================================
-	Renderer::Renderer(void): _maxBatchSize(1000), 
-							  _currentBatchSize(0)
+	Renderer::Renderer(void): _maxBatchSize(0), 
+							  _batchSizeOverride(0),
+							  _calibrationResults(),
+							  _currentBatchSize(0),
+							  _batch(),
+							  _batchData(NULL),
+							  _batchTextured(false),
+							  _queue(),
+							  _queueEnabled(false),
+							  _layer(0),
+							  _frameStats(),
+							  _lastFrameStats(),
+							  _frameGrowthBase(0),
+							  _commandLists(),
+							  _commandListGrowths(0),
+							  _recordJob(),
+							  _record(NULL),
+							  _recordCount(0),
+							  _recordGrain(0),
+							  _recordPieces(0),
+							  _nextRecordPiece(0),
+							  _glBackend(),
+							  _backend(&_glBackend),
+							  _backendReady(false),
+							  _spritePath(SP_POINTS),
+							  _instancedShaders(),
+							  _currentInstanced(false),
+							  _currentShader(0),
+							  _currentTextureID(0)
 	{ 
-		glGenVertexArrays(1, &_vertexArrayObject);
-		glBindVertexArray(_vertexArrayObject);
+		_recordJob = [this]() { _RecordPieces(); };
+
+		_ResizeBatch(_GetBackendBatchSize());
 	}
 
 }//End namespace		
\ No newline at end of file
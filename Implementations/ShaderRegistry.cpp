@@ -0,0 +1,383 @@
+#include <Engine/ShaderRegistry.h>
+
+namespace KillerEngine
+{
+//==========================================================================================================================
+//
+//Singleton Functions
+//
+//==========================================================================================================================
+	ShaderRegistry* ShaderRegistry::_instance = NULL;
+
+	ShaderRegistry* ShaderRegistry::Instance(void)
+	{
+		if(_instance == NULL) { _instance = new ShaderRegistry(); }
+		return _instance;
+	}
+
+	void ShaderRegistry::ShutDown(void)
+	{
+		for(auto i = _entries.begin(); i != _entries.end(); ++i)
+		{
+			Finish(i->first);
+
+			if(i->second.program == 0) { continue; }
+
+			GLStateCache::Instance()->ForgetProgram(i->second.program);
+			glDeleteProgram(i->second.program);
+		}
+
+		_entries.clear();
+
+		//=====The next context may not be the same driver=====
+		_driver.clear();
+		_parallelChecked = false;
+		_parallelCompile = false;
+	}
+
+//==========================================================================================================================
+//
+//ShaderRegistry Functions
+//
+//==========================================================================================================================
+	U64 ShaderRegistry::Request(const GLchar* vertex, const GLchar* geometry, const GLchar* fragment, string name)
+	{
+		U64 key = HashSources(vertex, geometry, fragment);
+
+		if(_entries.find(key) != _entries.end())
+		{
+			++_stats.duplicates;
+			return key;
+		}
+
+		_CheckParallel();
+
+		ShaderEntry entry;
+		entry.name = name;
+		entry.vertex = vertex;
+		entry.geometry = geometry;
+		entry.fragment = fragment;
+		entry.program = 0;
+		entry.shaders[0] = 0;
+		entry.shaders[1] = 0;
+		entry.shaders[2] = 0;
+		entry.fromBinary = false;
+		entry.finished = false;
+
+		if(!_LoadBinary(key, entry)) { _Compile(entry); }
+
+		_entries.insert(std::map<U64, ShaderEntry>::value_type(key, entry));
+		++_stats.programs;
+
+		return key;
+	}
+
+//Checking the link status is what makes the driver finish, so nothing asks for it until here.
+	GLuint ShaderRegistry::Finish(U64 key)
+	{
+		auto found = _entries.find(key);
+
+		if(found == _entries.end())
+		{
+			ErrorManager::Instance()->SetError(EC_OpenGL_Shader, "ShaderRegistry -> Finish was called for a program that was never requested.");
+			return 0;
+		}
+
+		ShaderEntry& entry = found->second;
+
+		if(entry.finished) { return entry.program; }
+
+		entry.finished = true;
+
+		if(!entry.fromBinary)
+		{
+			GLint isLinked = 0;
+			glGetProgramiv(entry.program, GL_LINK_STATUS, &isLinked);
+
+			if(isLinked == GL_FALSE)
+			{
+				_ReportLinkError(entry);
+
+				glDeleteProgram(entry.program);
+				entry.program = 0;
+			}
+
+			for(U32 i = 0; i < 3; ++i)
+			{
+				if(entry.shaders[i] != 0) { glDeleteShader(entry.shaders[i]); }
+				entry.shaders[i] = 0;
+			}
+
+			if(entry.program != 0) { _SaveBinary(key, entry); }
+		}
+
+		GLStateCache::Instance()->CacheProgram(entry.program);
+
+		return entry.program;
+	}
+
+	void ShaderRegistry::FinishAll(void)
+	{
+		for(auto i = _entries.begin(); i != _entries.end(); ++i)
+		{
+			Finish(i->first);
+		}
+	}
+
+//Without the extension there is no way to ask, so this says yes and Finish may stall.
+	bool ShaderRegistry::IsReady(U64 key)
+	{
+		auto found = _entries.find(key);
+
+		if(found == _entries.end()) { return false; }
+
+		const ShaderEntry& entry = found->second;
+
+		if(entry.finished || entry.fromBinary || !_parallelCompile) { return true; }
+
+		GLint done = 0;
+		glGetProgramiv(entry.program, GL_COMPLETION_STATUS_KHR, &done);
+
+		return done != 0;
+	}
+
+	GLuint ShaderRegistry::GetProgram(const GLchar* vertex, const GLchar* geometry, const GLchar* fragment, string name)
+	{
+		return Finish(Request(vertex, geometry, fragment, name));
+	}
+
+//FNV-1a over each source in turn. The stage marker keeps a shader moved from one stage to another
+//from hashing the same.
+	U64 ShaderRegistry::HashSources(const GLchar* vertex, const GLchar* geometry, const GLchar* fragment)
+	{
+		const GLchar* sources[3] = { vertex, geometry, fragment };
+		U64 hash = 14695981039346656037ULL;
+
+		for(U32 s = 0; s < 3; ++s)
+		{
+			hash ^= (U64)(s + 1);
+			hash *= 1099511628211ULL;
+
+			if(sources[s] == NULL) { continue; }
+
+			for(const GLchar* c = sources[s]; *c != 0; ++c)
+			{
+				hash ^= (U8)*c;
+				hash *= 1099511628211ULL;
+			}
+		}
+
+		return hash;
+	}
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+	void ShaderRegistry::SetCacheDirectory(string path)
+	{
+		if(!path.empty() && path[path.size() - 1] != '/' && path[path.size() - 1] != '\\') { path += '/'; }
+
+		_cacheDirectory = path;
+	}
+
+//==========================================================================================================================
+//
+//Private Functions
+//
+//==========================================================================================================================
+	void ShaderRegistry::_CheckParallel(void)
+	{
+		if(_parallelChecked) { return; }
+
+		_parallelChecked = true;
+
+		GLint count = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+		bool found = false;
+
+		for(GLint i = 0; i < count && !found; ++i)
+		{
+			const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+
+			if(extension == NULL) { continue; }
+
+			found = strcmp(extension, "GL_KHR_parallel_shader_compile") == 0 || strcmp(extension, "GL_ARB_parallel_shader_compile") == 0;
+		}
+
+		if(!found) { return; }
+
+		MaxCompilerThreadsProc maxThreads = (MaxCompilerThreadsProc)gl3wGetProcAddress("glMaxShaderCompilerThreadsKHR");
+
+		if(maxThreads == NULL) { maxThreads = (MaxCompilerThreadsProc)gl3wGetProcAddress("glMaxShaderCompilerThreadsARB"); }
+
+		//=====0xFFFFFFFF lets the driver pick how many=====
+		if(maxThreads != NULL) { maxThreads(0xFFFFFFFF); }
+
+		_parallelCompile = true;
+	}
+
+	void ShaderRegistry::_Compile(ShaderEntry& entry)
+	{
+		entry.shaders[0] = _CompileStage(GL_VERTEX_SHADER, entry.vertex);
+		entry.shaders[1] = entry.geometry == NULL ? 0 : _CompileStage(GL_GEOMETRY_SHADER, entry.geometry);
+		entry.shaders[2] = _CompileStage(GL_FRAGMENT_SHADER, entry.fragment);
+
+		entry.program = glCreateProgram();
+
+		if(!_cacheDirectory.empty()) { glProgramParameteri(entry.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE); }
+
+		for(U32 i = 0; i < 3; ++i)
+		{
+			if(entry.shaders[i] != 0) { glAttachShader(entry.program, entry.shaders[i]); }
+		}
+
+		glLinkProgram(entry.program);
+
+		++_stats.compiled;
+	}
+
+	GLuint ShaderRegistry::_CompileStage(GLenum stage, const GLchar* source)
+	{
+		GLuint shader = glCreateShader(stage);
+		glShaderSource(shader, 1, &source, NULL);
+		glCompileShader(shader);
+
+		return shader;
+	}
+
+//The binary is only trusted if the same driver made it, and the driver takes it back.
+	bool ShaderRegistry::_LoadBinary(U64 key, ShaderEntry& entry)
+	{
+		if(_cacheDirectory.empty()) { return false; }
+
+		std::ifstream file(_GetCachePath(key).c_str(), std::ios::binary);
+
+		if(!file.is_open()) { return false; }
+
+		string header;
+		string driver;
+		std::getline(file, header);
+		std::getline(file, driver);
+
+		GLenum format = 0;
+		GLint length = 0;
+		file >> format >> length;
+		file.get();
+
+		if(header != "KillerShader 1" || driver != _GetDriver() || length <= 0)
+		{
+			++_stats.binaryRejects;
+			return false;
+		}
+
+		std::vector<U8> data(length);
+		file.read((char*)&data[0], length);
+
+		if(file.gcount() != length)
+		{
+			++_stats.binaryRejects;
+			return false;
+		}
+
+		GLuint program = glCreateProgram();
+		glProgramBinary(program, format, &data[0], length);
+
+		GLint isLinked = 0;
+		glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+
+		if(isLinked == GL_FALSE)
+		{
+			glDeleteProgram(program);
+			++_stats.binaryRejects;
+			return false;
+		}
+
+		entry.program = program;
+		entry.fromBinary = true;
+		++_stats.binaryLoads;
+
+		return true;
+	}
+
+	void ShaderRegistry::_SaveBinary(U64 key, const ShaderEntry& entry)
+	{
+		if(_cacheDirectory.empty()) { return; }
+
+		GLint length = 0;
+		glGetProgramiv(entry.program, GL_PROGRAM_BINARY_LENGTH, &length);
+
+		if(length <= 0) { return; }
+
+		std::vector<U8> data(length);
+		GLenum format = 0;
+		glGetProgramBinary(entry.program, length, &length, &format, &data[0]);
+
+		string path = _GetCachePath(key);
+		std::ofstream file(path.c_str(), std::ios::binary);
+
+		if(!file.is_open())
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "ShaderRegistry -> Unable to open " + path + " to save " + entry.name + ".");
+			return;
+		}
+
+		file << "KillerShader 1\n" << _GetDriver() << "\n" << format << " " << length << "\n";
+		file.write((const char*)&data[0], length);
+
+		++_stats.binarySaves;
+	}
+
+	string ShaderRegistry::_GetDriver(void)
+	{
+		if(!_driver.empty()) { return _driver; }
+
+		const char* vendor = (const char*)glGetString(GL_VENDOR);
+		const char* renderer = (const char*)glGetString(GL_RENDERER);
+		const char* version = (const char*)glGetString(GL_VERSION);
+
+		_driver = string(vendor == NULL ? "" : vendor) + " | " +
+				  string(renderer == NULL ? "" : renderer) + " | " +
+				  string(version == NULL ? "" : version);
+
+		return _driver;
+	}
+
+	string ShaderRegistry::_GetCachePath(U64 key) const
+	{
+		std::stringstream path;
+		path << _cacheDirectory << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+
+		return path.str();
+	}
+
+	void ShaderRegistry::_ReportLinkError(const ShaderEntry& entry)
+	{
+		string errorMessage("Compile Error in " + entry.name + "\n");
+		GLint maxLength = 0;
+		glGetProgramiv(entry.program, GL_INFO_LOG_LENGTH, &maxLength);
+
+		//The maxLength includes the NULL character
+		std::vector<GLchar> infoLog(maxLength + 1, 0);
+		glGetProgramInfoLog(entry.program, maxLength, &maxLength, &infoLog[0]);
+
+		errorMessage += &infoLog[0];
+
+		ErrorManager::Instance()->SetError(EC_OpenGL_Shader, errorMessage);
+	}
+
+//==========================================================================================================================
+//
+//Constructor
+//
+//==========================================================================================================================
+	ShaderRegistry::ShaderRegistry(void) : _entries(),
+										   _cacheDirectory(),
+										   _driver(),
+										   _parallelChecked(false),
+										   _parallelCompile(false),
+										   _stats()
+	{  }
+}//End namespace
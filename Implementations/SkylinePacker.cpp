@@ -0,0 +1,135 @@
+#include <Engine/SkylinePacker.h>
+
+namespace KillerEngine
+{
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+	SkylinePacker::SkylinePacker(void) : _width(0), _height(0), _usedArea(0), _skyline()
+	{  }
+
+	SkylinePacker::SkylinePacker(U32 width, U32 height) : _width(0), _height(0), _usedArea(0), _skyline()
+	{
+		Init(width, height);
+	}
+
+//==========================================================================================================================
+//
+//SkylinePacker Functions
+//
+//==========================================================================================================================
+	void SkylinePacker::Init(U32 width, U32 height)
+	{
+		_width = width;
+		_height = height;
+		_usedArea = 0;
+
+		Segment floor;
+		floor.x = 0;
+		floor.y = 0;
+		floor.width = (S32)width;
+
+		_skyline.clear();
+		_skyline.push_back(floor);
+	}
+
+	//=====Bottom left: the lowest top edge wins, then the narrowest segment to waste less=====
+	bool SkylinePacker::Insert(U32 width, U32 height, U32& x, U32& y)
+	{
+		S32 bestIndex = -1;
+		S32 bestTop = 0;
+		S32 bestWidth = 0;
+		S32 bestY = 0;
+
+		for(U32 i = 0; i < _skyline.size(); ++i)
+		{
+			S32 fitY = _Fit(i, width, height);
+
+			if(fitY < 0) { continue; }
+
+			S32 top = fitY + (S32)height;
+
+			if(bestIndex < 0 || top < bestTop || (top == bestTop && _skyline[i].width < bestWidth))
+			{
+				bestIndex = (S32)i;
+				bestTop = top;
+				bestWidth = _skyline[i].width;
+				bestY = fitY;
+			}
+		}
+
+		if(bestIndex < 0) { return false; }
+
+		Segment added;
+		added.x = _skyline[bestIndex].x;
+		added.y = bestTop;
+		added.width = (S32)width;
+
+		_skyline.insert(_skyline.begin() + bestIndex, added);
+
+		//=====Cut back the segments that are now under the new one=====
+		for(U32 i = bestIndex + 1; i < _skyline.size(); ++i)
+		{
+			const Segment& previous = _skyline[i - 1];
+			S32 previousEnd = previous.x + previous.width;
+
+			if(_skyline[i].x >= previousEnd) { break; }
+
+			S32 shrink = previousEnd - _skyline[i].x;
+			_skyline[i].x += shrink;
+			_skyline[i].width -= shrink;
+
+			if(_skyline[i].width > 0) { break; }
+
+			_skyline.erase(_skyline.begin() + i);
+			--i;
+		}
+
+		//=====Join neighbours at the same height=====
+		for(U32 i = 0; i + 1 < _skyline.size(); ++i)
+		{
+			if(_skyline[i].y == _skyline[i + 1].y)
+			{
+				_skyline[i].width += _skyline[i + 1].width;
+				_skyline.erase(_skyline.begin() + i + 1);
+				--i;
+			}
+		}
+
+		x = (U32)added.x;
+		y = (U32)bestY;
+		_usedArea += (U64)width * height;
+
+		return true;
+	}
+
+//==========================================================================================================================
+//
+//Private Functions
+//
+//==========================================================================================================================
+	//=====The y a rect would sit at if its left edge was at this segment, or -1 if it does not fit=====
+	S32 SkylinePacker::_Fit(U32 index, U32 width, U32 height) const
+	{
+		S32 x = _skyline[index].x;
+
+		if(x + (S32)width > (S32)_width) { return -1; }
+
+		S32 widthLeft = (S32)width;
+		S32 y = _skyline[index].y;
+
+		while(widthLeft > 0)
+		{
+			if(_skyline[index].y > y) { y = _skyline[index].y; }
+
+			if(y + (S32)height > (S32)_height) { return -1; }
+
+			widthLeft -= _skyline[index].width;
+			++index;
+		}
+
+		return y;
+	}
+}//End namespace
@@ -0,0 +1,364 @@
+#include <Engine/StaticLayerCache.h>
+
+namespace KillerEngine
+{
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+	StaticLayerCache::StaticLayerCache(void) : _chunkSize(512.0f), 
+											   _chunks(), 
+											   _objectChunks(), 
+											   _sorted(), 
+											   _drawCount(0), 
+											   _rebuildCount(0),
+											   _culledCount(0),
+											   _deferred(false)
+	{  }
+
+	StaticLayerCache::~StaticLayerCache(void)
+	{
+		Clear();
+	}
+
+//==========================================================================================================================
+//
+//StaticLayerCache Functions
+//
+//==========================================================================================================================
+	void StaticLayerCache::Add(GameObject2D* obj)
+	{
+		if(Contains(obj->GetID()))
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "StaticLayerCache -> Object is already in the static layer.");
+			return;
+		}
+
+		U64 key = _ChunkKey(obj);
+		StaticChunk& chunk = _chunks[key];
+
+		chunk.objects.push_back(obj);
+		chunk.dirty = true;
+
+		_objectChunks.insert(std::map<U32, U64>::value_type(obj->GetID(), key));
+	}
+
+	void StaticLayerCache::Remove(GameObject2D* obj)
+	{
+		auto found = _objectChunks.find(obj->GetID());
+
+		if(found == _objectChunks.end()) { return; }
+
+		auto chunk = _chunks.find(found->second);
+		_objectChunks.erase(found);
+
+		if(chunk == _chunks.end()) { return; }
+
+		std::vector<GameObject2D*>& objects = chunk->second.objects;
+
+		for(U32 i = 0; i < objects.size(); ++i)
+		{
+			if(objects[i] == obj)
+			{
+				objects[i] = objects.back();
+				objects.pop_back();
+				break;
+			}
+		}
+
+		chunk->second.dirty = true;
+
+		_EraseIfEmpty(chunk, Renderer::Instance()->GetBackend()->v_IsDeferred());
+	}
+
+	void StaticLayerCache::MarkDirty(GameObject2D* obj)
+	{
+		auto found = _objectChunks.find(obj->GetID());
+
+		if(found == _objectChunks.end()) { return; }
+
+		//=====The object may have moved to a different chunk=====
+		U64 key = _ChunkKey(obj);
+
+		if(key != found->second)
+		{
+			Remove(obj);
+			Add(obj);
+			return;
+		}
+
+		_chunks[key].dirty = true;
+	}
+
+	void StaticLayerCache::MarkAllDirty(void)
+	{
+		for(auto i = _chunks.begin(); i != _chunks.end(); ++i)
+		{
+			i->second.dirty = true;
+		}
+	}
+
+	void StaticLayerCache::Clear(void)
+	{
+		for(auto i = _chunks.begin(); i != _chunks.end(); ++i)
+		{
+			for(U32 b = 0; b < i->second.batches.size(); ++b)
+			{
+				_DeleteBatch(i->second.batches[b]);
+			}
+		}
+
+		_chunks.clear();
+		_objectChunks.clear();
+	}
+
+	void StaticLayerCache::Render(void)
+	{
+		_Render(NULL);
+	}
+
+	void StaticLayerCache::Render(const AABB2D& view)
+	{
+		_Render(&view);
+	}
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+	void StaticLayerCache::SetChunkSize(F32 size)
+	{
+		if(!_objectChunks.empty())
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "StaticLayerCache -> The chunk size can only be changed while the cache is empty.");
+			return;
+		}
+
+		_chunkSize = size;
+	}
+
+//==========================================================================================================================
+//
+//Private Functions
+//
+//==========================================================================================================================
+//A dirty chunk is recorded before it is culled, as its bounds may have changed. When the Renderer's
+//backend is deferred, every chunk is packed again without GL, and is packed and uploaded again when
+//it stops being deferred, as the buffers were not kept up to date in between.
+	void StaticLayerCache::_Render(const AABB2D* view)
+	{
+		_drawCount = 0;
+		_culledCount = 0;
+
+		bool deferred = Renderer::Instance()->GetBackend()->v_IsDeferred();
+
+		if(deferred != _deferred)
+		{
+			MarkAllDirty();
+			_deferred = deferred;
+		}
+
+		for(auto i = _chunks.begin(); i != _chunks.end(); )
+		{
+			auto current = i++;
+			StaticChunk& chunk = current->second;
+
+			//=====Left by a Remove while the backend was deferred=====
+			if(_EraseIfEmpty(current, deferred)) { continue; }
+
+			if(chunk.dirty) { _Rebuild(chunk, !deferred); }
+
+			if(view != NULL && !chunk.bounds.Overlaps(*view))
+			{
+				++_culledCount;
+				continue;
+			}
+
+			for(U32 b = 0; b < chunk.batches.size(); ++b)
+			{
+				StaticBatch& batch = chunk.batches[b];
+
+				if(batch.count == 0) { continue; }
+
+				if(deferred) { Renderer::Instance()->AddToBatch(batch.shader, batch.textureID, &chunk.vertices[batch.first], batch.count); }
+				else { Renderer::Instance()->DrawStatic(batch.shader, batch.textureID, batch.vertexArray, batch.count); }
+
+				++_drawCount;
+			}
+		}
+	}
+
+	U64 StaticLayerCache::_ChunkKey(GameObject2D* obj) const
+	{
+		const Vec2& pos = obj->GetPosition();
+
+		S32 x = (S32)std::floor(pos.GetX() / _chunkSize);
+		S32 y = (S32)std::floor(pos.GetY() / _chunkSize);
+
+		return ((U64)(U32)x << 32) | (U64)(U32)y;
+	}
+
+//With upload false nothing is sent to the GPU, the vertices are only packed into the chunk.
+	void StaticLayerCache::_Rebuild(StaticChunk& chunk, bool upload)
+	{
+		//=====Group the objects by shader, then texture=====
+		_sorted = chunk.objects;
+
+		std::sort(_sorted.begin(), _sorted.end(), [](GameObject2D* a, GameObject2D* b)
+		{
+			GLuint shaderA = a->GetSprite()->v_GetShader();
+			GLuint shaderB = b->GetSprite()->v_GetShader();
+
+			if(shaderA != shaderB) { return shaderA < shaderB; }
+
+			return a->GetTextureID() < b->GetTextureID();
+		});
+
+		U32 batchCount = 0;
+		U32 start = 0;
+
+		if(!_sorted.empty()) { chunk.bounds = _Bounds(_sorted[0]); }
+
+		for(U32 i = 1; i < _sorted.size(); ++i)
+		{
+			AABB2D bounds = _Bounds(_sorted[i]);
+
+			if(bounds.minX < chunk.bounds.minX) { chunk.bounds.minX = bounds.minX; }
+			if(bounds.minY < chunk.bounds.minY) { chunk.bounds.minY = bounds.minY; }
+			if(bounds.maxX > chunk.bounds.maxX) { chunk.bounds.maxX = bounds.maxX; }
+			if(bounds.maxY > chunk.bounds.maxY) { chunk.bounds.maxY = bounds.maxY; }
+		}
+
+		chunk.vertices.clear();
+
+		while(start < _sorted.size())
+		{
+			GLuint shader = _sorted[start]->GetSprite()->v_GetShader();
+			U32 textureID = _sorted[start]->GetTextureID();
+
+			U32 end = start;
+			while(end < _sorted.size() && _sorted[end]->GetSprite()->v_GetShader() == shader && _sorted[end]->GetTextureID() == textureID)
+			{
+				Sprite* sprite = _sorted[end]->GetSprite();
+				Vec2& pos = sprite->GetPosition();
+				Col& col = sprite->GetColor();
+				Vec2& bottomTop = sprite->GetUVBottomTop();
+				Vec2& leftRight = sprite->GetUVLeftRight();
+
+				chunk.vertices.push_back(SpriteVertex::Pack(pos.GetX(), pos.GetY(), pos.GetZ(),
+														 col.GetRed(), col.GetGreen(), col.GetBlue(), col.GetAlpha(),
+														 sprite->GetWidth() / 2, sprite->GetHeight() / 2,
+														 bottomTop.GetX(), bottomTop.GetY(), leftRight.GetX(), leftRight.GetY()));
+				++end;
+			}
+
+			//=====Reuse the GPU buffer from the last recording if there is one=====
+			if(batchCount == chunk.batches.size())
+			{
+				StaticBatch batch;
+				batch.vertexArray = 0;
+				batch.buffer = 0;
+				batch.capacity = 0;
+				chunk.batches.push_back(batch);
+			}
+
+			StaticBatch& batch = chunk.batches[batchCount];
+
+			if(upload && batch.vertexArray == 0) { _CreateBatch(batch); }
+
+			batch.shader = shader;
+			batch.textureID = textureID;
+			batch.first = start;
+			batch.count = end - start;
+
+			if(upload)
+			{
+				glBindBuffer(GL_ARRAY_BUFFER, batch.buffer);
+
+				if(batch.count > batch.capacity)
+				{
+					glBufferData(GL_ARRAY_BUFFER, sizeof(SpriteVertex) * batch.count, &chunk.vertices[start], GL_STATIC_DRAW);
+					batch.capacity = batch.count;
+				}
+				else
+				{
+					glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(SpriteVertex) * batch.count, &chunk.vertices[start]);
+				}
+			}
+
+			++batchCount;
+			start = end;
+		}
+
+		if(upload)
+		{
+			//=====Free the buffers that are no longer needed=====
+			for(U32 b = batchCount; b < chunk.batches.size(); ++b)
+			{
+				_DeleteBatch(chunk.batches[b]);
+			}
+
+			chunk.batches.resize(batchCount);
+		}
+		else
+		{
+			//=====They cannot be freed without GL, so they are left empty until the next upload=====
+			for(U32 b = batchCount; b < chunk.batches.size(); ++b)
+			{
+				chunk.batches[b].count = 0;
+			}
+		}
+
+		chunk.dirty = false;
+		++_rebuildCount;
+	}
+
+//While the backend is deferred a chunk with buffers on the GPU is kept, as they cannot be freed
+//without GL, and _Render erases it once it can.
+	bool StaticLayerCache::_EraseIfEmpty(std::map<U64, StaticChunk>::iterator chunk, bool deferred)
+	{
+		if(!chunk->second.objects.empty()) { return false; }
+
+		std::vector<StaticBatch>& batches = chunk->second.batches;
+
+		for(U32 b = 0; b < batches.size(); ++b)
+		{
+			if(deferred && batches[b].vertexArray != 0) { return false; }
+		}
+
+		for(U32 b = 0; b < batches.size(); ++b)
+		{
+			if(batches[b].vertexArray != 0) { _DeleteBatch(batches[b]); }
+		}
+
+		_chunks.erase(chunk);
+
+		return true;
+	}
+
+	void StaticLayerCache::_CreateBatch(StaticBatch& batch)
+	{
+		batch.capacity = 0;
+
+		glGenVertexArrays(1, &batch.vertexArray);
+		glGenBuffers(1, &batch.buffer);
+
+		glBindVertexArray(batch.vertexArray);
+		glBindBuffer(GL_ARRAY_BUFFER, batch.buffer);
+
+		SpriteVertex::SetAttributes(0);
+
+		Renderer::Instance()->BindDefaultVertexArray();
+	}
+
+	void StaticLayerCache::_DeleteBatch(StaticBatch& batch)
+	{
+		glDeleteBuffers(1, &batch.buffer);
+		GLStateCache::Instance()->ForgetVertexArray(batch.vertexArray);
+		glDeleteVertexArrays(1, &batch.vertexArray);
+		batch.buffer = 0;
+		batch.vertexArray = 0;
+	}
+}//End namespace
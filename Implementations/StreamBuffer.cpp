@@ -0,0 +1,210 @@
+#include <Engine/StreamBuffer.h>
+
+namespace KillerEngine
+{
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+	StreamBuffer::StreamBuffer(void) : _target(GL_ARRAY_BUFFER), 
+									   _buffer(0), 
+									   _mapped(NULL), 
+									   _regionSize(0), 
+									   _region(0), 
+									   _cursor(0), 
+									   _persistent(false),
+									   _allowPersistent(true),
+									   _rangeMapped(false),
+									   _fences(), 
+									   _stats()
+	{
+		ResetStats();
+	}
+
+	StreamBuffer::~StreamBuffer(void)
+	{
+		ShutDown();
+	}
+
+//==========================================================================================================================
+//
+//StreamBuffer Functions
+//
+//==========================================================================================================================
+	bool StreamBuffer::Init(GLenum target, U32 regionSize, U32 regionCount)
+	{
+		ShutDown();
+
+		if(regionSize == 0 || regionCount == 0)
+		{
+			ErrorManager::Instance()->SetError(EC_OpenGL, "StreamBuffer -> Init called with an empty region size or count.");
+			return false;
+		}
+
+		_target = target;
+		_regionSize = regionSize;
+		_region = 0;
+		_cursor = 0;
+		_fences.assign(regionCount, (GLsync)NULL);
+
+		GLsizeiptr size = (GLsizeiptr)regionSize * regionCount;
+
+		glGenBuffers(1, &_buffer);
+		glBindBuffer(_target, _buffer);
+
+		_persistent = _allowPersistent && glBufferStorage != NULL;
+
+		if(_persistent)
+		{
+			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+			glBufferStorage(_target, size, NULL, flags);
+			_mapped = static_cast<U8*>(glMapBufferRange(_target, 0, size, flags));
+
+			if(_mapped == NULL)
+			{
+				//=====Storage is immutable, so start over with a plain buffer=====
+				glDeleteBuffers(1, &_buffer);
+				glGenBuffers(1, &_buffer);
+				glBindBuffer(_target, _buffer);
+				_persistent = false;
+			}
+		}
+
+		if(!_persistent)
+		{
+			glBufferData(_target, size, NULL, GL_STREAM_DRAW);
+		}
+
+		return true;
+	}
+
+	void StreamBuffer::ShutDown(void)
+	{
+		if(_buffer == 0) { return; }
+
+		for(U32 i = 0; i < _fences.size(); ++i)
+		{
+			if(_fences[i] != NULL) { glDeleteSync(_fences[i]); }
+		}
+
+		_fences.clear();
+
+		glBindBuffer(_target, _buffer);
+
+		if(_persistent || _rangeMapped) { glUnmapBuffer(_target); }
+
+		glDeleteBuffers(1, &_buffer);
+
+		_buffer = 0;
+		_mapped = NULL;
+		_rangeMapped = false;
+	}
+
+	//=====Returns a pointer to bytes of write only memory, and where they start in the buffer=====
+	void* StreamBuffer::Reserve(U32 bytes, U32& offset)
+	{
+		if(_buffer == 0 || bytes > _regionSize)
+		{
+			ErrorManager::Instance()->SetError(EC_OpenGL, "StreamBuffer -> Reserve is larger than a region, or the buffer was never made.");
+			return NULL;
+		}
+
+		if(_rangeMapped) { Commit(); }
+
+		if(_cursor + bytes > _regionSize) { _NextRegion(); }
+
+		offset = _region * _regionSize + _cursor;
+		_cursor += bytes;
+
+		++_stats.reserves;
+		_stats.bytesWritten += bytes;
+
+		if(_persistent) { return _mapped + offset; }
+
+		glBindBuffer(_target, _buffer);
+
+		void* range = glMapBufferRange(_target, offset, bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+		_rangeMapped = range != NULL;
+
+		return range;
+	}
+
+	void StreamBuffer::Commit(void)
+	{
+		if(!_rangeMapped) { return; }
+
+		glBindBuffer(_target, _buffer);
+		glUnmapBuffer(_target);
+		_rangeMapped = false;
+	}
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+	void StreamBuffer::ResetStats(void)
+	{
+		_stats.bytesWritten = 0;
+		_stats.reserves = 0;
+		_stats.regionSwitches = 0;
+		_stats.fenceWaits = 0;
+		_stats.orphans = 0;
+	}
+
+//==========================================================================================================================
+//
+//Private Functions
+//
+//==========================================================================================================================
+	void StreamBuffer::_NextRegion(void)
+	{
+		++_stats.regionSwitches;
+
+		if(_persistent)
+		{
+			//=====Everything drawn from this region so far is behind this fence=====
+			if(_fences[_region] != NULL) { glDeleteSync(_fences[_region]); }
+			_fences[_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		}
+
+		_region = (_region + 1) % (U32)_fences.size();
+		_cursor = 0;
+
+		if(_persistent) 
+		{ 
+			_WaitForRegion(_region); 
+		}
+		else if(_region == 0)
+		{
+			//=====Orphan the storage, the driver keeps the old copy alive until the GPU is done with it=====
+			glBindBuffer(_target, _buffer);
+			glBufferData(_target, (GLsizeiptr)_regionSize * _fences.size(), NULL, GL_STREAM_DRAW);
+			++_stats.orphans;
+		}
+	}
+
+	void StreamBuffer::_WaitForRegion(U32 region)
+	{
+		GLsync fence = _fences[region];
+
+		if(fence == NULL) { return; }
+
+		GLenum result = glClientWaitSync(fence, 0, 0);
+
+		if(result == GL_TIMEOUT_EXPIRED)
+		{
+			++_stats.fenceWaits;
+
+			do
+			{
+				result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+			} while(result == GL_TIMEOUT_EXPIRED);
+		}
+
+		glDeleteSync(fence);
+		_fences[region] = NULL;
+	}
+}//End namespace
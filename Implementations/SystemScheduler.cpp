@@ -0,0 +1,116 @@
+#include <Engine/SystemScheduler.h>
+
+namespace KillerEngine
+{
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+	SystemScheduler::SystemScheduler(void) : _systems(), _stages(), _chunks(), _dirty(false)
+	{  }
+
+//==========================================================================================================================
+//
+//SystemScheduler Functions
+//
+//==========================================================================================================================
+	void SystemScheduler::AddSystem(EntitySystem* system)
+	{
+		_systems.push_back(system);
+		_dirty = true;
+	}
+
+	void SystemScheduler::RemoveSystem(EntitySystem* system)
+	{
+		for(auto i = _systems.begin(); i != _systems.end(); ++i)
+		{
+			if(*i == system)
+			{
+				_systems.erase(i);
+				_dirty = true;
+				return;
+			}
+		}
+	}
+
+	void SystemScheduler::Run(EntityManager& entities, F32 delta)
+	{
+		if(_dirty) { _BuildStages(); }
+
+		for(U32 s = 0; s < _stages.size(); ++s)
+		{
+			std::vector<EntitySystem*>& stage = _stages[s];
+			JobGroup group;
+
+			//=====Hand the worker chunks out first=====
+			for(U32 i = 0; i < stage.size(); ++i)
+			{
+				EntitySystem* system = stage[i];
+				system->v_BeginUpdate(delta);
+
+				if(system->GetMainThreadOnly()) { continue; }
+
+				U32 first = (U32)_chunks.size();
+				entities.GetMatchingChunks(system->GetRequired(), _chunks);
+
+				for(U32 c = first; c < _chunks.size(); ++c)
+				{
+					ChunkRef chunk = _chunks[c];
+					JobPool::Instance()->Submit(group, [system, chunk]() mutable { system->v_UpdateChunk(chunk); });
+				}
+			}
+
+			//=====Then run the main thread systems here=====
+			for(U32 i = 0; i < stage.size(); ++i)
+			{
+				EntitySystem* system = stage[i];
+
+				if(!system->GetMainThreadOnly()) { continue; }
+
+				entities.ForEachChunk(system->GetRequired(), [system](ChunkRef& chunk) { system->v_UpdateChunk(chunk); });
+			}
+
+			JobPool::Instance()->Wait(group);
+			_chunks.clear();
+		}
+	}
+
+	U32 SystemScheduler::GetStageCount(void)
+	{
+		if(_dirty) { _BuildStages(); }
+
+		return (U32)_stages.size();
+	}
+
+//==========================================================================================================================
+//
+//Private Functions
+//
+//==========================================================================================================================
+	void SystemScheduler::_BuildStages(void)
+	{
+		_stages.clear();
+		std::vector<U32> stageOf(_systems.size(), 0);
+
+		for(U32 i = 0; i < _systems.size(); ++i)
+		{
+			U32 stage = 0;
+
+			for(U32 j = 0; j < i; ++j)
+			{
+				if(_systems[i]->ConflictsWith(*_systems[j]) && stageOf[j] + 1 > stage)
+				{
+					stage = stageOf[j] + 1;
+				}
+			}
+
+			stageOf[i] = stage;
+
+			if(stage >= _stages.size()) { _stages.resize(stage + 1); }
+			_stages[stage].push_back(_systems[i]);
+		}
+
+		_dirty = false;
+	}
+}//End namespace
@@ -0,0 +1,385 @@
+#include <Engine/TextureAtlas.h>
+
+namespace KillerEngine
+{
+//==========================================================================================================================
+//
+//Singleton Functions
+//
+//==========================================================================================================================
+	TextureAtlas* TextureAtlas::_instance = NULL;
+
+	TextureAtlas* TextureAtlas::Instance(void)
+	{
+		if(_instance == NULL) { _instance = new TextureAtlas(); }
+		return _instance;
+	}
+
+//==========================================================================================================================
+//
+//TextureAtlas Functions
+//
+//==========================================================================================================================
+	void TextureAtlas::AddImage(U32 textureID, string path, bool repeats)
+	{
+		if(repeats || Contains(textureID)) { return; }
+
+		for(U32 i = 0; i < _pending.size(); ++i)
+		{
+			if(_pending[i].textureID == textureID) { return; }
+		}
+
+		PendingImage image;
+		image.textureID = textureID;
+		image.path = path;
+		image.pixels = NULL;
+		image.width = 0;
+		image.height = 0;
+
+		_pending.push_back(image);
+	}
+
+	bool TextureAtlas::Build(bool upload)
+	{
+		if(_pending.empty()) { return true; }
+
+		//=====Loading the images is most of the work, and each one is on its own=====
+		std::vector<PendingImage>& pending = _pending;
+
+		JobPool::Instance()->ParallelFor((U32)pending.size(), 1, [&pending](U32 begin, U32 end)
+		{
+			for(U32 i = begin; i < end; ++i)
+			{
+				pending[i].pixels = SOIL_load_image(pending[i].path.c_str(), &pending[i].width, &pending[i].height, 0, SOIL_LOAD_RGBA);
+			}
+		});
+
+		std::sort(_pending.begin(), _pending.end(), [](const PendingImage& a, const PendingImage& b)
+		{
+			if(a.height != b.height) { return a.height > b.height; }
+			if(a.width != b.width) { return a.width > b.width; }
+			return a.textureID < b.textureID;
+		});
+
+		bool placedAll = true;
+
+		for(U32 i = 0; i < _pending.size(); ++i)
+		{
+			PendingImage& image = _pending[i];
+
+			if(image.pixels == NULL)
+			{
+				ErrorManager::Instance()->SetError(EC_TextureManager, "TextureAtlas -> Unable to load image " + image.path);
+				placedAll = false;
+				continue;
+			}
+
+			AtlasRegion region;
+
+			if(_Place(image, region))
+			{
+				_Blit(region, image.pixels);
+				_regions.insert(std::map<U32, AtlasRegion>::value_type(image.textureID, region));
+			}
+			else
+			{
+				ErrorManager::Instance()->SetError(EC_TextureManager, "TextureAtlas -> Image is larger than an atlas page " + image.path);
+				placedAll = false;
+			}
+
+			SOIL_free_image_data(image.pixels);
+		}
+
+		_pending.clear();
+
+		if(upload) { _Upload(); }
+
+		return placedAll;
+	}
+
+	bool TextureAtlas::Remap(U32& textureID, F32& bottom, F32& top, F32& left, F32& right) const
+	{
+		auto found = _regions.find(textureID);
+
+		if(found == _regions.end()) { return false; }
+
+		const AtlasRegion& region = found->second;
+
+		bottom = region.v0 + bottom * (region.v1 - region.v0);
+		top = region.v0 + top * (region.v1 - region.v0);
+		left = region.u0 + left * (region.u1 - region.u0);
+		right = region.u0 + right * (region.u1 - region.u0);
+		textureID = GetPageTextureID(region.page);
+
+		return true;
+	}
+
+	//=====Only works when the new image is the same size as the old one=====
+	bool TextureAtlas::UpdateImage(U32 textureID, string path)
+	{
+		auto found = _regions.find(textureID);
+
+		if(found == _regions.end()) { return false; }
+
+		S32 width;
+		S32 height;
+		U8* pixels = SOIL_load_image(path.c_str(), &width, &height, 0, SOIL_LOAD_RGBA);
+
+		if(pixels == NULL) 
+		{
+			ErrorManager::Instance()->SetError(EC_TextureManager, "TextureAtlas -> Unable to load image " + path);
+			return false; 
+		}
+
+		bool sameSize = (U32)width == found->second.width && (U32)height == found->second.height;
+
+		if(sameSize)
+		{
+			_Blit(found->second, pixels);
+			_Upload();
+		}
+
+		SOIL_free_image_data(pixels);
+
+		return sameSize;
+	}
+
+	void TextureAtlas::Remove(U32 textureID)
+	{
+		_regions.erase(textureID);
+	}
+
+	bool TextureAtlas::SaveBake(string path) const
+	{
+		std::ofstream file(path.c_str());
+
+		if(!file.is_open())
+		{
+			ErrorManager::Instance()->SetError(EC_TextureManager, "TextureAtlas -> Unable to open " + path + " to save the bake.");
+			return false;
+		}
+
+		file << "KillerAtlas 1\n";
+		file << "pages " << _pages.size() << "\n";
+
+		for(U32 i = 0; i < _pages.size(); ++i)
+		{
+			std::ostringstream name;
+			name << path << "." << i << ".tga";
+
+			const AtlasPage& page = _pages[i];
+
+			if(!SOIL_save_image(name.str().c_str(), SOIL_SAVE_TYPE_TGA, page.width, page.height, 4, &page.pixels[0]))
+			{
+				ErrorManager::Instance()->SetError(EC_TextureManager, "TextureAtlas -> Unable to save atlas page " + name.str());
+				return false;
+			}
+
+			file << "page " << i << " " << page.width << " " << page.height << " " << name.str() << "\n";
+		}
+
+		for(auto i = _regions.begin(); i != _regions.end(); ++i)
+		{
+			const AtlasRegion& region = i->second;
+			file << "region " << i->first << " " << region.page << " " << region.x << " " << region.y << " " 
+				 << region.width << " " << region.height << "\n";
+		}
+
+		return true;
+	}
+
+	bool TextureAtlas::LoadBake(string path, bool upload)
+	{
+		std::ifstream file(path.c_str());
+
+		if(!file.is_open())
+		{
+			ErrorManager::Instance()->SetError(EC_TextureManager, "TextureAtlas -> Unable to open atlas bake " + path);
+			return false;
+		}
+
+		string word;
+		U32 version = 0;
+		U32 pageCount = 0;
+		file >> word >> version;
+
+		if(word != "KillerAtlas" || version != 1)
+		{
+			ErrorManager::Instance()->SetError(EC_TextureManager, "TextureAtlas -> Not an atlas bake " + path);
+			return false;
+		}
+
+		file >> word >> pageCount;
+
+		U32 firstPage = (U32)_pages.size();
+
+		while(file >> word)
+		{
+			if(word == "page")
+			{
+				U32 index;
+				AtlasPage page;
+				string pageFile;
+				file >> index >> page.width >> page.height;
+				std::getline(file >> std::ws, pageFile);
+
+				S32 width;
+				S32 height;
+				U8* pixels = SOIL_load_image(pageFile.c_str(), &width, &height, 0, SOIL_LOAD_RGBA);
+
+				if(pixels == NULL || (U32)width != page.width || (U32)height != page.height)
+				{
+					if(pixels != NULL) { SOIL_free_image_data(pixels); }
+					ErrorManager::Instance()->SetError(EC_TextureManager, "TextureAtlas -> Unable to load atlas page " + pageFile);
+					return false;
+				}
+
+				page.pixels.assign(pixels, pixels + page.width * page.height * 4);
+				SOIL_free_image_data(pixels);
+
+				//=====The free space of a baked page is not known, so nothing more is put on it=====
+				page.packer.Init(0, 0);
+				page.dirty = true;
+
+				_pages.push_back(page);
+			}
+			else if(word == "region")
+			{
+				U32 textureID;
+				AtlasRegion region;
+				file >> textureID >> region.page >> region.x >> region.y >> region.width >> region.height;
+
+				region.page += firstPage;
+
+				if(region.page >= _pages.size()) { continue; }
+
+				_SetUVs(region);
+				_regions[textureID] = region;
+			}
+		}
+
+		if(upload) { _Upload(); }
+
+		return true;
+	}
+
+//==========================================================================================================================
+//
+//Accessors
+//
+//==========================================================================================================================
+	const AtlasRegion* TextureAtlas::GetRegion(U32 textureID) const
+	{
+		auto found = _regions.find(textureID);
+
+		return found == _regions.end() ? NULL : &found->second;
+	}
+
+//==========================================================================================================================
+//
+//Constructor
+//
+//==========================================================================================================================
+	TextureAtlas::TextureAtlas(void) : _regions(), _pages(), _pending(), _pageSize(2048), _padding(2), _firstPageID(0x40000000)
+	{  }
+
+//==========================================================================================================================
+//
+//Private Functions
+//
+//==========================================================================================================================
+	bool TextureAtlas::_Place(PendingImage& image, AtlasRegion& region)
+	{
+		U32 width = (U32)image.width + _padding * 2;
+		U32 height = (U32)image.height + _padding * 2;
+		U32 x;
+		U32 y;
+
+		if(width > _pageSize || height > _pageSize) { return false; }
+
+		U32 page = 0;
+
+		while(page < _pages.size() && !_pages[page].packer.Insert(width, height, x, y)) { ++page; }
+
+		if(page == _pages.size())
+		{
+			_pages.push_back(AtlasPage());
+
+			AtlasPage& added = _pages.back();
+			added.width = _pageSize;
+			added.height = _pageSize;
+			added.packer.Init(_pageSize, _pageSize);
+			added.pixels.assign(_pageSize * _pageSize * 4, 0);
+			added.dirty = true;
+
+			added.packer.Insert(width, height, x, y);
+		}
+
+		region.page = page;
+		region.x = x + _padding;
+		region.y = y + _padding;
+		region.width = (U32)image.width;
+		region.height = (U32)image.height;
+		_SetUVs(region);
+
+		return true;
+	}
+
+	//=====Copies the image in, and stretches its outside pixels across the padding=====
+	void TextureAtlas::_Blit(const AtlasRegion& region, const U8* pixels)
+	{
+		AtlasPage& page = _pages[region.page];
+		S32 pad = (S32)_padding;
+		S32 width = (S32)region.width;
+		S32 height = (S32)region.height;
+
+		for(S32 row = -pad; row < height + pad; ++row)
+		{
+			S32 sourceRow = std::min(std::max(row, 0), height - 1);
+			S32 pageRow = (S32)region.y + row;
+
+			if(pageRow < 0 || pageRow >= (S32)page.height) { continue; }
+
+			for(S32 column = -pad; column < width + pad; ++column)
+			{
+				S32 sourceColumn = std::min(std::max(column, 0), width - 1);
+				S32 pageColumn = (S32)region.x + column;
+
+				if(pageColumn < 0 || pageColumn >= (S32)page.width) { continue; }
+
+				const U8* source = pixels + (sourceRow * width + sourceColumn) * 4;
+				U8* dest = &page.pixels[(pageRow * page.width + pageColumn) * 4];
+
+				dest[0] = source[0];
+				dest[1] = source[1];
+				dest[2] = source[2];
+				dest[3] = source[3];
+			}
+		}
+
+		page.dirty = true;
+	}
+
+	void TextureAtlas::_SetUVs(AtlasRegion& region)
+	{
+		const AtlasPage& page = _pages[region.page];
+
+		region.u0 = (F32)region.x / page.width;
+		region.u1 = (F32)(region.x + region.width) / page.width;
+		region.v0 = (F32)region.y / page.height;
+		region.v1 = (F32)(region.y + region.height) / page.height;
+	}
+
+	void TextureAtlas::_Upload(void)
+	{
+		for(U32 i = 0; i < _pages.size(); ++i)
+		{
+			AtlasPage& page = _pages[i];
+
+			if(!page.dirty) { continue; }
+
+			TextureManager::Instance()->LoadTextureFromMemory(GetPageTextureID(i), &page.pixels[0], page.width, page.height, TS_CLAMPED);
+			page.dirty = false;
+		}
+	}
+}//End namespace
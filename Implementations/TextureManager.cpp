@@ -28,6 +28,9 @@ namespace KillerEngine
 			GLuint texture = i->second.GetID();
 			glDeleteTextures(1, &texture);
 		}
+
+		_currentGLTexture = 0;
+		GLStateCache::Instance()->Invalidate();
 	}
 
 //==========================================================================================================================
@@ -35,11 +38,22 @@ namespace KillerEngine
 //Accessors
 //
 //==========================================================================================================================
+//The map is only searched when the id changes, and the GLStateCache skips the bind when the id
+//changed but the OGL texture did not, as with two regions of one atlas page.
 	void TextureManager::SetCurrentTextureID(U32 tID)
 	{ 
+		if(tID == _currentTextureID && _currentGLTexture != 0) 
+		{
+			GLStateCache::Instance()->BindTexture(_currentGLTexture);
+			return;
+		}
+
+		auto found = _loadedTextures.find(tID);
+
 		_currentTextureID = tID; 
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, _loadedTextures[tID].GetID());
+		_currentGLTexture = found == _loadedTextures.end() ? 0 : found->second.GetID();
+
+		GLStateCache::Instance()->BindTexture(_currentGLTexture);
 	}
 
 //====================================================================================================
@@ -67,7 +81,7 @@ namespace KillerEngine
 		{
 			GLuint glTexture;
 			glGenTextures(1, &glTexture);
-			glBindTexture(GL_TEXTURE_2D, glTexture);
+			GLStateCache::Instance()->BindTexture(glTexture);
 
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
 			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
@@ -90,9 +104,98 @@ namespace KillerEngine
 			_loadedTextures.insert(std::map<U32, Texture*>::value_type(id, newTexture));
 
 			SOIL_free_image_data(image);
-			glBindTexture(GL_TEXTURE_2D, 0);
+			GLStateCache::Instance()->BindTexture(_currentGLTexture);
 
 		}
 	}
 
+//=====================================================================================================
+//ReloadTexture
+//=====================================================================================================
+//Loads the image again into the texture that already has this id. The OGL texture is kept, so
+//anything that was holding on to the id, or the OGL name, sees the new image.
+	void TextureManager::ReloadTexture(string path, U32 id, S32 width, S32 height)
+	{
+		auto found = _loadedTextures.find(id);
+
+		if(found == _loadedTextures.end())
+		{
+			LoadTexture(path, id, width, height);
+			return;
+		}
+
+		unsigned char* image = SOIL_load_image(path.c_str(), &width, &height, 0, SOIL_LOAD_RGBA);
+
+		if(image == 0) 
+		{
+			string errorMessage = string("SOIL_load_image failed to reload image: ") + path;
+			ErrorManager::Instance()->SetError(EC_TextureManager, errorMessage);
+			return;
+		}
+
+		GLStateCache::Instance()->BindTexture(found->second.GetID());
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
+		glGenerateMipmap(GL_TEXTURE_2D);
+
+		found->second.SetWidth(width);
+		found->second.SetHeight(height);
+
+		SOIL_free_image_data(image);
+
+		//=====Put back whatever the Renderer had bound=====
+		GLStateCache::Instance()->BindTexture(_currentGLTexture);
+	}
+
+//=====================================================================================================
+//LoadTextureFromMemory
+//=====================================================================================================
+//Makes a texture from RGBA pixels that are already in memory, such as an atlas page. If the id is
+//already loaded the image is replaced in the same OGL texture. The sampling is set on every upload.
+	void TextureManager::LoadTextureFromMemory(U32 id, const U8* pixels, S32 width, S32 height, TextureSampling sampling)
+	{
+		auto found = _loadedTextures.find(id);
+		GLuint glTexture;
+
+		if(found == _loadedTextures.end())
+		{
+			glGenTextures(1, &glTexture);
+			GLStateCache::Instance()->BindTexture(glTexture);
+
+			_loadedTextures.insert(std::map<U32, Texture>::value_type(id, Texture(glTexture, width, height)));
+		}
+		else
+		{
+			glTexture = found->second.GetID();
+			GLStateCache::Instance()->BindTexture(glTexture);
+
+			found->second.SetWidth(width);
+			found->second.SetHeight(height);
+		}
+
+		if(sampling == TS_CLAMPED)
+		{
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+		}
+		else
+		{
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+			//=====1000 is the GL default=====
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 1000);
+		}
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+
+		if(sampling != TS_CLAMPED) { glGenerateMipmap(GL_TEXTURE_2D); }
+
+		//=====Put back whatever the Renderer had bound=====
+		GLStateCache::Instance()->BindTexture(_currentGLTexture);
+	}
+
 }//End namespace
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include <Engine/TileCollisionLayer.h>
+
+namespace KillerEngine
+{
+	//=====Bits from the low bit of a word up to and including bit=====
+	static inline U64 MaskTo(U32 bit)
+	{
+		return bit >= 63 ? ~U64(0) : (U64(1) << (bit + 1)) - 1;
+	}
+
+	//=====Bits from bit up to the high bit of a word=====
+	static inline U64 MaskFrom(U32 bit)
+	{
+		return ~U64(0) << bit;
+	}
+
+	static inline U32 PopCount(U64 bits)
+	{
+		return (U32)std::bitset<64>(bits).count();
+	}
+
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+	TileCollisionLayer::TileCollisionLayer(void) : _width(0), 
+												   _height(0), 
+												   _wordsPerRow(0), 
+												   _tileWidth(1.0f), 
+												   _tileHeight(1.0f), 
+												   _originX(0.0f), 
+												   _originY(0.0f),
+												   _version(0)
+	{  }
+
+//==========================================================================================================================
+//
+//TileCollisionLayer Functions
+//
+//==========================================================================================================================
+	void TileCollisionLayer::Init(U32 width, U32 height, F32 tileWidth, F32 tileHeight)
+	{
+		if(tileWidth <= 0.0f || tileHeight <= 0.0f)
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "TileCollisionLayer -> Tile size must be greater than 0.");
+			return;
+		}
+
+		_width = width;
+		_height = height;
+		_wordsPerRow = (width + 63) / 64;
+		_tileWidth = tileWidth;
+		_tileHeight = tileHeight;
+
+		for(U32 p = 0; p < 3; ++p)
+		{
+			_planes[p].assign(_wordsPerRow * _height, 0);
+		}
+
+		++_version;
+	}
+
+	void TileCollisionLayer::Clear(void)
+	{
+		for(U32 p = 0; p < 3; ++p)
+		{
+			_planes[p].assign(_planes[p].size(), 0);
+		}
+
+		++_version;
+	}
+
+	void TileCollisionLayer::SetTile(U32 x, U32 y, U8 flags)
+	{
+		if(x >= _width || y >= _height)
+		{
+			ErrorManager::Instance()->SetError(EC_KillerEngine, "TileCollisionLayer -> Tile is outside of the layer.");
+			return;
+		}
+
+		U32 word = y * _wordsPerRow + (x >> 6);
+		U64 bit = U64(1) << (x & 63);
+
+		for(U32 p = 0; p < 3; ++p)
+		{
+			if(flags & (1 << p)) { _planes[p][word] |= bit; }
+			else { _planes[p][word] &= ~bit; }
+		}
+
+		++_version;
+	}
+
+	U8 TileCollisionLayer::GetTile(U32 x, U32 y) const
+	{
+		if(x >= _width || y >= _height) { return TC_NONE; }
+
+		U32 word = y * _wordsPerRow + (x >> 6);
+		U32 shift = x & 63;
+
+		return (U8)(((_planes[0][word] >> shift) & 1) | 
+					(((_planes[1][word] >> shift) & 1) << 1) | 
+					(((_planes[2][word] >> shift) & 1) << 2));
+	}
+
+	bool TileCollisionLayer::AnyInSpan(U8 flags, U32 y, S32 x0, S32 x1) const
+	{
+		if(y >= _height || !_ClampSpan(x0, x1)) { return false; }
+
+		U32 row = y * _wordsPerRow;
+		U32 first = (U32)x0 >> 6;
+		U32 last = (U32)x1 >> 6;
+
+		if(first == last)
+		{
+			return (_RowWord(flags, row + first) & MaskFrom(x0 & 63) & MaskTo(x1 & 63)) != 0;
+		}
+
+		if(_RowWord(flags, row + first) & MaskFrom(x0 & 63)) { return true; }
+
+		for(U32 w = first + 1; w < last; ++w)
+		{
+			if(_RowWord(flags, row + w)) { return true; }
+		}
+
+		return (_RowWord(flags, row + last) & MaskTo(x1 & 63)) != 0;
+	}
+
+	bool TileCollisionLayer::AnyInRect(U8 flags, S32 x0, S32 y0, S32 x1, S32 y1) const
+	{
+		if(y0 < 0) { y0 = 0; }
+		if(y1 >= (S32)_height) { y1 = (S32)_height - 1; }
+
+		for(S32 y = y0; y <= y1; ++y)
+		{
+			if(AnyInSpan(flags, (U32)y, x0, x1)) { return true; }
+		}
+
+		return false;
+	}
+
+	U32 TileCollisionLayer::CountInSpan(U8 flags, U32 y, S32 x0, S32 x1) const
+	{
+		if(y >= _height || !_ClampSpan(x0, x1)) { return 0; }
+
+		U32 row = y * _wordsPerRow;
+		U32 first = (U32)x0 >> 6;
+		U32 last = (U32)x1 >> 6;
+
+		if(first == last)
+		{
+			return PopCount(_RowWord(flags, row + first) & MaskFrom(x0 & 63) & MaskTo(x1 & 63));
+		}
+
+		U32 count = PopCount(_RowWord(flags, row + first) & MaskFrom(x0 & 63));
+
+		for(U32 w = first + 1; w < last; ++w)
+		{
+			count += PopCount(_RowWord(flags, row + w));
+		}
+
+		return count + PopCount(_RowWord(flags, row + last) & MaskTo(x1 & 63));
+	}
+
+//==========================================================================================================================
+//
+//World Space Queries
+//
+//==========================================================================================================================
+	bool TileCollisionLayer::TestPoint(F32 x, F32 y, U8 flags) const
+	{
+		S32 column = WorldToColumn(x);
+		S32 row = WorldToRow(y);
+
+		if(column < 0 || row < 0) { return false; }
+
+		return Test((U32)column, (U32)row, flags);
+	}
+
+	bool TileCollisionLayer::Overlaps(const AABB2D& rect, U8 flags) const
+	{
+		//=====Half open, the max edge only counts if it is past the start of a tile=====
+		S32 x0 = WorldToColumn(rect.minX);
+		S32 y0 = WorldToRow(rect.minY);
+		S32 x1 = (S32)std::ceil((rect.maxX - _originX) / _tileWidth) - 1;
+		S32 y1 = (S32)std::ceil((rect.maxY - _originY) / _tileHeight) - 1;
+
+		return AnyInRect(flags, x0, y0, x1, y1);
+	}
+
+	bool TileCollisionLayer::ProbeGround(F32 left, F32 right, F32 footY, F32 maxDistance, F32& groundY) const
+	{
+		S32 x0 = WorldToColumn(left);
+		S32 x1 = (S32)std::ceil((right - _originX) / _tileWidth) - 1;
+		S32 top = WorldToRow(footY);
+		S32 bottom = WorldToRow(footY - maxDistance);
+
+		if(top >= (S32)_height) { top = (S32)_height - 1; }
+		if(bottom < 0) { bottom = 0; }
+
+		for(S32 y = top; y >= bottom; --y)
+		{
+			F32 tileTop = (F32)(y + 1) * _tileHeight + _originY;
+
+			//=====One way tiles only hold up feet that are on or above them=====
+			U8 flags = tileTop <= footY ? (TC_SOLID | TC_ONE_WAY) : TC_SOLID;
+
+			if(AnyInSpan(flags, (U32)y, x0, x1))
+			{
+				groundY = tileTop;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+//==========================================================================================================================
+//
+//Private Functions
+//
+//==========================================================================================================================
+	bool TileCollisionLayer::_ClampSpan(S32& x0, S32& x1) const
+	{
+		if(x0 < 0) { x0 = 0; }
+		if(x1 >= (S32)_width) { x1 = (S32)_width - 1; }
+
+		return x0 <= x1;
+	}
+}//End namespace
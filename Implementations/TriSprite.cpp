@@ -34,139 +34,90 @@ namespace KillerEngine
 //==========================================================================================================================
 //Shader
 //==========================================================================================================================	
-	void TriSprite::v_InitShader(void)
+	//=====Vertex Shaders=====
+	//This is used when only colors, not textures are used to render
+	//a pirmitive
+	const GLchar* TriSprite::_vertexShaderSource[] = 
 	{
-		if(_shaderProgram != NULL) return;
+		"#version 430 core																	\n"
 		
-		//=====Vertex Shaders=====
-		//This is used when only colors, not textures are used to render
-		//a pirmitive
-		static const GLchar* _vertexShaderSource[] = 
-		{
-			"#version 430 core																	\n"
-			
-			"layout (location = 0) in vec4 position;											\n"
-			"layout (location = 1) in vec4 color; 												\n"
-			"layout (location = 2) in vec2 dimensions;											\n"
-
-			"uniform mat4 perspective_mat;														\n"
-			"uniform mat4 modelView_mat;														\n"
-			
-			"out vec4 gs_color;																	\n"
-			"out vec4 gs_dimensions;															\n"
-			
-			"void main(void) 																	\n"
-			"{																					\n"
-			"	gl_Position = perspective_mat * modelView_mat * position;						\n"
-			"	gs_color = color;																\n"
-			"	gs_dimensions = perspective_mat * vec4(dimensions.x, dimensions.y, 0.0, 0.0);	\n"
-			"}																					\n"
-		};
-
-
-
-		//=====Geomtry Shader=====
-		static const GLchar* _geometryShaderSource[] =
-		{
-			"#version 430 core 																					\n"
-			
-			"layout(points) in; 																				\n"
-			"layout(triangle_strip, max_vertices = 3) out;														\n"
-			
-			"in vec4 gs_color[]; 																				\n"
-			"in vec4 gs_dimensions[]; 																			\n"
-			
-			"out vec4 fs_color; 																				\n"
-			
-			"void main()																						\n"
-			"{																									\n"
-			"	fs_color = gs_color[0]; 																		\n"
-			//Top
-			"	gl_Position = gl_in[0].gl_Position + vec4(0.0, gs_dimensions[0].y, 0.0, 0.0);					\n"
-			"	EmitVertex(); 																					\n"
-			//Bottom Right
-			"	gl_Position = gl_in[0].gl_Position + vec4(-gs_dimensions[0].x, -gs_dimensions[0].y, 0, 0);		\n"
-			" 	EmitVertex(); 																					\n"
-			//Bottom Left
-			" 	gl_Position = gl_in[0].gl_Position + vec4(gs_dimensions[0].x, -gs_dimensions[0].y, 0.0, 0.0); 	\n"
-			"	EmitVertex();				 																	\n"
-			
-			"	EndPrimitive(); 																				\n"
-			"}																									\n"
-		};
-
+		"layout (location = 0) in vec4 position;											\n"
+		"layout (location = 1) in vec4 color; 												\n"
+		"layout (location = 2) in vec2 dimensions;											\n"
 
-		//=====Fragment Shaders=====
-		//This is used when only colors, not textures are used to render
-		//a pirmitive
-		static const GLchar* _fragmentShaderSource[] = 
-		{
-			"#version 430 core																\n"
-	
-			"in vec4 fs_color;																\n"
-			"out vec4 color;																\n"
-			
-			"void main(void) 																\n"
-			"{																				\n"
-			"	color = fs_color;															\n"
-			"}																				\n"
-		};
-
-
-		//=====Compile Shaders=====
-		GLuint vertexShaderProgram;
-		GLuint geometryShaderProgram;
-		GLuint fragmentShaderProgram;
-
-		vertexShaderProgram = glCreateShader(GL_VERTEX_SHADER);
-		glShaderSource(vertexShaderProgram, 1, _vertexShaderSource, NULL);
-		glCompileShader(vertexShaderProgram);
-
-		geometryShaderProgram = glCreateShader(GL_GEOMETRY_SHADER);
-		glShaderSource(geometryShaderProgram, 1, _geometryShaderSource, NULL);
-		glCompileShader(geometryShaderProgram);
-
-		fragmentShaderProgram = glCreateShader(GL_FRAGMENT_SHADER);
-		glShaderSource(fragmentShaderProgram, 1, _fragmentShaderSource, NULL);
-		glCompileShader(fragmentShaderProgram);
+		"uniform mat4 perspective_mat;														\n"
+		"uniform mat4 modelView_mat;														\n"
+		
+		"out vec4 gs_color;																	\n"
+		"out vec4 gs_dimensions;															\n"
+		
+		"void main(void) 																	\n"
+		"{																					\n"
+		"	gl_Position = perspective_mat * modelView_mat * position;						\n"
+		"	gs_color = color;																\n"
+		"	gs_dimensions = perspective_mat * vec4(dimensions.x, dimensions.y, 0.0, 0.0);	\n"
+		"}																					\n"
+	};
 
-		//=====Link=====
-		_shaderProgram = glCreateProgram();
-		glAttachShader(_shaderProgram, vertexShaderProgram);
-		glAttachShader(_shaderProgram, geometryShaderProgram);
-		glAttachShader(_shaderProgram, fragmentShaderProgram);
-		glLinkProgram(_shaderProgram);
 
-		GLint isLinked = 0;
-		glGetProgramiv(_shaderProgram, GL_LINK_STATUS, &isLinked);
 
-		//=====Error Checking=====
-		if(isLinked == GL_FALSE)
-		{
-			string errorMessage("Compile Error in TriSprite\n");
-			GLint maxLength = 0;
-			glGetProgramiv(_shaderProgram, GL_INFO_LOG_LENGTH, &maxLength);
+	//=====Geomtry Shader=====
+	const GLchar* TriSprite::_geometryShaderSource[] =
+	{
+		"#version 430 core 																					\n"
+		
+		"layout(points) in; 																				\n"
+		"layout(triangle_strip, max_vertices = 3) out;														\n"
+		
+		"in vec4 gs_color[]; 																				\n"
+		"in vec4 gs_dimensions[]; 																			\n"
+		
+		"out vec4 fs_color; 																				\n"
+		
+		"void main()																						\n"
+		"{																									\n"
+		"	fs_color = gs_color[0]; 																		\n"
+		//Top
+		"	gl_Position = gl_in[0].gl_Position + vec4(0.0, gs_dimensions[0].y, 0.0, 0.0);					\n"
+		"	EmitVertex(); 																					\n"
+		//Bottom Right
+		"	gl_Position = gl_in[0].gl_Position + vec4(-gs_dimensions[0].x, -gs_dimensions[0].y, 0, 0);		\n"
+		" 	EmitVertex(); 																					\n"
+		//Bottom Left
+		" 	gl_Position = gl_in[0].gl_Position + vec4(gs_dimensions[0].x, -gs_dimensions[0].y, 0.0, 0.0); 	\n"
+		"	EmitVertex();				 																	\n"
+		
+		"	EndPrimitive(); 																				\n"
+		"}																									\n"
+	};
 
-			//The maxLength includes the NULL character
-			std::vector<GLchar> infoLog(maxLength);
-			glGetProgramInfoLog(_shaderProgram, maxLength, &maxLength, &infoLog[0]);
 
-			for(auto i = infoLog.begin(); i != infoLog.end(); ++i)
-			{
-				errorMessage += *i ;
-			}
+	//=====Fragment Shaders=====
+	//This is used when only colors, not textures are used to render
+	//a pirmitive
+	const GLchar* TriSprite::_fragmentShaderSource[] = 
+	{
+		"#version 430 core																\n"
 
-			ErrorManager::Instance()->SetError(EC_OpenGL_Shader, errorMessage);
+		"in vec4 fs_color;																\n"
+		"out vec4 color;																\n"
+		
+		"void main(void) 																\n"
+		"{																				\n"
+		"	color = fs_color;															\n"
+		"}																				\n"
+	};
 
-			//The program is useless now. So delete it.
-			glDeleteProgram(_shaderProgram);
+	void TriSprite::v_InitShader(void)
+	{
+		if(_shaderProgram != NULL) return;
 
-		}
+		_shaderProgram = ShaderRegistry::Instance()->GetProgram(_vertexShaderSource[0], _geometryShaderSource[0], _fragmentShaderSource[0], "TriSprite");
+	}
 
-		//=====Clean up=====
-		glDeleteShader(vertexShaderProgram);
-		glDeleteShader(geometryShaderProgram);
-		glDeleteShader(fragmentShaderProgram);
+	void TriSprite::RequestShaders(void)
+	{
+		ShaderRegistry::Instance()->Request(_vertexShaderSource[0], _geometryShaderSource[0], _fragmentShaderSource[0], "TriSprite");
 	}
 	
 }//end namespace
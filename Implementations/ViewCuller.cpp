@@ -0,0 +1,82 @@
+#include <Engine/ViewCuller.h>
+
+namespace KillerEngine
+{
+//==========================================================================================================================
+//
+//Constructors
+//
+//==========================================================================================================================
+	ViewCuller::ViewCuller(void) : _minX(), _minY(), _maxX(), _maxY()
+	{  }
+
+//==========================================================================================================================
+//
+//ViewCuller Functions
+//
+//==========================================================================================================================
+	void ViewCuller::Clear(void)
+	{
+		_minX.clear();
+		_minY.clear();
+		_maxX.clear();
+		_maxY.clear();
+	}
+
+	void ViewCuller::Reserve(U32 count)
+	{
+		_minX.reserve(count);
+		_minY.reserve(count);
+		_maxX.reserve(count);
+		_maxY.reserve(count);
+	}
+
+	void ViewCuller::Add(const AABB2D& bounds)
+	{
+		_minX.push_back(bounds.minX);
+		_minY.push_back(bounds.minY);
+		_maxX.push_back(bounds.maxX);
+		_maxY.push_back(bounds.maxY);
+	}
+
+//Four boxes at a time. Each compare gives a lane mask, and the four masks and'ed together say
+//which of the boxes overlap the view.
+	U32 ViewCuller::Cull(const AABB2D& view, std::vector<U32>& visible) const
+	{
+		U32 count = (U32)_minX.size();
+		U32 first = (U32)visible.size();
+		U32 i = 0;
+
+#ifdef KILLER_CULL_SSE
+		__m128 viewMinX = _mm_set1_ps(view.minX);
+		__m128 viewMinY = _mm_set1_ps(view.minY);
+		__m128 viewMaxX = _mm_set1_ps(view.maxX);
+		__m128 viewMaxY = _mm_set1_ps(view.maxY);
+
+		for(; i + 4 <= count; i += 4)
+		{
+			__m128 x = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&_minX[i]), viewMaxX), _mm_cmpge_ps(_mm_loadu_ps(&_maxX[i]), viewMinX));
+			__m128 y = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&_minY[i]), viewMaxY), _mm_cmpge_ps(_mm_loadu_ps(&_maxY[i]), viewMinY));
+
+			S32 mask = _mm_movemask_ps(_mm_and_ps(x, y));
+
+			if(mask == 0) { continue; }
+
+			if(mask & 1) { visible.push_back(i); }
+			if(mask & 2) { visible.push_back(i + 1); }
+			if(mask & 4) { visible.push_back(i + 2); }
+			if(mask & 8) { visible.push_back(i + 3); }
+		}
+#endif
+
+		for(; i < count; ++i)
+		{
+			if(_minX[i] <= view.maxX && _maxX[i] >= view.minX && _minY[i] <= view.maxY && _maxY[i] >= view.minY)
+			{
+				visible.push_back(i);
+			}
+		}
+
+		return (U32)visible.size() - first;
+	}
+}//End namespace
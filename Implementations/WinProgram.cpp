@@ -190,10 +190,24 @@ namespace KillerEngine {
 //BufferSwap
 //=======================================================================================================
     void WinProgram::BufferSwap(void)
+    { 
+        BufferSwap(_bgColor);
+    }
+
+    void WinProgram::BufferSwap(const GLfloat* clearColor)
     { 
         glFlush(); 
         SwapBuffers(_hdc); 
-        glClearBufferfv(GL_COLOR, 0, _bgColor);
+        glClearBufferfv(GL_COLOR, 0, clearColor);
+    }
+
+//=======================================================================================================
+//MakeContextCurrent
+//=======================================================================================================
+    void WinProgram::MakeContextCurrent(bool state)
+    {
+        if(state) { wglMakeCurrent(_hdc, _hglrc); }
+        else { wglMakeCurrent(NULL, NULL); }
     }
 //==========================================================================================================================
 //
@@ -0,0 +1,1098 @@
+/*========================================================================
+A console program that runs the Renderer with no window or GPU. Every
+test gives the Renderer a RecordingRenderBackend, submits a fixed scene,
+and checks what reached the backend: how many batches and static draws
+there were, how big each one was, and which shader and texture it used.
+
+Every call to new in the program is counted, so a test can check that a
+frame which has settled never goes to the heap.
+
+The EntityManager and Font loading need no GPU either, so the entity
+queries and chunks, and the .fnt parsers, are tested here too.
+
+Each failed check is printed with its line. The program returns the
+number of failures, so 0 means everything passed, and it can be run from
+a build script.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/Renderer.h>
+#include <Engine/RecordingRenderBackend.h>
+#include <Engine/JobPool.h>
+#include <Engine/EntityManager.h>
+#include <Engine/SystemScheduler.h>
+#include <Engine/Integrate2DSystem.h>
+#include <Engine/Font.h>
+
+//=====STL includes=====
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <atomic>
+#include <cstring>
+#include <random>
+#include <chrono>
+#include <utility>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+using namespace KillerEngine;
+
+//==========================================================================================================================
+//
+//Test Functions
+//
+//==========================================================================================================================
+static U32 failures = 0;
+
+static std::atomic<U32> heapAllocations(0);
+
+void* operator new(std::size_t size)
+{
+	heapAllocations.fetch_add(1, std::memory_order_relaxed);
+
+	void* memory = std::malloc(size == 0 ? 1 : size);
+
+	if(memory == NULL) { throw std::bad_alloc(); }
+
+	return memory;
+}
+
+//=====std::stable_sort asks for its buffer this way=====
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	heapAllocations.fetch_add(1, std::memory_order_relaxed);
+
+	return std::malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t size) noexcept
+{
+	std::free(memory);
+}
+
+#define CHECK(test) _Check((test), #test, __LINE__)
+
+static void _Check(bool passed, const char* test, U32 line)
+{
+	if(passed) { return; }
+
+	std::cout << "    FAILED line " << line << ": " << test << "\n";
+	++failures;
+}
+
+//=====Gives the Renderer the backend and puts back every setting a test may have changed=====
+static void _Begin(const char* name, RecordingRenderBackend& backend)
+{
+	std::cout << name << "\n";
+
+	Renderer* renderer = Renderer::Instance();
+	renderer->SetBackend(&backend);
+	renderer->SetQueueEnabled(true);
+	renderer->SetLayer(0);
+	renderer->SetMaxBatchSize(1000);
+
+	//=====Ends whatever frame the last test left open, so the stats start from 0=====
+	renderer->EndFrame();
+	backend.Reset();
+}
+
+static void _End(void)
+{
+	Renderer::Instance()->SetBackend(NULL);
+}
+
+//=====A backend with a batch size of its own, as if its buffers were small=====
+class SmallRecordingBackend : public RecordingRenderBackend
+{
+public:
+	U32 v_GetBatchCapacity(void) const { return 700; }
+};
+
+//=====5 untextured with shader 1, 3 with shader 2 and texture 7, 1 with shader 2 and texture 8, then 1500 more with shader 1=====
+static void _AddMixedScene(void)
+{
+	Renderer* renderer = Renderer::Instance();
+	Vec2 position(10.0f, 20.0f);
+	Vec2 origin(0.25f, 0.5f);
+	Vec2 limit(0.75f, 1.0f);
+	Col color(1.0f, 0.0f, 0.0f, 1.0f);
+
+	for(U32 i = 0; i < 5; ++i) { renderer->AddToBatch(1, position, 2.0f, 2.0f, color); }
+	for(U32 i = 0; i < 3; ++i) { renderer->AddToBatch(2, position, 2.0f, 2.0f, color, 7, origin, limit); }
+	renderer->AddToBatch(2, position, 2.0f, 2.0f, color, 8);
+	for(U32 i = 0; i < 1500; ++i) { renderer->AddToBatch(1, position, 2.0f, 2.0f, color); }
+}
+
+//=====Sprites with 3 shaders and 4 textures mixed together, the same every time for the same range=====
+static void _RecordSprites(U32 begin, U32 end)
+{
+	Renderer* renderer = Renderer::Instance();
+	Col color(1.0f, 0.5f, 0.25f, 1.0f);
+
+	for(U32 i = begin; i < end; ++i)
+	{
+		Vec2 position((F32)i, (F32)(i % 13));
+		renderer->AddToBatch(1 + (i % 3), position, 2.0f, 2.0f, color, 5 + (i % 4));
+	}
+}
+
+//==========================================================================================================================
+//
+//Tests
+//
+//==========================================================================================================================
+//=====By default sprites are drawn in the order they are added, so overlapping sprites with different textures keep their order=====
+static void TestDefaultKeepsSubmissionOrder(void)
+{
+	std::cout << "TestDefaultKeepsSubmissionOrder\n";
+
+	//=====Runs before any other test turns the queue on=====
+	Renderer* renderer = Renderer::Instance();
+	RecordingRenderBackend backend;
+	renderer->SetBackend(&backend);
+	renderer->SetMaxBatchSize(1000);
+	renderer->EndFrame();
+	backend.Reset();
+
+	CHECK(!renderer->GetQueueEnabled());
+
+	Vec2 position(5.0f, 5.0f);
+	Col color(1.0f, 1.0f, 1.0f, 0.5f);
+
+	//=====A tile, a character standing on it with a lower texture ID, then text with its own shader over both=====
+	renderer->AddToBatch(1, position, 32.0f, 32.0f, color, 9);
+	renderer->AddToBatch(1, position, 16.0f, 16.0f, color, 3);
+	renderer->AddToBatch(2, position, 8.0f, 8.0f, color, 4);
+	renderer->AddToBatch(1, position, 32.0f, 32.0f, color, 9);
+	renderer->Draw();
+
+	const std::vector<RecordedBatch>& batches = backend.GetBatches();
+
+	CHECK(batches.size() == 4);
+
+	if(batches.size() == 4)
+	{
+		CHECK(batches[0].shader == 1 && batches[0].textureID == 9);
+		CHECK(batches[1].shader == 1 && batches[1].textureID == 3);
+		CHECK(batches[2].shader == 2 && batches[2].textureID == 4);
+		CHECK(batches[3].shader == 1 && batches[3].textureID == 9);
+	}
+
+	_End();
+}
+
+//=====The queue puts every sprite with the same shader and texture together, then splits them by the batch size=====
+static void TestQueueSortsScene(void)
+{
+	RecordingRenderBackend backend;
+	_Begin("TestQueueSortsScene", backend);
+
+	_AddMixedScene();
+	Renderer::Instance()->Draw();
+
+	const std::vector<RecordedBatch>& batches = backend.GetBatches();
+	const RenderCounters& counters = backend.GetCounters();
+
+	CHECK(counters.batches == 4);
+	CHECK(counters.staticDraws == 0);
+	CHECK(counters.sprites == 1509);
+	CHECK(counters.shaderSwitches == 2);
+	CHECK(counters.textureSwitches == 2);
+
+	if(batches.size() == 4)
+	{
+		CHECK(batches[0].shader == 1 && batches[0].count == 1000 && !batches[0].textured);
+		CHECK(batches[1].shader == 1 && batches[1].count == 505 && !batches[1].textured);
+		CHECK(batches[2].shader == 2 && batches[2].textureID == 7 && batches[2].count == 3 && batches[2].textured);
+		CHECK(batches[3].shader == 2 && batches[3].textureID == 8 && batches[3].count == 1 && batches[3].textured);
+
+		const SpriteVertex& vertex = batches[2].vertices[0];
+		CHECK(std::fabs(vertex.GetUV(0) - 0.25f) < 0.0001f && std::fabs(vertex.GetUV(3) - 1.0f) < 0.0001f);
+		CHECK(vertex.GetColor(0) == 1.0f && vertex.GetHalfSize(0) == 1.0f);
+	}
+
+	_End();
+}
+
+//=====With the queue off a batch is flushed every time the shader or texture changes=====
+static void TestUnqueuedScene(void)
+{
+	RecordingRenderBackend backend;
+	_Begin("TestUnqueuedScene", backend);
+
+	Renderer::Instance()->SetQueueEnabled(false);
+	_AddMixedScene();
+	Renderer::Instance()->Draw();
+
+	const std::vector<RecordedBatch>& batches = backend.GetBatches();
+	const RenderCounters& counters = backend.GetCounters();
+
+	CHECK(counters.batches == 5);
+	CHECK(counters.sprites == 1509);
+	CHECK(counters.shaderSwitches == 3);
+	CHECK(counters.textureSwitches == 2);
+
+	if(batches.size() == 5)
+	{
+		CHECK(batches[0].shader == 1 && batches[0].count == 5);
+		CHECK(batches[1].shader == 2 && batches[1].textureID == 7 && batches[1].count == 3);
+		CHECK(batches[2].shader == 2 && batches[2].textureID == 8 && batches[2].count == 1);
+		CHECK(batches[3].shader == 1 && batches[3].count == 1000);
+		CHECK(batches[4].shader == 1 && batches[4].count == 500);
+	}
+
+	_End();
+}
+
+//=====A lower layer is drawn first, whatever order it was added in=====
+static void TestLayers(void)
+{
+	RecordingRenderBackend backend;
+	_Begin("TestLayers", backend);
+
+	Renderer* renderer = Renderer::Instance();
+	Vec2 position(0.0f, 0.0f);
+	Col color(1.0f, 1.0f, 1.0f, 1.0f);
+
+	renderer->SetLayer(1);
+	for(U32 i = 0; i < 10; ++i) { renderer->AddToBatch(1, position, 4.0f, 4.0f, color); }
+
+	renderer->SetLayer(0);
+	for(U32 i = 0; i < 20; ++i) { renderer->AddToBatch(2, position, 4.0f, 4.0f, color); }
+
+	renderer->Draw();
+
+	const std::vector<RecordedBatch>& batches = backend.GetBatches();
+
+	CHECK(batches.size() == 2);
+
+	if(batches.size() == 2)
+	{
+		CHECK(batches[0].shader == 2 && batches[0].count == 20);
+		CHECK(batches[1].shader == 1 && batches[1].count == 10);
+	}
+
+	_End();
+}
+
+//=====What was submitted before a static draw is drawn before it=====
+static void TestDrawStatic(void)
+{
+	RecordingRenderBackend backend;
+	_Begin("TestDrawStatic", backend);
+
+	Renderer* renderer = Renderer::Instance();
+	Vec2 position(0.0f, 0.0f);
+	Col color(1.0f, 1.0f, 1.0f, 1.0f);
+
+	for(U32 i = 0; i < 10; ++i) { renderer->AddToBatch(1, position, 4.0f, 4.0f, color); }
+
+	renderer->DrawStatic(2, 9, 99, 600);
+	renderer->Draw();
+
+	const std::vector<RecordedBatch>& batches = backend.GetBatches();
+	const RenderCounters& counters = backend.GetCounters();
+
+	CHECK(counters.batches == 1);
+	CHECK(counters.staticDraws == 1);
+	CHECK(counters.sprites == 610);
+
+	if(batches.size() == 2)
+	{
+		CHECK(!batches[0].isStatic && batches[0].shader == 1 && batches[0].count == 10);
+		CHECK(batches[1].isStatic && batches[1].shader == 2 && batches[1].textureID == 9);
+		CHECK(batches[1].vertexArray == 99 && batches[1].count == 600 && batches[1].textured);
+	}
+
+	_End();
+}
+
+//=====GetFrameStats has the counts for the last frame that was ended=====
+static void TestFrameStats(void)
+{
+	RecordingRenderBackend backend;
+	backend.SetKeepData(false);
+	_Begin("TestFrameStats", backend);
+
+	Renderer* renderer = Renderer::Instance();
+
+	for(U32 frame = 0; frame < 3; ++frame)
+	{
+		renderer->BeginFrame();
+		_AddMixedScene();
+		renderer->Draw();
+		renderer->EndFrame();
+
+		const RenderFrameStats& stats = renderer->GetFrameStats();
+
+		CHECK(stats.sprites == 1509);
+		CHECK(stats.batches == 4);
+		CHECK(stats.highWater == 1509);
+	}
+
+	CHECK(backend.GetCounters().frames == 3);
+	CHECK(backend.GetCounters().batches == 12);
+
+	_End();
+}
+
+//=====Once the first frame has grown the queue, the same frame again grows nothing and never calls new=====
+static void TestSteadyFramesDoNotAllocate(void)
+{
+	RecordingRenderBackend backend;
+	backend.SetKeepData(false);
+	_Begin("TestSteadyFramesDoNotAllocate", backend);
+
+	Renderer* renderer = Renderer::Instance();
+
+	for(U32 frame = 0; frame < 6; ++frame)
+	{
+		backend.Reset();
+		U32 before = heapAllocations.load();
+
+		renderer->BeginFrame();
+		_RecordSprites(0, 3000);
+		renderer->Draw();
+		renderer->EndFrame();
+
+		U32 allocations = heapAllocations.load() - before;
+
+		CHECK(renderer->GetFrameStats().sprites == 3000);
+
+		if(frame > 0) { CHECK(renderer->GetFrameStats().bufferGrowths == 0); }
+		if(frame > 1) { CHECK(allocations == 0); }
+	}
+
+	_End();
+}
+
+//=====The same with the sprites recorded on the JobPool, so the jobs and command lists are reused too=====
+static void TestSteadyParallelFramesDoNotAllocate(void)
+{
+	RecordingRenderBackend backend;
+	backend.SetKeepData(false);
+	_Begin("TestSteadyParallelFramesDoNotAllocate", backend);
+
+	JobPool::Instance()->Init(3);
+	Renderer* renderer = Renderer::Instance();
+
+	for(U32 frame = 0; frame < 6; ++frame)
+	{
+		backend.Reset();
+		U32 before = heapAllocations.load();
+
+		renderer->BeginFrame();
+		renderer->RecordParallel(3000, 250, _RecordSprites);
+		renderer->Draw();
+		renderer->EndFrame();
+
+		U32 allocations = heapAllocations.load() - before;
+
+		CHECK(renderer->GetFrameStats().sprites == 3000);
+
+		if(frame > 0) { CHECK(renderer->GetFrameStats().bufferGrowths == 0); }
+		if(frame > 1) { CHECK(allocations == 0); }
+	}
+
+	JobPool::Instance()->ShutDown();
+
+	_End();
+}
+
+//=====50000 sprites recorded over 8 threads draw exactly the same batches as on one thread=====
+static void TestParallelMatchesSerial(void)
+{
+	RecordingRenderBackend serial;
+	RecordingRenderBackend parallel;
+	Renderer* renderer = Renderer::Instance();
+
+	_Begin("TestParallelMatchesSerial", serial);
+	renderer->SetMaxBatchSize(0);
+
+	renderer->BeginFrame();
+	_RecordSprites(0, 50000);
+	renderer->Draw();
+	renderer->EndFrame();
+
+	JobPool::Instance()->Init(7);
+	renderer->SetBackend(&parallel);
+
+	for(U32 frame = 0; frame < 3; ++frame)
+	{
+		parallel.Reset();
+
+		renderer->BeginFrame();
+		renderer->RecordParallel(50000, 1000, _RecordSprites);
+		renderer->Draw();
+		renderer->EndFrame();
+
+		CHECK(renderer->GetFrameStats().sprites == 50000);
+		CHECK(parallel.GetBatchCount() == serial.GetBatchCount());
+		CHECK(parallel.GetCounters().shaderSwitches == serial.GetCounters().shaderSwitches);
+		CHECK(parallel.GetCounters().textureSwitches == serial.GetCounters().textureSwitches);
+
+		bool same = parallel.GetBatchCount() == serial.GetBatchCount();
+
+		for(U32 i = 0; same && i < serial.GetBatchCount(); ++i)
+		{
+			const RecordedBatch& a = serial.GetBatches()[i];
+			const RecordedBatch& b = parallel.GetBatches()[i];
+
+			same = a.shader == b.shader && a.textureID == b.textureID && a.count == b.count && 
+				   a.vertices.size() == b.vertices.size() && 
+				   memcmp(&a.vertices[0], &b.vertices[0], a.vertices.size() * sizeof(SpriteVertex)) == 0;
+		}
+
+		CHECK(same);
+	}
+
+	JobPool::Instance()->ShutDown();
+
+	_End();
+}
+
+//=====The batch size comes from the backend, or from the GLRenderBackend's stream region when it has none=====
+static void TestBatchSizeFromBackend(void)
+{
+	RecordingRenderBackend recording;
+	SmallRecordingBackend small;
+	Renderer* renderer = Renderer::Instance();
+	Vec2 position(0.0f, 0.0f);
+	Col color(1.0f, 1.0f, 1.0f, 1.0f);
+
+	_Begin("TestBatchSizeFromBackend", recording);
+	renderer->SetMaxBatchSize(0);
+
+	CHECK(renderer->GetMaxBatchSize() == (1 << 20) / sizeof(SpriteVertex));
+
+	for(U32 i = 0; i < 5000; ++i) { renderer->AddToBatch(1, position, 2.0f, 2.0f, color); }
+	renderer->Draw();
+
+	CHECK(recording.GetBatchCount() == 1 && recording.GetBatches()[0].count == 5000);
+
+	renderer->SetBackend(&small);
+
+	CHECK(renderer->GetMaxBatchSize() == 700);
+
+	for(U32 i = 0; i < 2000; ++i) { renderer->AddToBatch(1, position, 2.0f, 2.0f, color); }
+	renderer->Draw();
+
+	CHECK(small.GetBatchCount() == 3);
+	if(small.GetBatchCount() == 3) { CHECK(small.GetBatches()[2].count == 600); }
+
+	//=====An override wins over the backend=====
+	small.Reset();
+	renderer->SetMaxBatchSize(1000);
+
+	for(U32 i = 0; i < 2500; ++i) { renderer->AddToBatch(1, position, 2.0f, 2.0f, color); }
+	renderer->Draw();
+
+	CHECK(small.GetBatchCount() == 3);
+	if(small.GetBatchCount() == 3) { CHECK(small.GetBatches()[0].count == 1000 && small.GetBatches()[2].count == 500); }
+
+	renderer->SetMaxBatchSize(0);
+	CHECK(renderer->GetMaxBatchSize() == 700);
+
+	_End();
+}
+
+//=====Calibration tries every power of two from 256 up to the backend's limit, then keeps the fastest=====
+static void TestCalibrateBatchSize(void)
+{
+	SmallRecordingBackend backend;
+	backend.SetKeepData(false);
+	_Begin("TestCalibrateBatchSize", backend);
+
+	Renderer* renderer = Renderer::Instance();
+	renderer->SetMaxBatchSize(0);
+
+	U32 best = renderer->CalibrateBatchSize(1, 20000, 2);
+	const std::vector<BatchSizeResult>& results = renderer->GetCalibrationResults();
+
+	CHECK(results.size() == 3);
+
+	if(results.size() == 3)
+	{
+		CHECK(results[0].batchSize == 256 && results[1].batchSize == 512 && results[2].batchSize == 700);
+		CHECK(best == results[0].batchSize || best == results[1].batchSize || best == results[2].batchSize);
+	}
+
+	CHECK(renderer->GetMaxBatchSize() == best);
+
+	//=====Every size draws the test frame once to settle, then once per timed frame=====
+	CHECK(backend.GetCounters().sprites == 20000 * 3 * 3);
+	CHECK(renderer->GetQueueEnabled());
+
+	renderer->SetMaxBatchSize(0);
+
+	_End();
+}
+
+//=====Pack gives the same half sizes as SpriteVertex::FloatToHalf, over 819200 random sizes and bit patterns=====
+static void TestParticlePackMatchesScalar(void)
+{
+	std::cout << "TestParticlePackMatchesScalar\n";
+
+	std::mt19937 random(5);
+	std::uniform_real_distribution<F32> unit(0.0f, 1.0f);
+	Col color(1.0f, 1.0f, 1.0f, 1.0f);
+	ParticleBuffer2D particles;
+	std::vector<SpriteVertex> vertices(4096);
+	U32 mismatches = 0;
+
+	for(U32 round = 0; round < 200; ++round)
+	{
+		particles.Clear();
+
+		for(U32 i = 0; i < 4096; ++i)
+		{
+			U32 bits = random();
+			F32 size;
+			memcpy(&size, &bits, sizeof(size));
+
+			if(i % 2 == 1) { size = unit(random) * 200.0f; }
+			if(i % 7 == 0) { size = (F32)(i % 64); }
+
+			particles.Add(unit(random) * 800.0f, unit(random) * 600.0f, size, color);
+		}
+
+		particles.Pack(&vertices[0], 0, particles.GetCount());
+
+		for(U32 i = 0; i < particles.GetCount(); ++i)
+		{
+			U16 expected = SpriteVertex::FloatToHalf(particles.GetSize()[i] * 0.5f);
+			U16 packed = vertices[i].halfSize[0];
+
+			//=====Any NaN will do for a NaN=====
+			bool bothNaN = (expected & 0x7C00) == 0x7C00 && (expected & 0x3FF) != 0 && 
+						   (packed & 0x7C00) == 0x7C00 && (packed & 0x3FF) != 0;
+
+			if(packed != expected && !bothNaN) { ++mismatches; }
+		}
+	}
+
+	CHECK(mismatches == 0);
+}
+
+//=====One particle packs to the same SpriteVertex a sprite would, and Remove fills the hole with the last one=====
+static void TestParticleBuffer(void)
+{
+	std::cout << "TestParticleBuffer\n";
+
+	ParticleBuffer2D particles;
+	Col color(1.0f, 0.5f, 0.25f, 1.0f);
+
+	CHECK(particles.AddFrame(0.25f, 0.5f, 0.75f, 1.0f) == 0);
+
+	for(U32 i = 0; i < 10; ++i) { particles.Add(i * 3.0f, i * 2.0f, 8.0f, color, i % 2 == 1 ? 0 : 7); }
+	particles.SetDepth(2.0f);
+
+	std::vector<SpriteVertex> vertices(10);
+	particles.Pack(&vertices[0], 0, 10);
+
+	SpriteVertex expected = SpriteVertex::Pack(9.0f, 6.0f, 2.0f, 1.0f, 0.5f, 0.25f, 1.0f, 4.0f, 4.0f, 0.25f, 0.5f, 0.75f, 1.0f);
+	CHECK(memcmp(&vertices[3], &expected, sizeof(expected)) == 0);
+
+	//=====Frame 7 is not in the table, so it is drawn with frame 0=====
+	CHECK(memcmp(vertices[2].uvs, vertices[3].uvs, sizeof(vertices[2].uvs)) == 0);
+
+	particles.Remove(0);
+	CHECK(particles.GetCount() == 9 && particles.GetX()[0] == 27.0f);
+}
+
+//=====AddParticles splits a buffer into as many batches as it takes. The time against one AddToBatch a particle is printed=====
+static void TestAddParticles(void)
+{
+	RecordingRenderBackend backend;
+	backend.SetKeepData(false);
+	_Begin("TestAddParticles", backend);
+
+	Renderer* renderer = Renderer::Instance();
+	std::mt19937 random(9);
+	std::uniform_real_distribution<F32> unit(0.0f, 1.0f);
+	Col color(1.0f, 1.0f, 1.0f, 1.0f);
+	ParticleBuffer2D particles;
+	particles.Reserve(100000);
+
+	for(U32 i = 0; i < 100000; ++i) { particles.Add(unit(random) * 800.0f, unit(random) * 600.0f, 4.0f, color); }
+
+	renderer->SetMaxBatchSize(30000);
+	renderer->AddParticles(3, 0, particles);
+
+	CHECK(backend.GetBatchCount() == 4);
+	if(backend.GetBatchCount() == 4) { CHECK(backend.GetBatches()[3].count == 10000 && backend.GetBatches()[3].shader == 3); }
+	CHECK(backend.GetCounters().sprites == 100000);
+
+	renderer->SetMaxBatchSize(0);
+
+	const U32 frames = 20;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for(U32 frame = 0; frame < frames; ++frame)
+	{
+		backend.Reset();
+		renderer->AddParticles(3, 0, particles);
+	}
+
+	std::chrono::steady_clock::time_point middle = std::chrono::steady_clock::now();
+
+	for(U32 frame = 0; frame < frames; ++frame)
+	{
+		backend.Reset();
+
+		for(U32 i = 0; i < particles.GetCount(); ++i)
+		{
+			Vec2 position(particles.GetX()[i], particles.GetY()[i]);
+			renderer->AddToBatch(3, position, 4.0f, 4.0f, color);
+		}
+
+		renderer->Draw();
+	}
+
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+	std::cout << "    100000 particles: AddParticles " << std::chrono::duration<F64, std::milli>(middle - start).count() / frames 
+			  << " ms, AddToBatch " << std::chrono::duration<F64, std::milli>(end - middle).count() / frames << " ms a frame\n";
+
+	_End();
+}
+
+//=====A row bigger than Archetype::CHUNK_BYTES=====
+struct BigComponent
+{
+	U8 data[20000];
+};
+
+//=====Only used to fill the ComponentRegistry=====
+template<U32 N>
+struct FillerComponent
+{
+	U32 value;
+};
+
+template<std::size_t... N>
+static U32 _RegisterFillers(std::index_sequence<N...>)
+{
+	U32 ids[] = { ComponentID<FillerComponent<(U32)N>>()... };
+	return ids[sizeof...(N) - 1];
+}
+
+//=====A query visits every chunk with the components it asks for, and a destroyed row is filled with the last one=====
+static void TestEntityQueries(void)
+{
+	std::cout << "TestEntityQueries\n";
+
+	EntityManager entities;
+	std::vector<Entity> moving;
+
+	for(U32 i = 0; i < 1000; ++i)
+	{
+		Entity entity = entities.CreateEntity();
+		Position2D position;
+		position.value = Vec2((F32)i, 0.0f);
+		Velocity2D velocity;
+		velocity.value = Vec2(0.0f, (F32)i);
+
+		entities.AddComponent<Position2D>(entity, position);
+		entities.AddComponent<Velocity2D>(entity, velocity);
+		moving.push_back(entity);
+	}
+
+	for(U32 i = 0; i < 500; ++i) { entities.AddComponent<Position2D>(entities.CreateEntity(), Position2D()); }
+	for(U32 i = 0; i < 300; ++i) { entities.AddComponent<Velocity2D>(entities.CreateEntity(), Velocity2D()); }
+
+	CHECK(entities.GetEntityCount() == 1800);
+
+	std::vector<ChunkRef> chunks;
+	entities.GetMatchingChunks(ComponentBit<Position2D>() | ComponentBit<Velocity2D>(), chunks);
+
+	U32 rows = 0;
+	bool packed = true;
+
+	for(U32 c = 0; c < chunks.size(); ++c)
+	{
+		CHECK(chunks[c].Count() <= chunks[c].archetype->GetChunkCapacity());
+
+		Position2D* positions = chunks[c].Get<Position2D>();
+		Velocity2D* velocities = chunks[c].Get<Velocity2D>();
+		Entity* handles = chunks[c].Entities();
+
+		for(U32 r = 0; r < chunks[c].Count(); ++r)
+		{
+			if(positions[r].value.GetX() != velocities[r].value.GetY()) { packed = false; }
+			if(entities.GetComponent<Position2D>(handles[r]) != &positions[r]) { packed = false; }
+		}
+
+		rows += chunks[c].Count();
+	}
+
+	CHECK(chunks.size() > 1);
+	CHECK(rows == 1000);
+	CHECK(packed);
+
+	U32 positionRows = 0;
+	entities.ForEachChunk(ComponentBit<Position2D>(), [&positionRows](ChunkRef& chunk) { positionRows += chunk.Count(); });
+	CHECK(positionRows == 1500);
+
+	//=====Every other moving entity, so rows are moved out of later chunks into the holes=====
+	for(U32 i = 0; i < moving.size(); i += 2) { entities.DestroyEntity(moving[i]); }
+
+	bool kept = true;
+
+	for(U32 i = 1; i < moving.size(); i += 2)
+	{
+		Position2D* position = entities.GetComponent<Position2D>(moving[i]);
+		Velocity2D* velocity = entities.GetComponent<Velocity2D>(moving[i]);
+
+		if(position == NULL || velocity == NULL || position->value.GetX() != (F32)i || velocity->value.GetY() != (F32)i) { kept = false; }
+	}
+
+	CHECK(kept);
+	CHECK(!entities.IsAlive(moving[0]));
+	CHECK(entities.GetEntityCount() == 1300);
+
+	//=====Taking a component away moves the entity to the archetype without it=====
+	entities.RemoveComponent<Velocity2D>(moving[1]);
+	CHECK(!entities.HasComponent<Velocity2D>(moving[1]));
+	CHECK(entities.GetComponent<Position2D>(moving[1])->value.GetX() == 1.0f);
+}
+
+//=====A row that does not fit in a chunk gets a chunk of its own, big enough to hold it=====
+static void TestLargeComponentChunks(void)
+{
+	std::cout << "TestLargeComponentChunks\n";
+
+	EntityManager entities;
+	std::vector<Entity> created;
+
+	for(U32 i = 0; i < 3; ++i)
+	{
+		Entity entity = entities.CreateEntity();
+		entities.AddComponent<Position2D>(entity, Position2D());
+		BigComponent* big = entities.AddComponent<BigComponent>(entity, BigComponent());
+
+		//=====Writes every byte, so a chunk that is too small shows up under a memory checker=====
+		if(big != NULL) { memset(big->data, (S32)i + 1, sizeof(big->data)); }
+
+		created.push_back(entity);
+	}
+
+	std::vector<ChunkRef> chunks;
+	entities.GetMatchingChunks(ComponentBit<BigComponent>(), chunks);
+
+	CHECK(chunks.size() == 3);
+	CHECK(chunks[0].archetype->GetChunkCapacity() == 1);
+	CHECK(chunks[0].archetype->GetChunkBytes() >= sizeof(Entity) + sizeof(BigComponent) + sizeof(Position2D));
+
+	bool intact = true;
+
+	for(U32 i = 0; i < created.size(); ++i)
+	{
+		BigComponent* big = entities.GetComponent<BigComponent>(created[i]);
+
+		if(big == NULL || big->data[0] != i + 1 || big->data[sizeof(big->data) - 1] != i + 1) { intact = false; }
+	}
+
+	CHECK(intact);
+}
+
+//=====Systems step by the time given to Run, not the Timer, so a map with a tick divisor moves at the right speed=====
+static void TestSystemsStepByRunDelta(void)
+{
+	std::cout << "TestSystemsStepByRunDelta\n";
+
+	EntityManager entities;
+	SystemScheduler scheduler;
+	Integrate2DSystem integrate;
+	scheduler.AddSystem(&integrate);
+
+	std::vector<Entity> created;
+
+	for(U32 i = 0; i < 2000; ++i)
+	{
+		Entity entity = entities.CreateEntity();
+		Velocity2D velocity;
+		velocity.value = Vec2(2.0f, 0.0f);
+
+		entities.AddComponent<Position2D>(entity, Position2D());
+		entities.AddComponent<Velocity2D>(entity, velocity);
+		entities.AddComponent<Acceleration2D>(entity, Acceleration2D());
+		created.push_back(entity);
+	}
+
+	//=====One tick of a map with a divisor of 4 at 60 frames a second=====
+	scheduler.Run(entities, 4.0f / 60.0f);
+
+	bool moved = true;
+
+	for(U32 i = 0; i < created.size(); ++i)
+	{
+		if(std::fabs(entities.GetComponent<Position2D>(created[i])->value.GetX() - 8.0f / 60.0f) > 0.00001f) { moved = false; }
+	}
+
+	CHECK(moved);
+}
+
+//=====Past 64 types a component gets no ID, and the EntityManager will not store it=====
+static void TestTooManyComponentTypes(void)
+{
+	std::cout << "TestTooManyComponentTypes\n";
+
+	U32 last = _RegisterFillers(std::make_index_sequence<MAX_COMPONENT_TYPES + 2>());
+
+	CHECK(last == INVALID_COMPONENT);
+	CHECK(ComponentBit<FillerComponent<MAX_COMPONENT_TYPES + 1>>() == 0);
+	CHECK(ComponentRegistry::Instance()->GetCount() == MAX_COMPONENT_TYPES);
+
+	EntityManager entities;
+	Entity entity = entities.CreateEntity();
+
+	CHECK(entities.AddComponent<FillerComponent<MAX_COMPONENT_TYPES + 1>>(entity, FillerComponent<MAX_COMPONENT_TYPES + 1>()) == NULL);
+	CHECK(entities.GetComponent<FillerComponent<MAX_COMPONENT_TYPES + 1>>(entity) == NULL);
+	CHECK(entities.GetMask(entity) == 0);
+}
+
+//=====Font files, glyph ids 32 up, so those from 2048 up go through the hash map, and kerning pairs written backwards=====
+static const U32 FONT_GLYPHS = 5000;
+
+static const U32 FONT_KERNINGS = 20000;
+
+static CharacterData _FontGlyph(U32 i)
+{
+	CharacterData glyph;
+	glyph.id = 32 + i;
+	glyph.x = (i % 100) * 10;
+	glyph.y = (i / 100) * 12;
+	glyph.width = 8 + i % 8;
+	glyph.height = 10 + i % 4;
+	glyph.xoffset = (S32)(i % 5) - 2;
+	glyph.yoffset = -(S32)(i % 3);
+	glyph.xadvance = 9 + i % 4;
+	return glyph;
+}
+
+static KerningPair _FontKerning(U32 k)
+{
+	KerningPair kerning;
+	kerning.first = 32 + k / 4;
+	kerning.second = 32 + (k % 4) * 1000 + 1;
+	kerning.amount = (S32)(k % 7) - 3;
+	return kerning;
+}
+
+static void _WriteTextFont(const char* path)
+{
+	std::ostringstream text;
+
+	text << "info face=\"Test Face\" size=32 bold=0 italic=0 charset=\"\" unicode=1 padding=1,1,1,1 spacing=1,1\n";
+	text << "common lineHeight=36 base=29 scaleW=1024 scaleH=1024 pages=1 packed=0\n";
+	text << "page id=0 file=\"test font.png\"\n";
+	text << "chars count=" << FONT_GLYPHS << "\n";
+
+	for(U32 i = 0; i < FONT_GLYPHS; ++i)
+	{
+		CharacterData glyph = _FontGlyph(i);
+
+		text << "char id=" << glyph.id << " x=" << glyph.x << " y=" << glyph.y << " width=" << glyph.width << " height=" << glyph.height
+			 << " xoffset=" << glyph.xoffset << " yoffset=" << glyph.yoffset << " xadvance=" << glyph.xadvance << " page=0 chnl=15\r\n";
+	}
+
+	text << "kernings count=" << FONT_KERNINGS << "\n";
+
+	for(U32 k = FONT_KERNINGS; k > 0; --k)
+	{
+		KerningPair kerning = _FontKerning(k - 1);
+		text << "kerning first=" << kerning.first << " second=" << kerning.second << " amount=" << kerning.amount << "\n";
+	}
+
+	std::ofstream file(path, std::ios::binary);
+	file << text.str();
+}
+
+static void _PutU16(std::string& out, U32 value)
+{
+	out.push_back((char)(value & 0xFF));
+	out.push_back((char)((value >> 8) & 0xFF));
+}
+
+static void _PutU32(std::string& out, U32 value)
+{
+	_PutU16(out, value & 0xFFFF);
+	_PutU16(out, value >> 16);
+}
+
+static void _PutBlock(std::string& out, U8 type, const std::string& body)
+{
+	out.push_back((char)type);
+	_PutU32(out, (U32)body.size());
+	out += body;
+}
+
+static void _WriteBinaryFont(const char* path)
+{
+	std::string out("BMF\3", 4);
+
+	std::string info(14, 0);
+	info += "Test Face";
+	info.push_back(0);
+	_PutBlock(out, 1, info);
+
+	std::string common;
+	_PutU16(common, 36);
+	_PutU16(common, 29);
+	_PutU16(common, 1024);
+	_PutU16(common, 1024);
+	_PutU16(common, 1);
+	common += std::string(5, 0);
+	_PutBlock(out, 2, common);
+
+	_PutBlock(out, 3, std::string("test font.png", 14));
+
+	std::string chars;
+
+	for(U32 i = 0; i < FONT_GLYPHS; ++i)
+	{
+		CharacterData glyph = _FontGlyph(i);
+
+		_PutU32(chars, glyph.id);
+		_PutU16(chars, glyph.x);
+		_PutU16(chars, glyph.y);
+		_PutU16(chars, glyph.width);
+		_PutU16(chars, glyph.height);
+		_PutU16(chars, (U32)glyph.xoffset & 0xFFFF);
+		_PutU16(chars, (U32)glyph.yoffset & 0xFFFF);
+		_PutU16(chars, glyph.xadvance);
+		chars.push_back(0);
+		chars.push_back(15);
+	}
+
+	_PutBlock(out, 4, chars);
+
+	std::string kernings;
+
+	for(U32 k = FONT_KERNINGS; k > 0; --k)
+	{
+		KerningPair kerning = _FontKerning(k - 1);
+
+		_PutU32(kernings, kerning.first);
+		_PutU32(kernings, kerning.second);
+		_PutU16(kernings, (U32)kerning.amount & 0xFFFF);
+	}
+
+	_PutBlock(out, 5, kernings);
+
+	std::ofstream file(path, std::ios::binary);
+	file.write(out.data(), (std::streamsize)out.size());
+}
+
+static bool _SameGlyph(const CharacterData* found, const CharacterData& expected)
+{
+	return found != NULL && found->id == expected.id && found->x == expected.x && found->y == expected.y && 
+		   found->width == expected.width && found->height == expected.height && found->xoffset == expected.xoffset && 
+		   found->yoffset == expected.yoffset && found->xadvance == expected.xadvance;
+}
+
+static void _CheckFont(Font& font, bool binary)
+{
+	const FontStats& stats = font.GetStats();
+
+	CHECK(stats.binary == binary);
+	CHECK(stats.glyphs == FONT_GLYPHS);
+	CHECK(stats.hashedGlyphs == FONT_GLYPHS - (2048 - 32));
+	CHECK(stats.kernings == FONT_KERNINGS);
+	CHECK(font.GetLineHeight() == 36 && font.GetBase() == 29);
+
+	//=====The flat table, then the hash map, then ids that are in neither=====
+	CHECK(_SameGlyph(font.GetDataForCharacter('A'), _FontGlyph('A' - 32)));
+	CHECK(_SameGlyph(font.GetDataForCodepoint(2047), _FontGlyph(2047 - 32)));
+	CHECK(_SameGlyph(font.GetDataForCodepoint(2048), _FontGlyph(2048 - 32)));
+	CHECK(_SameGlyph(font.GetDataForCodepoint(32 + FONT_GLYPHS - 1), _FontGlyph(FONT_GLYPHS - 1)));
+	CHECK(font.GetDataForCodepoint(31) == NULL);
+	CHECK(font.GetDataForCodepoint(32 + FONT_GLYPHS) == NULL);
+
+	bool kerned = true;
+
+	for(U32 k = 0; k < FONT_KERNINGS; k += 97)
+	{
+		KerningPair kerning = _FontKerning(k);
+
+		if(font.GetKerning(kerning.first, kerning.second) != kerning.amount) { kerned = false; }
+	}
+
+	CHECK(kerned);
+	CHECK(font.GetKerning(33, 34) == 0);
+
+	std::cout << "    " << (binary ? "binary" : "text") << ": " << stats.glyphs << " glyphs and " << stats.kernings << " kerning pairs, " 
+			  << stats.bytes << " bytes in " << stats.loadTime << " ms\n";
+}
+
+//=====A font with thousands of glyphs loads the same from the text and binary files=====
+static void TestLargeFontLoad(void)
+{
+	std::cout << "TestLargeFontLoad\n";
+
+	const char* textPath = "RenderTests_large_text.fnt";
+	const char* binaryPath = "RenderTests_large_binary.fnt";
+
+	_WriteTextFont(textPath);
+	_WriteBinaryFont(binaryPath);
+
+	Font text;
+	text.InitFont("Test Face", textPath);
+	_CheckFont(text, false);
+
+	Font binary;
+	binary.InitFont("Test Face", binaryPath);
+	_CheckFont(binary, true);
+
+	std::remove(textPath);
+	std::remove(binaryPath);
+}
+
+//==========================================================================================================================
+//
+//Main
+//
+//==========================================================================================================================
+int main(void)
+{
+	TestDefaultKeepsSubmissionOrder();
+	TestQueueSortsScene();
+	TestUnqueuedScene();
+	TestLayers();
+	TestDrawStatic();
+	TestFrameStats();
+	TestSteadyFramesDoNotAllocate();
+	TestSteadyParallelFramesDoNotAllocate();
+	TestParallelMatchesSerial();
+	TestBatchSizeFromBackend();
+	TestCalibrateBatchSize();
+	TestParticlePackMatchesScalar();
+	TestParticleBuffer();
+	TestAddParticles();
+	TestEntityQueries();
+	TestLargeComponentChunks();
+	TestSystemsStepByRunDelta();
+	TestLargeFontLoad();
+
+	//=====Fills the ComponentRegistry, so it has to be the last test to make a component type=====
+	TestTooManyComponentTypes();
+
+	if(failures == 0) { std::cout << "All tests passed.\n"; }
+	else { std::cout << failures << " checks failed.\n"; }
+
+	return (int)failures;
+}
@@ -0,0 +1,141 @@
+/*========================================================================
+A console program that draws 100000 SqrSprites through both sprite
+paths, SP_POINTS and then SP_INSTANCED, and prints how long a frame took
+on each. Unlike the Render_Tests it needs a window and a GL context, so
+it has to be run on a machine with a driver, llvmpipe is enough.
+
+Each path draws a few frames to settle, then the timed frames. The CPU
+time is from the first sprite submitted to the end of EndFrame, without
+the buffer swap. The GPU time is from the GLRenderBackend's timer
+queries, see GLRenderBackend::SetTimingEnabled.
+
+This is not free to use, and cannot be used without the express permission
+of KillerWave.
+
+Written by Maxwell Miller
+========================================================================*/
+//=====Killer1 includes=====
+#include <Engine/Atom.h>
+#include <Engine/WinProgram.h>
+#include <Engine/Renderer.h>
+#include <Engine/GLRenderBackend.h>
+#include <Engine/ShaderRegistry.h>
+#include <Engine/SqrSprite.h>
+
+//=====STL includes=====
+#include <iostream>
+#include <vector>
+#include <chrono>
+
+using namespace KillerEngine;
+
+//==========================================================================================================================
+//
+//Benchmark Functions
+//
+//==========================================================================================================================
+static const U32 SPRITE_COUNT = 100000;
+
+static const U32 WARM_UP_FRAMES = 30;
+
+static const U32 TIMED_FRAMES = 200;
+
+//=====Small squares spread over the whole window, so every one of them is on screen=====
+static void _MakeSprites(std::vector<SqrSprite>& sprites)
+{
+	F32 width = (F32)WinProgram::GetWidth();
+	F32 height = (F32)WinProgram::GetHeight();
+
+	for(U32 i = 0; i < sprites.size(); ++i)
+	{
+		Vec2 position((F32)WinProgram::GetLeft() + (F32)((i * 7919) % 1000) / 1000.0f * width,
+					  (F32)WinProgram::GetBottom() + (F32)((i * 104729) % 1000) / 1000.0f * height);
+		Col color((F32)(i % 3) / 2.0f, (F32)(i % 5) / 4.0f, (F32)(i % 7) / 6.0f, 1.0f);
+
+		sprites[i].SetPosition(position);
+		sprites[i].SetDimensions(4.0f, 4.0f);
+		sprites[i].SetColor(color);
+	}
+}
+
+static void _DrawFrame(std::vector<SqrSprite>& sprites)
+{
+	Renderer* renderer = Renderer::Instance();
+
+	renderer->BeginFrame();
+
+	for(U32 i = 0; i < sprites.size(); ++i)
+	{
+		sprites[i].v_RenderSprite();
+	}
+
+	renderer->Draw();
+	renderer->EndFrame();
+}
+
+static void _RunPath(SpritePath path, const char* name, GLRenderBackend& backend, std::vector<SqrSprite>& sprites)
+{
+	Renderer* renderer = Renderer::Instance();
+	renderer->SetSpritePath(path);
+
+	//=====Builds the program for this path before anything is timed=====
+	SqrSprite::RequestShaders();
+	ShaderRegistry::Instance()->FinishAll();
+	sprites[0].v_GetShader();
+
+	for(U32 i = 0; i < WARM_UP_FRAMES; ++i)
+	{
+		WinProgram::Instance()->ProcessWndEvents();
+		_DrawFrame(sprites);
+		WinProgram::Instance()->BufferSwap();
+	}
+
+	backend.ResetTiming();
+	F64 cpuTime = 0.0;
+
+	for(U32 i = 0; i < TIMED_FRAMES; ++i)
+	{
+		WinProgram::Instance()->ProcessWndEvents();
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		_DrawFrame(sprites);
+		cpuTime += std::chrono::duration<F64, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		WinProgram::Instance()->BufferSwap();
+	}
+
+	//=====The last queries are read a few frames late, so wait for every one of them=====
+	glFinish();
+	_DrawFrame(sprites);
+
+	RenderFrameStats stats = renderer->GetFrameStats();
+
+	std::cout << name << ": " << SPRITE_COUNT << " sprites in " << stats.batches << " batches, CPU "
+			  << cpuTime / TIMED_FRAMES << " ms, GPU " << backend.GetAverageGPUFrameTime() << " ms a frame over "
+			  << backend.GetTimedFrameCount() << " timed frames\n";
+}
+
+//==========================================================================================================================
+//
+//Main
+//
+//==========================================================================================================================
+int main(void)
+{
+	WinProgram::Instance()->Init(1280, 720, "Sprite Path Benchmark", false);
+
+	GLRenderBackend backend;
+	backend.SetTimingEnabled(true);
+
+	Renderer::Instance()->SetBackend(&backend);
+
+	std::vector<SqrSprite> sprites(SPRITE_COUNT);
+	_MakeSprites(sprites);
+
+	_RunPath(SP_POINTS, "SP_POINTS", backend, sprites);
+	_RunPath(SP_INSTANCED, "SP_INSTANCED", backend, sprites);
+
+	Renderer::Instance()->SetBackend(NULL);
+
+	return 0;
+}